@@ -0,0 +1,138 @@
+#include "background.h"
+#include <stdio.h>
+
+#define BACKGROUND_FILL_SLOTS 4 // Distinct full-screen backgrounds (intro, ranking)
+
+typedef struct {
+    ALLEGRO_BITMAP* source;  // Image the cache was built from
+    int width, height;       // Buffer size it was built for
+    ALLEGRO_BITMAP* bitmap;  // NULL = empty slot
+} BackgroundCache;
+
+static BackgroundCache fill_caches[BACKGROUND_FILL_SLOTS];
+static int next_fill_slot = 0;
+static BackgroundCache parallax_strip; // Current stage only; a stage change rebuilds it
+
+static void cache_release(BackgroundCache* cache) {
+    if (cache->bitmap) al_destroy_bitmap(cache->bitmap);
+    cache->bitmap = NULL;
+    cache->source = NULL;
+}
+
+// New bitmap drawn by draw(image, width, height); the caller's target is kept
+static bool cache_build(BackgroundCache* cache, ALLEGRO_BITMAP* source, int width, int height,
+                        int bitmap_width, int bitmap_height,
+                        void (*draw)(ALLEGRO_BITMAP*, int, int)) {
+    cache_release(cache);
+
+    ALLEGRO_BITMAP* bitmap = al_create_bitmap(bitmap_width, bitmap_height);
+    if (!bitmap) {
+        printf("Warning: background cache %dx%d not created, drawing directly\n", bitmap_width, bitmap_height);
+        return false;
+    }
+
+    ALLEGRO_BITMAP* target = al_get_target_bitmap();
+    al_set_target_bitmap(bitmap);
+    al_clear_to_color(al_map_rgba(0, 0, 0, 0));
+    draw(source, width, height);
+    al_set_target_bitmap(target);
+
+    cache->source = source;
+    cache->width = width;
+    cache->height = height;
+    cache->bitmap = bitmap;
+    return true;
+}
+
+static bool cache_matches(const BackgroundCache* cache, ALLEGRO_BITMAP* source, int width, int height) {
+    return cache->bitmap && cache->source == source && cache->width == width && cache->height == height;
+}
+
+// ===== Fill (still screens) =====
+
+// Scale to fill the whole area (the larger scale wins, the rest is cropped), centred
+static void draw_scaled_fill(ALLEGRO_BITMAP* image, int width, int height) {
+    int bg_width = al_get_bitmap_width(image);
+    int bg_height = al_get_bitmap_height(image);
+
+    float scale_x = (float)width / bg_width;
+    float scale_y = (float)height / bg_height;
+    float scale = (scale_x > scale_y) ? scale_x : scale_y;
+
+    int scaled_width = (int)(bg_width * scale);
+    int scaled_height = (int)(bg_height * scale);
+    int x = (width - scaled_width) / 2;
+    int y = (height - scaled_height) / 2;
+
+    al_draw_scaled_bitmap(image, 0, 0, bg_width, bg_height, x, y, scaled_width, scaled_height, 0);
+}
+
+bool background_draw_fill(ALLEGRO_BITMAP* image, int width, int height) {
+    if (!image) return false;
+
+    BackgroundCache* cache = NULL;
+    for (int i = 0; i < BACKGROUND_FILL_SLOTS; i++) {
+        if (cache_matches(&fill_caches[i], image, width, height)) cache = &fill_caches[i];
+    }
+    if (!cache) {
+        cache = &fill_caches[next_fill_slot];
+        next_fill_slot = (next_fill_slot + 1) % BACKGROUND_FILL_SLOTS;
+        if (!cache_build(cache, image, width, height, width, height, draw_scaled_fill)) {
+            draw_scaled_fill(image, width, height);
+            return true;
+        }
+    }
+
+    al_draw_bitmap(cache->bitmap, 0, 0, 0);
+    return true;
+}
+
+// ===== Parallax (stage background) =====
+
+// One tile row, wide enough that any horizontal offset is a single region of it
+static void draw_tiled_strip(ALLEGRO_BITMAP* image, int width, int height) {
+    (void)height;
+    int tile_width = al_get_bitmap_width(image);
+    for (int x = 0; x < width + tile_width; x += tile_width) {
+        al_draw_bitmap(image, x, 0, 0);
+    }
+}
+
+// a mod b, always in [0, b)
+static int wrap(int a, int b) {
+    int r = a % b;
+    return r < 0 ? r + b : r;
+}
+
+void background_draw_parallax(ALLEGRO_BITMAP* image, double offset_x, double offset_y, int width, int height) {
+    if (!image) return;
+
+    int tile_width = al_get_bitmap_width(image);
+    int tile_height = al_get_bitmap_height(image);
+
+    if (!cache_matches(&parallax_strip, image, width, height) &&
+        !cache_build(&parallax_strip, image, width, height, width + tile_width, tile_height, draw_tiled_strip)) {
+        // No strip: tile directly
+        for (int x = wrap((int)offset_x, tile_width) - tile_width; x < width; x += tile_width) {
+            for (int y = wrap((int)offset_y, tile_height) - tile_height; y < height; y += tile_height) {
+                al_draw_bitmap(image, x, y, 0);
+            }
+        }
+        return;
+    }
+
+    // Buffer column 0 falls this far into a tile; one blit per tile row
+    // (two at most while the image is taller than the buffer)
+    int src_x = wrap(-(int)offset_x, tile_width);
+    int y = wrap((int)offset_y, tile_height);
+    if (y > 0) y -= tile_height;
+    for (; y < height; y += tile_height) {
+        al_draw_bitmap_region(parallax_strip.bitmap, src_x, 0, width, tile_height, 0, y, 0);
+    }
+}
+
+void background_cache_free(void) {
+    for (int i = 0; i < BACKGROUND_FILL_SLOTS; i++) cache_release(&fill_caches[i]);
+    cache_release(&parallax_strip);
+    next_fill_slot = 0;
+}
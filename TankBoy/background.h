@@ -0,0 +1,23 @@
+#ifndef BACKGROUND_H
+#define BACKGROUND_H
+
+#include <stdbool.h>
+#include <allegro5/allegro5.h>
+
+// Background layers, built on first use and reused every frame: still screens
+// get their image pre-scaled to fill the buffer, the stage parallax gets a
+// pre-tiled horizontal strip. The cached bitmaps are made by the thread that
+// draws (the render thread) and rebuilt when the source image or the buffer
+// size changes.
+
+// Draw image scaled to fill width x height (cropped, centred);
+// false if image is NULL so the caller can clear instead
+bool background_draw_fill(ALLEGRO_BITMAP* image, int width, int height);
+
+// Tile image over width x height, shifted by (offset_x, offset_y)
+void background_draw_parallax(ALLEGRO_BITMAP* image, double offset_x, double offset_y, int width, int height);
+
+// Destroy the cached bitmaps (display current on the calling thread)
+void background_cache_free(void);
+
+#endif // BACKGROUND_H
@@ -0,0 +1,592 @@
+// Batch simulator for balancing sweeps: thousands of headless games on every core.
+// Built by build_batch.sh (Linux, pthreads); not part of the Visual Studio project.
+// Run from the repository root, like the game (resource paths are relative to it).
+//
+//   tankboy_batch [--sweep FILE] [--games N] [--stages 1,2,3] [--seed N] [--ticks N]
+//                 [--bot walk|mg|cannon] [--replay FILE]... [--threads N]
+//                 [--out FILE] [--raw FILE] [--verbose]
+//
+// Every game is one job: a tuning variant (a row of the sweep CSV, see
+// resources/batch/sweep_example.csv) played on one stage by a bot with one seed,
+// or played by a recorded replay. A bot game ends on stage clear, tank death or
+// after --ticks; a replay game ends with the replay.
+//
+// Workers pull jobs from a shared counter, each with its own World, so the
+// throughput grows with the core count. Config, tuning and stage files are
+// loaded before the workers start and only read by them. Results are stored per job and
+// aggregated afterwards: the CSV does not depend on --threads.
+// Summary CSV goes to --out (default: stdout), one row per game to --raw.
+// Stage load chatter on stdout is muted unless --verbose; progress goes to stderr.
+
+// standard c library
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <ctype.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+
+// local library
+#include "world.h"
+#include "ini_parser.h"
+#include "enemy.h"
+#include "map_generation.h"
+#include "replay.h"
+#include "bot.h"
+
+#define BATCH_DEFAULT_GAMES 100
+#define BATCH_DEFAULT_TICKS 36000   // 10 minutes of game time per bot game
+#define BATCH_TICK_RATE 60          // Same fixed tick as the game (SIM_TICK_RATE)
+#define BATCH_DT (1.0 / BATCH_TICK_RATE)
+#define BATCH_MAX_VARIANTS 256
+#define BATCH_MAX_INPUTS 32
+#define BATCH_MAX_THREADS 256
+#define BATCH_NAME_LEN 64
+
+// ===== Data Types =====
+
+// One row of the sweep file
+typedef struct {
+    char name[BATCH_NAME_LEN];
+    EnemyTuning tuning;
+} Variant;
+
+// Who plays: a bot on a given stage, or a replay (stage 0)
+typedef struct {
+    BotType bot;
+    const char* replay_path;    // NULL for bot games
+    char name[BATCH_NAME_LEN];
+} InputSource;
+
+typedef struct {
+    int variant;
+    int input;
+    int stage;                  // 0 for replays (the replay picks its stages)
+    uint64_t seed;
+} Job;
+
+typedef struct {
+    bool cleared;               // Stage cleared (replay: any stage cleared)
+    bool died;                  // Tank destroyed
+    double clear_time;          // Seconds of game time to the first clear
+    int damage_taken;           // Tank HP lost over the game
+    double score;
+    long long ticks;
+} GameResult;
+
+typedef struct {
+    const Variant* variants;
+    const InputSource* inputs;
+    const Job* jobs;
+    GameResult* results;
+    int job_count;
+    long long max_ticks;
+    int max_bullets;
+    int view_width, view_height;
+    atomic_int next_job;
+    atomic_int done_jobs;
+    atomic_int failed_jobs;
+    atomic_int live_workers;
+} Batch;
+
+// Per-game event tally (the world's presentation hook, set per job)
+typedef struct {
+    int last_hp;
+    int damage_taken;
+} GameTally;
+
+// ===== Helpers =====
+
+// Wall time: the batch is judged on throughput across all cores, not CPU time
+static double wall_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static const char* base_name(const char* path) {
+    const char* slash = strrchr(path, '/');
+    return slash ? slash + 1 : path;
+}
+
+static char* trim(char* s) {
+    while (isspace((unsigned char)*s)) s++;
+    char* end = s + strlen(s);
+    while (end > s && isspace((unsigned char)end[-1])) *--end = '\0';
+    return s;
+}
+
+// Splits a CSV line in place; returns the field count
+static int split_csv(char* line, char** fields, int max_fields) {
+    int count = 0;
+    char* p = line;
+    while (count < max_fields) {
+        char* comma = strchr(p, ',');
+        if (comma) *comma = '\0';
+        fields[count++] = trim(p);
+        if (!comma) break;
+        p = comma + 1;
+    }
+    return count;
+}
+
+// ===== Sweep File =====
+
+// Writes one sweep column into a tuning; false for an unknown column
+static bool apply_tuning_field(EnemyTuning* tuning, const char* column, const char* value) {
+    EnemyArchetype* tank = &tuning->archetypes[ENEMY_TYPE_TANK];
+    EnemyArchetype* heli = &tuning->archetypes[ENEMY_TYPE_HELICOPTER];
+
+    if (strcmp(column, "enemy_base_speed") == 0) tank->base_speed = atof(value);
+    else if (strcmp(column, "enemy_speed_per_difficulty") == 0) tank->speed_per_difficulty = atof(value);
+    else if (strcmp(column, "enemy_base_hp") == 0) tank->base_hp = atoi(value);
+    else if (strcmp(column, "enemy_hp_per_difficulty") == 0) tank->hp_per_difficulty = atoi(value);
+    else if (strcmp(column, "flying_base_hp") == 0) heli->base_hp = atoi(value);
+    else if (strcmp(column, "flying_hp_per_difficulty") == 0) heli->hp_per_difficulty = atoi(value);
+    else if (strcmp(column, "flying_burst_count") == 0) heli->burst_count = atoi(value);
+    else if (strcmp(column, "flying_shot_interval") == 0) heli->shot_interval = atof(value);
+    else if (strcmp(column, "flying_rest_time") == 0) heli->rest_time = atof(value);
+    else if (strcmp(column, "splash_radius") == 0) tuning->splash_radius = atof(value);
+    else return false;
+    return true;
+}
+
+// Header row names the columns ("name" first); empty cells keep the config.ini value
+static int load_sweep(const char* path, Variant* variants, int max_variants) {
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        fprintf(stderr, "Error: cannot open sweep file %s\n", path);
+        return -1;
+    }
+
+    char line[1024];
+    char header_line[1024];
+    char* columns[32];
+    int column_count = 0;
+    int count = 0;
+
+    while (fgets(line, sizeof(line), file)) {
+        char* text = trim(line);
+        if (text[0] == '\0' || text[0] == '#') continue;
+
+        if (column_count == 0) {
+            strncpy(header_line, text, sizeof(header_line) - 1);
+            header_line[sizeof(header_line) - 1] = '\0';
+            column_count = split_csv(header_line, columns, 32);
+            for (int c = 1; c < column_count; c++) {
+                EnemyTuning probe = *enemy_default_tuning();
+                if (!apply_tuning_field(&probe, columns[c], "0"))
+                    fprintf(stderr, "Warning: unknown sweep column '%s' ignored\n", columns[c]);
+            }
+            continue;
+        }
+        if (count >= max_variants) {
+            fprintf(stderr, "Warning: more than %d variants in %s, rest ignored\n", max_variants, path);
+            break;
+        }
+
+        char* fields[32];
+        int field_count = split_csv(text, fields, 32);
+        Variant* v = &variants[count];
+        v->tuning = *enemy_default_tuning();
+        snprintf(v->name, sizeof(v->name), "%s", field_count > 0 && fields[0][0] ? fields[0] : "variant");
+        for (int c = 1; c < field_count && c < column_count; c++) {
+            if (fields[c][0] != '\0') apply_tuning_field(&v->tuning, columns[c], fields[c]);
+        }
+        enemy_tuning_build(&v->tuning);
+        count++;
+    }
+
+    fclose(file);
+    if (count == 0) fprintf(stderr, "Error: no variants in %s\n", path);
+    return count;
+}
+
+// ===== Games =====
+
+static void tally_event(const GameEvent* event, void* user) {
+    GameTally* tally = (GameTally*)user;
+    if (event->type == GAME_EVENT_TANK_DAMAGED) {
+        if (event->value < tally->last_hp) tally->damage_taken += tally->last_hp - event->value;
+        tally->last_hp = event->value;
+    }
+}
+
+static void apply_command(World* world, ReplayCommand command) {
+    if (command == REPLAY_CMD_NEW_GAME) world_new_game(world);
+    else if (command == REPLAY_CMD_NEXT_STAGE) world_load_stage(world, world->stage + 1);
+}
+
+// Bot game: one stage from a fresh game, until clear, death or the tick limit
+static void play_bot_game(World* world, BotType bot, int stage, long long max_ticks, GameTally* tally, GameResult* result) {
+    InputState input;
+
+    world_new_game(world);
+    if (stage > 1) world_load_stage(world, stage);
+    tally->last_hp = world->tank.hp;
+
+    long long t = 0;
+    while (t < max_ticks && !world->stage_cleared && !world->tank_destroyed) {
+        bot_input(bot, t, world, &input, &world->tank.cannon_angle);
+        world_step(world, &input, BATCH_DT);
+        t++;
+    }
+
+    result->cleared = world->stage_cleared;
+    result->died = world->tank_destroyed;
+    result->clear_time = world->stage_cleared ? t * BATCH_DT : 0.0;
+    result->ticks = t;
+}
+
+// Replay game: the recorded input decides every tick and command
+static bool play_replay_game(World* world, const char* path, GameTally* tally, GameResult* result) {
+    ReplayPlayer player;
+    if (!replay_player_open(&player, path)) return false;
+
+    rng_seed(&world->rng, player.seed);
+    tally->last_hp = world->tank.hp;
+
+    InputState input;
+    ReplayCommand command;
+    long long t = 0;
+    bool ended = false;
+    while (!ended) {
+        while (replay_player_next_command(&player, &command)) {
+            if (command == REPLAY_CMD_END) { ended = true; break; }
+            apply_command(world, command);
+            if (command == REPLAY_CMD_NEW_GAME || command == REPLAY_CMD_NEXT_STAGE) tally->last_hp = world->tank.hp;
+        }
+        if (ended || !replay_player_read_tick(&player, &input, &world->tank.cannon_angle)) break;
+
+        world_step(world, &input, BATCH_DT);
+        t++;
+
+        if (world->stage_cleared && !result->cleared) {
+            result->cleared = true;
+            result->clear_time = t * BATCH_DT;
+        }
+        if (world->tank_destroyed) result->died = true;
+    }
+
+    replay_player_close(&player);
+    result->ticks = t;
+    return true;
+}
+
+static void* batch_worker(void* arg) {
+    Batch* batch = (Batch*)arg;
+
+    World* world = malloc(sizeof(World));
+    if (!world || !world_init(world, batch->max_bullets, batch->view_width, batch->view_height, 1)) {
+        fprintf(stderr, "Error: world init failed\n");
+        free(world);
+        atomic_fetch_sub(&batch->live_workers, 1);
+        return NULL;
+    }
+
+    GameTally tally;
+    game_events_set_handler(world, tally_event, &tally);
+
+    for (;;) {
+        int j = atomic_fetch_add(&batch->next_job, 1);
+        if (j >= batch->job_count) break;
+
+        const Job* job = &batch->jobs[j];
+        const InputSource* source = &batch->inputs[job->input];
+        GameResult* result = &batch->results[j];
+        memset(result, 0, sizeof(*result));
+        memset(&tally, 0, sizeof(tally));
+
+        world->tuning = &batch->variants[job->variant].tuning;
+        rng_seed(&world->rng, job->seed);
+        world->tick = 0;
+
+        if (source->replay_path) {
+            if (!play_replay_game(world, source->replay_path, &tally, result))
+                atomic_fetch_add(&batch->failed_jobs, 1);
+        }
+        else {
+            play_bot_game(world, source->bot, job->stage, batch->max_ticks, &tally, result);
+        }
+        result->damage_taken = tally.damage_taken;
+        result->score = world->score;
+
+        atomic_fetch_add(&batch->done_jobs, 1);
+    }
+
+    world_free(world);
+    free(world);
+    atomic_fetch_sub(&batch->live_workers, 1);
+    return NULL;
+}
+
+// ===== Reports =====
+
+static void write_summary(FILE* out, const Batch* batch, int variant_count, int input_count, const int* stages, int stage_count) {
+    fprintf(out, "variant,input,stage,games,clear_rate,mean_clear_time_s,death_rate,mean_damage_taken,mean_score,mean_ticks\n");
+
+    for (int v = 0; v < variant_count; v++) {
+        for (int in = 0; in < input_count; in++) {
+            for (int s = 0; s < stage_count; s++) {
+                int games = 0, clears = 0, deaths = 0;
+                double clear_time = 0.0, damage = 0.0, score = 0.0, ticks = 0.0;
+
+                for (int j = 0; j < batch->job_count; j++) {
+                    const Job* job = &batch->jobs[j];
+                    if (job->variant != v || job->input != in || job->stage != stages[s]) continue;
+                    const GameResult* r = &batch->results[j];
+                    games++;
+                    if (r->cleared) { clears++; clear_time += r->clear_time; }
+                    if (r->died) deaths++;
+                    damage += r->damage_taken;
+                    score += r->score;
+                    ticks += (double)r->ticks;
+                }
+                if (games == 0) continue;
+
+                fprintf(out, "%s,%s,%d,%d,%.3f,%.2f,%.3f,%.1f,%.1f,%.0f\n",
+                    batch->variants[v].name, batch->inputs[in].name, stages[s], games,
+                    (double)clears / games, clears ? clear_time / clears : 0.0,
+                    (double)deaths / games, damage / games, score / games, ticks / games);
+            }
+        }
+    }
+}
+
+static void write_raw(FILE* out, const Batch* batch) {
+    fprintf(out, "variant,input,stage,seed,cleared,died,clear_time_s,damage_taken,score,ticks\n");
+    for (int j = 0; j < batch->job_count; j++) {
+        const Job* job = &batch->jobs[j];
+        const GameResult* r = &batch->results[j];
+        fprintf(out, "%s,%s,%d,%llu,%d,%d,%.2f,%d,%.0f,%lld\n",
+            batch->variants[job->variant].name, batch->inputs[job->input].name, job->stage,
+            (unsigned long long)job->seed, r->cleared, r->died, r->clear_time,
+            r->damage_taken, r->score, r->ticks);
+    }
+}
+
+// ===== Main =====
+
+static void print_usage(const char* program) {
+    fprintf(stderr,
+        "usage: %s [--sweep FILE] [--games N] [--stages 1,2,3] [--seed N] [--ticks N]\n"
+        "          [--bot walk|mg|cannon] [--replay FILE]... [--threads N]\n"
+        "          [--out FILE] [--raw FILE] [--verbose]\n", program);
+}
+
+int main(int argc, char** argv) {
+    const char* sweep_file = NULL;
+    const char* out_file = NULL;
+    const char* raw_file = NULL;
+    const char* replay_files[BATCH_MAX_INPUTS];
+    int replay_count = 0;
+    int games = BATCH_DEFAULT_GAMES;
+    long long max_ticks = BATCH_DEFAULT_TICKS;
+    unsigned long long base_seed = 1;
+    BotType bot = BOT_WALK;
+    int threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    int stages[3] = { 1, 2, 3 };
+    int stage_count = 3;
+    bool verbose = false;
+
+    // Command line: see the top of this file
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--sweep") == 0 && i + 1 < argc) sweep_file = argv[++i];
+        else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) out_file = argv[++i];
+        else if (strcmp(argv[i], "--raw") == 0 && i + 1 < argc) raw_file = argv[++i];
+        else if (strcmp(argv[i], "--games") == 0 && i + 1 < argc) games = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--ticks") == 0 && i + 1 < argc) max_ticks = atoll(argv[++i]);
+        else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) base_seed = strtoull(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--bot") == 0 && i + 1 < argc) bot = bot_type_from_string(argv[++i]);
+        else if (strcmp(argv[i], "--verbose") == 0) verbose = true;
+        else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc && replay_count < BATCH_MAX_INPUTS) replay_files[replay_count++] = argv[++i];
+        else if (strcmp(argv[i], "--stages") == 0 && i + 1 < argc) {
+            char list[64];
+            char* fields[3];
+            snprintf(list, sizeof(list), "%s", argv[++i]);
+            int n = split_csv(list, fields, 3);
+            stage_count = 0;
+            for (int s = 0; s < n; s++) {
+                int stage = atoi(fields[s]);
+                if (stage >= 1 && stage <= 3) stages[stage_count++] = stage;
+            }
+            if (stage_count == 0) { print_usage(argv[0]); return 1; }
+        }
+        else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+    if (games < 1) games = 1;
+    if (max_ticks < 1) max_ticks = 1;
+    if (threads < 1) threads = 1;
+    if (threads > BATCH_MAX_THREADS) threads = BATCH_MAX_THREADS;
+    if (bot == BOT_TOUR) {
+        fprintf(stderr, "Warning: the tour bot changes stages, using the walk bot\n");
+        bot = BOT_WALK;
+    }
+
+    // Results stay on the real stdout; the simulation's load messages do not
+    FILE* report = stdout;
+    if (!verbose) {
+        report = fdopen(dup(fileno(stdout)), "w");
+        if (!report || !freopen("/dev/null", "w", stdout)) report = stdout;
+    }
+
+    // Same config values the game uses for the bullet pool and the update ROI
+    IniParser* parser = ini_parser_create();
+    if (!parser) { fprintf(stderr, "Error: INI parser create failed\n"); return 1; }
+    if (!ini_parser_load_file(parser, "TankBoy/config.ini"))
+        fprintf(stderr, "Warning: TankBoy/config.ini not loaded. Using defaults.\n");
+    int view_width = ini_parser_get_int(parser, "Buffer", "buffer_width", 320);
+    int view_height = ini_parser_get_int(parser, "Buffer", "buffer_height", 240);
+    int max_bullets = ini_parser_get_int(parser, "Game", "max_bullets", 100);
+    ini_parser_destroy(parser);
+
+    // Shared read-only tuning and stage files: loaded once, before any worker starts
+    map_config_init();
+    enemy_archetypes_init();
+    world_preload_stages(3);  // Every stage the game has; workers copy them on stage load
+
+    static Variant variants[BATCH_MAX_VARIANTS];
+    int variant_count = 1;
+    if (sweep_file) {
+        variant_count = load_sweep(sweep_file, variants, BATCH_MAX_VARIANTS);
+        if (variant_count <= 0) return 1;
+    }
+    else {
+        snprintf(variants[0].name, sizeof(variants[0].name), "default");
+        variants[0].tuning = *enemy_default_tuning();
+    }
+
+    // Inputs: the replays if any were given, else the bot on every listed stage
+    static InputSource inputs[BATCH_MAX_INPUTS];
+    int input_count = 0;
+    if (replay_count > 0) {
+        for (int r = 0; r < replay_count; r++) {
+            inputs[r].replay_path = replay_files[r];
+            snprintf(inputs[r].name, sizeof(inputs[r].name), "%s", base_name(replay_files[r]));
+        }
+        input_count = replay_count;
+        stages[0] = 0;
+        stage_count = 1;
+        games = 1;  // A replay carries its own seed
+    }
+    else {
+        inputs[0].bot = bot;
+        snprintf(inputs[0].name, sizeof(inputs[0].name), "%s", bot_type_name(bot));
+        input_count = 1;
+    }
+
+    Batch batch;
+    memset(&batch, 0, sizeof(batch));
+    batch.job_count = variant_count * input_count * stage_count * games;
+    Job* jobs = malloc(sizeof(Job) * batch.job_count);
+    batch.results = calloc(batch.job_count, sizeof(GameResult));
+    if (!jobs || !batch.results) {
+        fprintf(stderr, "Error: out of memory for %d jobs\n", batch.job_count);
+        return 1;
+    }
+
+    // Seed k is shared by every variant, so variants are compared on the same games
+    int j = 0;
+    for (int v = 0; v < variant_count; v++)
+        for (int in = 0; in < input_count; in++)
+            for (int s = 0; s < stage_count; s++)
+                for (int g = 0; g < games; g++) {
+                    jobs[j].variant = v;
+                    jobs[j].input = in;
+                    jobs[j].stage = stages[s];
+                    jobs[j].seed = base_seed + (uint64_t)g;
+                    j++;
+                }
+
+    batch.variants = variants;
+    batch.inputs = inputs;
+    batch.jobs = jobs;
+    batch.max_ticks = max_ticks;
+    batch.max_bullets = max_bullets;
+    batch.view_width = view_width;
+    batch.view_height = view_height;
+    atomic_init(&batch.next_job, 0);
+    atomic_init(&batch.done_jobs, 0);
+    atomic_init(&batch.failed_jobs, 0);
+    atomic_init(&batch.live_workers, 0);
+
+    if (threads > batch.job_count) threads = batch.job_count;
+    fprintf(stderr, "Running %d games (%d variants x %d inputs x %d stages x %d seeds) on %d threads\n",
+        batch.job_count, variant_count, input_count, stage_count, games, threads);
+
+    double start = wall_seconds();
+    pthread_t workers[BATCH_MAX_THREADS];
+    int started = 0;
+    for (int t = 0; t < threads; t++) {
+        atomic_fetch_add(&batch.live_workers, 1);
+        if (pthread_create(&workers[t], NULL, batch_worker, &batch) != 0) {
+            atomic_fetch_sub(&batch.live_workers, 1);
+            fprintf(stderr, "Warning: only %d worker threads started\n", started);
+            break;
+        }
+        started++;
+    }
+    if (started == 0) {
+        atomic_fetch_add(&batch.live_workers, 1);
+        batch_worker(&batch);
+    }
+
+    // Progress while the workers run (every 10% of the games)
+    int shown = -1;
+    while (atomic_load(&batch.live_workers) > 0) {
+        struct timespec pause = { 0, 100000000 };
+        nanosleep(&pause, NULL);
+        int done = atomic_load(&batch.done_jobs);
+        if (done * 10 / batch.job_count != shown) {
+            shown = done * 10 / batch.job_count;
+            fprintf(stderr, "  %d / %d games\n", done, batch.job_count);
+        }
+    }
+    for (int t = 0; t < started; t++) pthread_join(workers[t], NULL);
+    if (atomic_load(&batch.done_jobs) < batch.job_count) {
+        fprintf(stderr, "Error: only %d of %d games ran\n", atomic_load(&batch.done_jobs), batch.job_count);
+        return 1;
+    }
+    double elapsed = wall_seconds() - start;
+
+    long long total_ticks = 0;
+    for (int k = 0; k < batch.job_count; k++) total_ticks += batch.results[k].ticks;
+    fprintf(stderr, "%d games, %lld ticks in %.2f s: %.1f games/s, %.0f ticks/s on %d threads\n",
+        batch.job_count, total_ticks, elapsed,
+        elapsed > 0.0 ? batch.job_count / elapsed : 0.0,
+        elapsed > 0.0 ? total_ticks / elapsed : 0.0, started > 0 ? started : 1);
+    if (atomic_load(&batch.failed_jobs) > 0)
+        fprintf(stderr, "Warning: %d replay games could not be opened\n", atomic_load(&batch.failed_jobs));
+
+    FILE* out = report;
+    if (out_file) {
+        out = fopen(out_file, "w");
+        if (!out) { fprintf(stderr, "Error: cannot write %s\n", out_file); return 1; }
+    }
+    write_summary(out, &batch, variant_count, input_count, stages, stage_count);
+    if (out != report) fclose(out);
+    fflush(report);
+
+    if (raw_file) {
+        FILE* raw = fopen(raw_file, "w");
+        if (raw) {
+            write_raw(raw, &batch);
+            fclose(raw);
+        }
+        else {
+            fprintf(stderr, "Error: cannot write %s\n", raw_file);
+        }
+    }
+
+    free(jobs);
+    free(batch.results);
+    world_free_preloaded_stages();
+    map_config_cleanup();
+    return 0;
+}
@@ -0,0 +1,41 @@
+#include "bot.h"
+#include <math.h>
+#include <string.h>
+
+static const char* const bot_names[BOT_TYPE_COUNT] = { "walk", "mg", "cannon", "tour" };
+
+BotType bot_type_from_string(const char* name) {
+    for (int b = 0; b < BOT_TYPE_COUNT; b++) {
+        if (strcmp(name, bot_names[b]) == 0) return (BotType)b;
+    }
+    return BOT_WALK;
+}
+
+const char* bot_type_name(BotType bot) {
+    if (bot < 0 || bot >= BOT_TYPE_COUNT) return bot_names[BOT_WALK];
+    return bot_names[bot];
+}
+
+void bot_input(BotType bot, long long t, const World* world, InputState* input, double* aim) {
+    memset(input, 0, sizeof(*input));
+    input->right = true;
+    input->jump = (t % 90) == 0;
+
+    switch (bot) {
+    case BOT_MG:
+        input->change_weapon = world->tank.weapon != 0 && (t % 2) == 0;
+        input->fire = true;
+        *aim = -0.2 + 0.35 * sin((double)t * 0.08);
+        break;
+    case BOT_CANNON:
+        input->change_weapon = world->tank.weapon != 1 && (t % 2) == 0;
+        input->fire = (t % 45) < 35;
+        *aim = -0.35 + 0.15 * sin((double)t * 0.03);
+        break;
+    default:
+        input->fire = (t % 60) < 40;
+        input->change_weapon = (t % 600) == 599;
+        *aim = -0.15 + 0.3 * sin((double)t * 0.05);
+        break;
+    }
+}
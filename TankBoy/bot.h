@@ -0,0 +1,33 @@
+#ifndef BOT_H
+#define BOT_H
+
+#include "input_state.h"
+#include "world.h"
+
+// Scripted players for the headless runner and batch sweeps.
+// Input depends only on the tick count and the tank's current weapon, so the
+// same seed and bot always play the same game.
+
+// ===== Constants =====
+#define BOT_TOUR_STAGE_TICKS 1200   // Tour bot presses Next every 20 s of game time
+
+// ===== Data Types =====
+
+typedef enum {
+    BOT_WALK,   // Drive right, hop, fire in bursts, swap weapons now and then
+    BOT_MG,     // Machine gun held down with a sweeping aim
+    BOT_CANNON, // Cannon only, aimed low into the crowd (splash chains)
+    BOT_TOUR,   // Walk bot that moves on to the next stage on a timer
+    BOT_TYPE_COUNT
+} BotType;
+
+// ===== Function Declarations =====
+
+// "walk", "mg", "cannon", "tour"; anything else is the walk bot
+BotType bot_type_from_string(const char* name);
+const char* bot_type_name(BotType bot);
+
+// Input for tick t; writes the aim angle to *aim
+void bot_input(BotType bot, long long t, const World* world, InputState* input, double* aim);
+
+#endif // BOT_H
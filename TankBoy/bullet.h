@@ -2,15 +2,17 @@
 #define BULLET_H
 
 #include <stdbool.h>
-#include <allegro5/allegro_primitives.h>
 #include "map_generation.h"
 
+struct World;  // world.h
+
 #define MAX_BULLETS 100
 
 
 
 typedef struct {
     double x, y;
+    double prev_x, prev_y;   // Position at the start of the last tick (render interpolation)
     double vx, vy;
     bool alive;
     int weapon; // 0=MG, 1=Cannon
@@ -23,24 +25,9 @@ typedef struct {
     double angle;
 } Bullet;
 
-typedef struct _bullet_sprites {
-    ALLEGRO_BITMAP* mg_bullet_sheet;
-    ALLEGRO_BITMAP* cannon_bullet_sheet;
-    ALLEGRO_BITMAP* enemy_bullet_sheet;
-} bullet_sprites_t;
 
 void bullets_init(Bullet* bullets, int max_bullets);
-void bullets_update(Bullet* bullets, int max_bullets, const Map* map);
-void bullets_draw(Bullet* bullets, int max_bullets, double camera_x, double camera_y);
-
-// Getter functions for external access
-Bullet* get_bullets(void);
-int get_max_bullets(void);
-
-// Global reference setter
-void set_global_bullet_ref(Bullet* bullets, int max_bullets);
-
-// sprite
-void bullet_sprites_init();
+void bullets_update(const struct World* world, Bullet* bullets, int max_bullets, const Map* map, double gravity);
+void bullets_store_previous(Bullet* bullets, int max_bullets);
 
 #endif
@@ -0,0 +1,100 @@
+#include "bullet_render.h"
+#include <math.h>
+#include <stdio.h>
+#include <allegro5/allegro_primitives.h>
+
+
+bullet_sprites_t bullet_sprites;
+
+void bullets_draw(const Bullet* bullets, int max_bullets, double camera_x, double camera_y, double alpha) {
+    for (int i = 0; i < max_bullets; i++) {
+        if (!bullets[i].alive) continue;
+        double sx = bullets[i].prev_x + (bullets[i].x - bullets[i].prev_x) * alpha - camera_x;
+        double sy = bullets[i].prev_y + (bullets[i].y - bullets[i].prev_y) * alpha - camera_y;
+        
+        // Different colors for player vs enemy bullets
+        ALLEGRO_COLOR col;
+        if (bullets[i].from_enemy) {
+            // Enemy bullets: red color
+            col = (bullets[i].weapon == 0) ? al_map_rgb(255, 0, 0) : al_map_rgb(200, 0, 0);
+        } else {
+            // Player bullets: original colors
+            col = (bullets[i].weapon == 0) ? al_map_rgb(255, 0, 0) : al_map_rgb(255, 128, 0);
+        }
+        
+        // Rotate rectangle around center point (sx, sy)
+        double half_w = bullets[i].width / 2.0;
+        double half_h = bullets[i].height / 2.0;
+        double cos_a = cos(bullets[i].angle);
+        double sin_a = sin(bullets[i].angle);
+        
+        // Calculate four corners of rectangle (rotated around sx, sy)
+        float x1 = sx + (-half_w * cos_a - (-half_h) * sin_a);
+        float y1 = sy + (-half_w * sin_a + (-half_h) * cos_a);
+        
+        float x2 = sx + (half_w * cos_a - (-half_h) * sin_a);
+        float y2 = sy + (half_w * sin_a + (-half_h) * cos_a);
+        
+        float x3 = sx + (half_w * cos_a - half_h * sin_a);
+        float y3 = sy + (half_w * sin_a + half_h * cos_a);
+        
+        float x4 = sx + (-half_w * cos_a - half_h * sin_a);
+        float y4 = sy + (-half_w * sin_a + half_h * cos_a);
+        
+        // Draw rotated rectangle using two triangles
+        // al_draw_filled_triangle(x1, y1, x2, y2, x3, y3, col);
+        // al_draw_filled_triangle(x1, y1, x3, y3, x4, y4, col);
+
+        
+        if (bullets[i].weapon != 0) {
+            int bullet_sprite_width = al_get_bitmap_width(bullet_sprites.cannon_bullet_sheet);
+            int bullet_sprite_height = al_get_bitmap_height(bullet_sprites.cannon_bullet_sheet);
+
+            double rotation_angle_rad = bullets[i].angle;
+            double scale_x = (double)(bullets[i].width) / (double)(bullet_sprite_width);
+            double scale_y = (double)(bullets[i].height) / (double)(bullet_sprite_height);
+
+            al_draw_scaled_rotated_bitmap(bullet_sprites.cannon_bullet_sheet,
+                                            bullet_sprite_width / 2.0, bullet_sprite_height / 2.0,  // rotation center
+                                            sx, sy,                                                 // position to draw in display
+                                            scale_x, scale_y,                                       // scale
+                                            rotation_angle_rad,                                     // rotation angle
+                                            0);
+            continue;
+        }
+
+
+        int bullet_sprite_width = al_get_bitmap_width(bullet_sprites.mg_bullet_sheet);
+        int bullet_sprite_height = al_get_bitmap_height(bullet_sprites.mg_bullet_sheet);
+        
+        // double rotation_angle_rad = bullets[i].angle * ALLEGRO_PI / 180.0;
+        double rotation_angle_rad = bullets[i].angle;
+        double scale_x = (double)(bullets[i].width) / (double)(bullet_sprite_width);
+        double scale_y = (double)(bullets[i].height) / (double)(bullet_sprite_height);
+        
+        if (bullets[i].from_enemy) {
+            al_draw_scaled_rotated_bitmap(bullet_sprites.enemy_bullet_sheet,
+                                            bullet_sprite_width / 2.0, bullet_sprite_height / 2.0,  // rotation center
+                                            sx, sy,                                                 // position to draw in display
+                                            scale_x, scale_y,                                       // scale
+                                            rotation_angle_rad,                                     // rotation angle
+                                            0);
+        } else {
+            al_draw_scaled_rotated_bitmap(bullet_sprites.mg_bullet_sheet,
+                                            bullet_sprite_width / 2.0, bullet_sprite_height / 2.0,  // rotation center
+                                            sx, sy,                                                 // position to draw in display
+                                            scale_x, scale_y,                                       // scale
+                                            rotation_angle_rad,                                     // rotation angle
+                                            0);
+        }
+    }
+}
+
+void bullet_sprites_init() {
+    bullet_sprites.mg_bullet_sheet = al_load_bitmap("TankBoy/resources/sprites/tank_bullet.png");
+    bullet_sprites.cannon_bullet_sheet = al_load_bitmap("TankBoy/resources/sprites/cannon_bullet.png");
+    bullet_sprites.enemy_bullet_sheet = al_load_bitmap("TankBoy/resources/sprites/enemy_bullet.png");
+    if (bullet_sprites.mg_bullet_sheet == NULL || bullet_sprites.cannon_bullet_sheet == NULL || bullet_sprites.enemy_bullet_sheet == NULL) {
+        printf("wrong location of bullet sprite!!\n");
+    }
+}
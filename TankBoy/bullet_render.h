@@ -0,0 +1,19 @@
+#ifndef BULLET_RENDER_H
+#define BULLET_RENDER_H
+
+#include <allegro5/allegro5.h>
+#include "bullet.h"
+
+typedef struct _bullet_sprites {
+    ALLEGRO_BITMAP* mg_bullet_sheet;
+    ALLEGRO_BITMAP* cannon_bullet_sheet;
+    ALLEGRO_BITMAP* enemy_bullet_sheet;
+} bullet_sprites_t;
+
+// Bullet rendering (kept apart from bullet.c so the simulation builds without Allegro)
+void bullets_draw(const Bullet* bullets, int max_bullets, double camera_x, double camera_y, double alpha);
+
+// sprite
+void bullet_sprites_init();
+
+#endif // BULLET_RENDER_H
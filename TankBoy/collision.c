@@ -1,8 +1,6 @@
 #include "collision.h"
-#include "enemy.h"
-#include "tank.h"
-#include "bullet.h"
-#include "head_up_display.h"
+#include "world.h"
+#include "game_events.h"
 #include <math.h>
 
 // ===== Collision Detection Utilities =====
@@ -19,9 +17,10 @@ bool rect_rect_overlap(double x1, double y1, double w1, double h1,
 
 // ===== Bullet Collision Detection =====
 
-void bullets_hit_enemies(void) {
-    Bullet* bullets = get_bullets();
-    int max_bullets = get_max_bullets();
+void bullets_hit_enemies(World* world) {
+    Bullet* bullets = world->bullets;
+    int max_bullets = world->max_bullets;
+    double splash_radius = world->tuning->splash_radius;
     
     for (int b = 0; b < max_bullets; b++) {
         if (!bullets[b].alive) continue;
@@ -35,19 +34,20 @@ void bullets_hit_enemies(void) {
         bool hit = false;
 
         // ground enemies
-        Enemy* enemies = get_enemies();
+        Enemy* enemies = world->enemies;
         for (int i = 0; i < MAX_ENEMIES; i++) {
             Enemy* e = &enemies[i];
             if (!e->alive) continue;
             // Use rectangle-to-rectangle collision instead of point-to-rectangle
             if (rect_rect_overlap(bx - bw/2, by - bh/2, bw, bh, e->x, e->y, e->width, e->height)) {
                 if (bullets[b].weapon == 1) {
-                    // Cannon explosion
-                    apply_cannon_explosion(bx, by, CANNON_SPLASH_RADIUS);
+                    // Cannon explosion, splashed right away so later bullets
+                    // this tick no longer see the enemies it killed
+                    apply_cannon_explosion(world, bx, by, splash_radius);
                 }
                 else {
                     // MG damage
-                    damage_enemy(e, DMG_MG);
+                    damage_enemy(world, e, DMG_MG);
                 }
                 bullets[b].alive = false;
                 hit = true;
@@ -58,19 +58,20 @@ void bullets_hit_enemies(void) {
         if (hit) continue;
 
         // flying enemies
-        FlyingEnemy* f_enemies = get_flying_enemies();
+        FlyingEnemy* f_enemies = world->flying_enemies;
         for (int i = 0; i < MAX_FLY_ENEMIES; i++) {
             FlyingEnemy* fe = &f_enemies[i];
             if (!fe->alive) continue;
             // Use rectangle-to-rectangle collision instead of point-to-rectangle
             if (rect_rect_overlap(bx - bw/2, by - bh/2, bw, bh, fe->x, fe->y, fe->width, fe->height)) {
                 if (bullets[b].weapon == 1) {
-                    // Cannon explosion
-                    apply_cannon_explosion(bx, by, CANNON_SPLASH_RADIUS);
+                    // Cannon explosion, splashed right away so later bullets
+                    // this tick no longer see the enemies it killed
+                    apply_cannon_explosion(world, bx, by, splash_radius);
                 }
                 else {
                     // MG damage
-                    damage_flying_enemy(fe, DMG_MG);
+                    damage_flying_enemy(world, fe, DMG_MG);
                 }
                 bullets[b].alive = false;
                 if (fe->hp <= 0) fe->alive = false;
@@ -80,25 +81,21 @@ void bullets_hit_enemies(void) {
     }
 }
 
-void bullets_hit_tank(void) {
-    if (get_tank_hp() <= 0) return;
+void bullets_hit_tank(World* world) {
+    const Tank* tank = &world->tank;
+    if (tank->hp <= 0) return;
     
-    Bullet* bullets = get_bullets();
-    int max_bullets = get_max_bullets();
+    Bullet* bullets = world->bullets;
+    int max_bullets = world->max_bullets;
     
     for (int b = 0; b < max_bullets; b++) {
         if (!bullets[b].alive) continue;
         if (!bullets[b].from_enemy) continue;
 
-        double tank_x = get_tank_x();
-        double tank_y = get_tank_y();
-        int tank_w = get_tank_width();
-        int tank_h = get_tank_height();
-
-        if (point_in_rect(bullets[b].x, bullets[b].y, tank_x, tank_y, tank_w, tank_h)) {
+        if (point_in_rect(bullets[b].x, bullets[b].y, tank->x, tank->y, tank->width, tank->height)) {
             bullets[b].alive = false;
-            if (get_tank_invincible() <= 0.0) {
-                apply_damage_to_tank(DMG_MG);
+            if (tank->invincible <= 0.0) {
+                apply_damage_to_tank(world, DMG_MG);
             }
         }
     }
@@ -106,15 +103,16 @@ void bullets_hit_tank(void) {
 
 // ===== Tank-Enemy Collision Detection =====
 
-void tank_touch_ground_enemy(void) {
-    if (get_tank_hp() <= 0) return;
+void tank_touch_ground_enemy(World* world) {
+    const Tank* tank = &world->tank;
+    if (tank->hp <= 0) return;
     
-    double tank_x = get_tank_x();
-    double tank_y = get_tank_y();
-    int tank_w = get_tank_width();
-    int tank_h = get_tank_height();
+    double tank_x = tank->x;
+    double tank_y = tank->y;
+    int tank_w = tank->width;
+    int tank_h = tank->height;
     
-    Enemy* enemies = get_enemies();
+    Enemy* enemies = world->enemies;
     
     for (int i = 0; i < MAX_ENEMIES; i++) {
         Enemy* e = &enemies[i];
@@ -124,20 +122,21 @@ void tank_touch_ground_enemy(void) {
                                        e->x, e->y, e->width, e->height);
 
         if (overlap) {
-            handle_tank_enemy_collision(i);
+            handle_tank_enemy_collision(world, i);
         }
     }
 }
 
-void tank_touch_flying_enemy(void) {
-    if (get_tank_hp() <= 0) return;
+void tank_touch_flying_enemy(World* world) {
+    const Tank* tank = &world->tank;
+    if (tank->hp <= 0) return;
     
-    double tank_x = get_tank_x();
-    double tank_y = get_tank_y();
-    int tank_w = get_tank_width();
-    int tank_h = get_tank_height();
+    double tank_x = tank->x;
+    double tank_y = tank->y;
+    int tank_w = tank->width;
+    int tank_h = tank->height;
     
-    FlyingEnemy* f_enemies = get_flying_enemies();
+    FlyingEnemy* f_enemies = world->flying_enemies;
     
     for (int i = 0; i < MAX_FLY_ENEMIES; i++) {
         FlyingEnemy* fe = &f_enemies[i];
@@ -147,63 +146,62 @@ void tank_touch_flying_enemy(void) {
                                        fe->x, fe->y, fe->width, fe->height);
 
         if (overlap) {
-            handle_tank_flying_enemy_collision(i);
+            handle_tank_flying_enemy_collision(world, i);
         }
     }
 }
 
 // ===== Damage Application =====
 
-void apply_damage_to_tank(int damage) {
-    if (get_tank_invincible() <= 0.0) {
-        int current_hp = get_tank_hp();
-        int new_hp = current_hp - damage;
+void apply_damage_to_tank(World* world, int damage) {
+    Tank* tank = &world->tank;
+    if (tank->invincible <= 0.0) {
+        int new_hp = tank->hp - damage;
         if (new_hp < 0) new_hp = 0;
-        set_tank_hp(new_hp);
+        if (new_hp > tank->max_hp) new_hp = tank->max_hp;
+        tank->hp = new_hp;
         
         // Set invincibility
-        set_tank_invincible(1.0); // INVINCIBLE_TIME
+        tank->invincible = 1.0; // INVINCIBLE_TIME
         
-        // Update HUD
-        update_tank_hp_display(new_hp);
+        // Notify HUD
+        game_event_emit(world, GAME_EVENT_TANK_DAMAGED, tank->x, tank->y, new_hp);
     }
 }
 
-void apply_damage_to_enemy(int enemy_index, int damage) {
+void apply_damage_to_enemy(World* world, int enemy_index, int damage) {
     if (enemy_index < 0 || enemy_index >= MAX_ENEMIES) return;
     
-    Enemy* enemies = get_enemies();
-    Enemy* e = &enemies[enemy_index];
+    Enemy* e = &world->enemies[enemy_index];
     
     if (e->alive) {
-        damage_enemy(e, damage);
+        damage_enemy(world, e, damage);
         // Update HUD if needed
     }
 }
 
-void apply_damage_to_flying_enemy(int enemy_index, int damage) {
+void apply_damage_to_flying_enemy(World* world, int enemy_index, int damage) {
     if (enemy_index < 0 || enemy_index >= MAX_FLY_ENEMIES) return;
     
-    FlyingEnemy* f_enemies = get_flying_enemies();
-    FlyingEnemy* fe = &f_enemies[enemy_index];
+    FlyingEnemy* fe = &world->flying_enemies[enemy_index];
     
     if (fe->alive) {
-        damage_flying_enemy(fe, damage);
+        damage_flying_enemy(world, fe, damage);
         // Update HUD if needed
     }
 }
 
 // ===== Knockback Effects =====
 
-void apply_knockback_to_tank(double vx, double vy) {
-    set_tank_velocity(vx, vy);
+void apply_knockback_to_tank(World* world, double vx, double vy) {
+    world->tank.vx = vx;
+    world->tank.vy = vy;
 }
 
-void apply_knockback_to_enemy(int enemy_index, double vx, double vy) {
+void apply_knockback_to_enemy(World* world, int enemy_index, double vx, double vy) {
     if (enemy_index < 0 || enemy_index >= MAX_ENEMIES) return;
     
-    Enemy* enemies = get_enemies();
-    Enemy* e = &enemies[enemy_index];
+    Enemy* e = &world->enemies[enemy_index];
     
     if (e->alive) {
         e->vx = vx;
@@ -213,87 +211,85 @@ void apply_knockback_to_enemy(int enemy_index, double vx, double vy) {
 
 // ===== Collision Response =====
 
-void handle_tank_enemy_collision(int enemy_index) {
+void handle_tank_enemy_collision(World* world, int enemy_index) {
     if (enemy_index < 0 || enemy_index >= MAX_ENEMIES) return;
     
-    Enemy* enemies = get_enemies();
-    Enemy* e = &enemies[enemy_index];
+    Tank* tank = &world->tank;
+    Enemy* e = &world->enemies[enemy_index];
     
     if (!e->alive) return;
     
     // contact damage (with invincibility window)
-    if (get_tank_invincible() <= 0.0) {
-        apply_damage_to_tank(DMG_ENEMY_CONTACT);
+    if (tank->invincible <= 0.0) {
+        apply_damage_to_tank(world, DMG_ENEMY_CONTACT);
     }
 
     // symmetric knockback
-    double tank_cx = get_tank_x() + get_tank_width() * 0.5;
+    double tank_cx = tank->x + tank->width * 0.5;
     double enemy_cx = e->x + e->width * 0.5;
     double dir = (tank_cx < enemy_cx) ? -1.0 : 1.0;
 
-    apply_knockback_to_tank(dir * KNOCKBACK_TANK_VX, -KNOCKBACK_TANK_VY);
-    apply_knockback_to_enemy(enemy_index, -dir * KNOCKBACK_ENEMY_VX, -KNOCKBACK_ENEMY_VY);
+    apply_knockback_to_tank(world, dir * KNOCKBACK_TANK_VX, -KNOCKBACK_TANK_VY);
+    apply_knockback_to_enemy(world, enemy_index, -dir * KNOCKBACK_ENEMY_VX, -KNOCKBACK_ENEMY_VY);
 
     // small separation to resolve overlap
-    double tank_x = get_tank_x();
     if (dir > 0) {
-        set_tank_x(tank_x + 2.0);
+        tank->x += 2.0;
         e->x -= 2.0;
     } else {
-        set_tank_x(tank_x - 2.0);
+        tank->x -= 2.0;
         e->x += 2.0;
     }
 }
 
-void handle_bullet_enemy_collision(int bullet_index, int enemy_index, bool is_flying) {
+void handle_bullet_enemy_collision(World* world, int bullet_index, int enemy_index, bool is_flying) {
     if (bullet_index < 0) return;
     
-    Bullet* bullets = get_bullets();
-    if (bullet_index >= get_max_bullets() || !bullets[bullet_index].alive) return;
+    Bullet* bullets = world->bullets;
+    if (bullet_index >= world->max_bullets || !bullets[bullet_index].alive) return;
     
     bullets[bullet_index].alive = false;
     
     if (is_flying) {
         if (enemy_index >= 0 && enemy_index < MAX_FLY_ENEMIES) {
-            apply_damage_to_flying_enemy(enemy_index, DMG_MG);
+            apply_damage_to_flying_enemy(world, enemy_index, DMG_MG);
         }
     } else {
         if (enemy_index >= 0 && enemy_index < MAX_ENEMIES) {
-            apply_damage_to_enemy(enemy_index, DMG_MG);
+            apply_damage_to_enemy(world, enemy_index, DMG_MG);
         }
     }
 }
 
-void handle_tank_flying_enemy_collision(int enemy_index) {
+void handle_tank_flying_enemy_collision(World* world, int enemy_index) {
     if (enemy_index < 0 || enemy_index >= MAX_FLY_ENEMIES) return;
     
-    FlyingEnemy* f_enemies = get_flying_enemies();
-    FlyingEnemy* fe = &f_enemies[enemy_index];
+    Tank* tank = &world->tank;
+    FlyingEnemy* fe = &world->flying_enemies[enemy_index];
     
     if (!fe->alive) return;
     
     // contact damage (with invincibility window)
-    if (get_tank_invincible() <= 0.0) {
-        apply_damage_to_tank(DMG_ENEMY_CONTACT);
+    if (tank->invincible <= 0.0) {
+        apply_damage_to_tank(world, DMG_ENEMY_CONTACT);
     }
 
     // tank knockback only (flying enemy keeps its original behavior)
-    double tank_cx = get_tank_x() + get_tank_width() * 0.5;
+    double tank_cx = tank->x + tank->width * 0.5;
     double enemy_cx = fe->x + fe->width * 0.5;
     double dir = (tank_cx < enemy_cx) ? -1.0 : 1.0;
 
-    apply_knockback_to_tank(dir * KNOCKBACK_TANK_VX, -KNOCKBACK_TANK_VY);
+    apply_knockback_to_tank(world, dir * KNOCKBACK_TANK_VX, -KNOCKBACK_TANK_VY);
     
     // flying enemy keeps its original velocity (no knockback)
     // fe->vx remains unchanged
 
     // small separation to resolve overlap
-    double tank_x = get_tank_x();
     if (dir > 0) {
-        set_tank_x(tank_x + 2.0);
+        tank->x += 2.0;
         fe->x -= 2.0;
     } else {
-        set_tank_x(tank_x - 2.0);
+        tank->x -= 2.0;
         fe->x += 2.0;
     }
 }
@@ -3,6 +3,8 @@
 
 #include <stdbool.h>
 
+struct World;  // world.h
+
 // ===== Function Declarations =====
 
 // Collision detection utilities
@@ -11,25 +13,25 @@ bool rect_rect_overlap(double x1, double y1, double w1, double h1,
                       double x2, double y2, double w2, double h2);
 
 // Bullet collision detection
-void bullets_hit_enemies(void);
-void bullets_hit_tank(void);
+void bullets_hit_enemies(struct World* world);
+void bullets_hit_tank(struct World* world);
 
 // Tank-enemy collision detection
-void tank_touch_ground_enemy(void);
-void tank_touch_flying_enemy(void);
+void tank_touch_ground_enemy(struct World* world);
+void tank_touch_flying_enemy(struct World* world);
 
 // Damage application
-void apply_damage_to_tank(int damage);
-void apply_damage_to_enemy(int enemy_index, int damage);
-void apply_damage_to_flying_enemy(int enemy_index, int damage);
+void apply_damage_to_tank(struct World* world, int damage);
+void apply_damage_to_enemy(struct World* world, int enemy_index, int damage);
+void apply_damage_to_flying_enemy(struct World* world, int enemy_index, int damage);
 
 // Knockback effects
-void apply_knockback_to_tank(double vx, double vy);
-void apply_knockback_to_enemy(int enemy_index, double vx, double vy);
+void apply_knockback_to_tank(struct World* world, double vx, double vy);
+void apply_knockback_to_enemy(struct World* world, int enemy_index, double vx, double vy);
 
 // Collision response
-void handle_tank_enemy_collision(int enemy_index);
-void handle_tank_flying_enemy_collision(int enemy_index);
-void handle_bullet_enemy_collision(int bullet_index, int enemy_index, bool is_flying);
+void handle_tank_enemy_collision(struct World* world, int enemy_index);
+void handle_tank_flying_enemy_collision(struct World* world, int enemy_index);
+void handle_bullet_enemy_collision(struct World* world, int bullet_index, int enemy_index, bool is_flying);
 
 #endif // COLLISION_H
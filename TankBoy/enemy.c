@@ -3,15 +3,16 @@
 #include "tank.h"
 #include "bullet.h"
 #include "ini_parser.h"
-#include "game_system.h"
+#include "world.h"
+#include "game_events.h"
+#include "spatial_hash.h"
 #include <math.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
 
 // ===== Globals =====
-static Enemy enemies[MAX_ENEMIES];
-static FlyingEnemy f_enemies[MAX_FLY_ENEMIES];
+// Tuning only; the enemy pools themselves live in World
 
 // Jump timing parameters loaded from config.ini
 double enemy_jump_interval_min = 1.8;  // Default values
@@ -35,14 +36,176 @@ double max_shooting_distance = 800.0;
 static int enemy_align_x = 20;
 static int flying_enemy_align_x = 10;
 
-// sprite
+// ===== Flying Enemy Motion Helpers =====
 
-enemy_sprites_t enemy_sprites;
+#define FLY_RENORMALIZE_STEPS 64    // pull phasors back onto the unit circle this often
 
+FlyOscillatorStep flying_enemy_oscillator_step(double dt) {
+    // Computed once per update pass, not once per enemy
+    FlyOscillatorStep step;
+    step.y_cos = cos(dt * FLY_BOB_RATE);
+    step.y_sin = sin(dt * FLY_BOB_RATE);
+    step.x_cos = cos(dt * FLY_PATROL_RATE);
+    step.x_sin = sin(dt * FLY_PATROL_RATE);
+    return step;
+}
+
+void flying_enemy_reset_oscillators(FlyingEnemy* fe) {
+    fe->y_sin = 0.0;
+    fe->y_cos = 1.0;
+    fe->x_sin = 0.0;
+    fe->x_cos = 1.0;
+    fe->osc_steps = 0;
+}
+
+// Advance both phasors by one step: (c + i*s) *= (step_c + i*step_s)
+static void flying_enemy_advance_oscillators(FlyingEnemy* fe, const FlyOscillatorStep* step) {
+    double ys = fe->y_sin * step->y_cos + fe->y_cos * step->y_sin;
+    double yc = fe->y_cos * step->y_cos - fe->y_sin * step->y_sin;
+    double xs = fe->x_sin * step->x_cos + fe->x_cos * step->x_sin;
+    double xc = fe->x_cos * step->x_cos - fe->x_sin * step->x_sin;
+
+    // Rounding slowly changes the phasor length; a first-order correction
+    // (1.5 - 0.5 * |z|^2) is enough because the drift per period is tiny
+    if (++fe->osc_steps >= FLY_RENORMALIZE_STEPS) {
+        double ky = 1.5 - 0.5 * (ys * ys + yc * yc);
+        double kx = 1.5 - 0.5 * (xs * xs + xc * xc);
+        ys *= ky; yc *= ky;
+        xs *= kx; xc *= kx;
+        fe->osc_steps = 0;
+    }
+
+    fe->y_sin = ys; fe->y_cos = yc;
+    fe->x_sin = xs; fe->x_cos = xc;
+}
+
+void flying_enemy_fly(FlyingEnemy* fe, const FlyOscillatorStep* step) {
+    // Y-axis: up-down oscillation, X-axis: left-right patrol around spawn position
+    flying_enemy_advance_oscillators(fe, step);
+    fe->y = fe->base_y + fe->y_sin * FLY_BOB_AMPLITUDE;
+    fe->x = fe->spawn_x + fe->x_sin * FLY_PATROL_AMPLITUDE;
+    
+    // Velocity from the analytic derivative of the patrol (px/s)
+    fe->vx = fe->x_cos * FLY_PATROL_AMPLITUDE * FLY_PATROL_RATE;
+    
+    // Update facing direction based on velocity
+    if (fe->vx > 0) {
+        fe->facing_right = true;
+    } else if (fe->vx < 0) {
+        fe->facing_right = false;
+    }
+    // If vx == 0, keep previous facing direction
+}
+
+// Crowd separation: drift the patrol anchor away from nearby helicopters.
+// A pushed anchor is kept where the helicopter itself may fly, so a crowd
+// cannot walk the patrol off the map
+static void flying_enemy_separate(World* world, FlyingEnemy* fe, int index, double dt, int map_width, int map_height) {
+    double sep_x, sep_y;
+    spatial_hash_separation(&world->spatial, SPATIAL_FLYING_ENEMY, index, fe->x + fe->width * 0.5, fe->y + fe->height * 0.5,
+                            FLY_SEPARATION_RADIUS, &sep_x, &sep_y);
+
+    if (sep_x != 0.0) {
+        fe->spawn_x += sep_x * FLY_SEPARATION_SPEED * dt;
+        if (fe->spawn_x < 0) fe->spawn_x = 0;
+        if (fe->spawn_x > map_width - fe->width) fe->spawn_x = map_width - fe->width;
+    }
+    if (sep_y != 0.0) {
+        fe->base_y += sep_y * FLY_SEPARATION_SPEED * dt;
+        if (fe->base_y < 50) fe->base_y = 50;  // same limits as the flight bounds below
+        if (fe->base_y > map_height - fe->height) fe->base_y = map_height - fe->height;
+    }
+}
+
+// Fire one burst round at the player tank if it is within shooting range
+static void flying_enemy_fire_at_tank(World* world, const FlyingEnemy* fe) {
+    double dx = world->tank.x - fe->x;
+    double dy = world->tank.y - fe->y;
+    double dist_sq = dx * dx + dy * dy;
+
+    // Compare squared distances; only rounds that are actually fired pay for the sqrt
+    if (dist_sq > max_shooting_distance * max_shooting_distance || dist_sq <= 0.0) return;
+
+    Bullet* bullets = world->bullets;
+    if (!bullets) return;
+
+    for (int j = 0; j < world->max_bullets; j++) {
+        if (bullets[j].alive) continue;
+
+        // Normalized aim vector scaled to bullet speed (no atan2/cos/sin)
+        double inv_len = flying_enemy_bullet_speed / sqrt(dist_sq);
+
+        bullets[j].alive = true;
+        bullets[j].x = fe->x + fe->width / 2.0;
+        bullets[j].y = fe->y + fe->height / 2.0;
+        bullets[j].prev_x = bullets[j].x;
+        bullets[j].prev_y = bullets[j].y;
+        bullets[j].weapon = 0;      // MG round
+        bullets[j].from_enemy = true;
+        bullets[j].width = flying_enemy_bullet_width;
+        bullets[j].height = flying_enemy_bullet_height;
+        bullets[j].vx = dx * inv_len;
+        bullets[j].vy = dy * inv_len;
+        bullets[j].angle = atan2(dy, dx); // draw orientation, paid once per shot
+        return;
+    }
+}
 
-// ===== Enemy Initialization =====
 
-void enemies_init(void) {
+// ===== Enemy Archetypes =====
+
+// Tuning every world starts with (filled once by enemy_archetypes_init)
+static EnemyTuning default_tuning = {
+    .archetypes = {
+        [ENEMY_TYPE_TANK]       = { "tank" },
+        [ENEMY_TYPE_HELICOPTER] = { "helicopter" },
+    },
+    .splash_radius = CANNON_SPLASH_RADIUS,
+};
+static bool archetypes_loaded = false;
+
+static int clamp_difficulty(int difficulty) {
+    if (difficulty < 1) return 1;
+    if (difficulty > ENEMY_DIFFICULTY_LEVELS) return ENEMY_DIFFICULTY_LEVELS;
+    return difficulty;
+}
+
+void enemy_tuning_build(EnemyTuning* tuning) {
+    const EnemyArchetype* tank = &tuning->archetypes[ENEMY_TYPE_TANK];
+    const EnemyArchetype* heli = &tuning->archetypes[ENEMY_TYPE_HELICOPTER];
+
+    for (int d = 1; d <= ENEMY_DIFFICULTY_LEVELS; d++) {
+        Enemy* e = &tuning->ground_templates[d];
+        memset(e, 0, sizeof(*e));
+        e->alive = true;
+        e->on_ground = true;
+        e->max_hp = tank->base_hp + d * tank->hp_per_difficulty;
+        e->hp = e->max_hp;
+        e->speed = tank->base_speed + d * tank->speed_per_difficulty;
+        e->width = tank->width;
+        e->height = tank->height;
+        e->difficulty = d;
+        e->facing_right = true;
+        e->sprite_index = d - 1;
+
+        FlyingEnemy* fe = &tuning->flying_templates[d];
+        memset(fe, 0, sizeof(*fe));
+        fe->alive = true;
+        flying_enemy_reset_oscillators(fe);
+        fe->shot_interval = heli->shot_interval;
+        fe->rest_timer = heli->rest_time;
+        fe->max_hp = heli->base_hp + d * heli->hp_per_difficulty;
+        fe->hp = fe->max_hp;
+        fe->width = heli->width;
+        fe->height = heli->height;
+        fe->difficulty = d;
+        fe->facing_right = true;
+        fe->sprite_index = d - 1;
+    }
+}
+
+// Read every enemy setting from config.ini in one pass (called once at startup)
+void enemy_archetypes_init(void) {
     // Load enemy parameters from config.ini
     const MapConfig* config = map_get_config();
     if (config) {
@@ -56,115 +219,129 @@ void enemies_init(void) {
         printf("  Base speed: %.1f, Speed per difficulty: %.1f\n", enemy_base_speed, enemy_speed_per_difficulty);
     }
     
+    IniParser* parser = ini_parser_create();
+    ini_parser_load_file(parser, "TankBoy/config.ini");
+
     // Load flying enemy bullet parameters from config.ini
-    IniParser* bullet_parser = ini_parser_create();
-    ini_parser_load_file(bullet_parser, "TankBoy/config.ini");
-    flying_enemy_burst_count = ini_parser_get_int(bullet_parser, "EnemyBullets", "flying_enemy_burst_count", 10);
-    flying_enemy_shot_interval = ini_parser_get_double(bullet_parser, "EnemyBullets", "flying_enemy_shot_interval", 0.05);
-    flying_enemy_rest_time = ini_parser_get_double(bullet_parser, "EnemyBullets", "flying_enemy_rest_time", 2.0);
-    flying_enemy_bullet_speed = ini_parser_get_double(bullet_parser, "EnemyBullets", "flying_enemy_bullet_speed", 8.0);
-    flying_enemy_bullet_width = ini_parser_get_int(bullet_parser, "EnemyBullets", "flying_enemy_bullet_width", 6);
-    flying_enemy_bullet_height = ini_parser_get_int(bullet_parser, "EnemyBullets", "flying_enemy_bullet_height", 3);
-    roi_multiplier = ini_parser_get_double(bullet_parser, "EnemyBullets", "roi_multiplier", 1.5);
-    max_shooting_distance = ini_parser_get_double(bullet_parser, "EnemyBullets", "max_shooting_distance", 800.0);
-    
-    ini_parser_destroy(bullet_parser);
+    flying_enemy_burst_count = ini_parser_get_int(parser, "EnemyBullets", "flying_enemy_burst_count", 10);
+    flying_enemy_shot_interval = ini_parser_get_double(parser, "EnemyBullets", "flying_enemy_shot_interval", 0.05);
+    flying_enemy_rest_time = ini_parser_get_double(parser, "EnemyBullets", "flying_enemy_rest_time", 2.0);
+    flying_enemy_bullet_speed = ini_parser_get_double(parser, "EnemyBullets", "flying_enemy_bullet_speed", 8.0);
+    flying_enemy_bullet_width = ini_parser_get_int(parser, "EnemyBullets", "flying_enemy_bullet_width", 6);
+    flying_enemy_bullet_height = ini_parser_get_int(parser, "EnemyBullets", "flying_enemy_bullet_height", 3);
+    roi_multiplier = ini_parser_get_double(parser, "EnemyBullets", "roi_multiplier", 1.5);
+    max_shooting_distance = ini_parser_get_double(parser, "EnemyBullets", "max_shooting_distance", 800.0);
     
     printf("Loaded flying enemy bullet parameters:\n");
     printf("  Burst count: %d, Shot interval: %.3f seconds\n", flying_enemy_burst_count, flying_enemy_shot_interval);
     printf("  Rest time: %.1f seconds, Bullet speed: %.1f\n", flying_enemy_rest_time, flying_enemy_bullet_speed);
     printf("  Bullet size: %dx%d\n", flying_enemy_bullet_width, flying_enemy_bullet_height);
-    
-    // Load enemy dimensions from config
-    IniParser* parser = ini_parser_create();
-    ini_parser_load_file(parser, "TankBoy/config.ini");
-    int enemy_width = ini_parser_get_int(parser, "Enemy", "enemy_width", 25);
-    int enemy_height = ini_parser_get_int(parser, "Enemy", "enemy_height", 15);
+
+    EnemyArchetype* tank = &default_tuning.archetypes[ENEMY_TYPE_TANK];
+    tank->width = ini_parser_get_int(parser, "Enemy", "enemy_width", 25);
+    tank->height = ini_parser_get_int(parser, "Enemy", "enemy_height", 15);
+    tank->base_hp = ENEMY_BASE_HP;
+    tank->hp_per_difficulty = ENEMY_HP_PER_DIFFICULTY;
+    tank->base_speed = enemy_base_speed;
+    tank->speed_per_difficulty = enemy_speed_per_difficulty;
+
+    EnemyArchetype* heli = &default_tuning.archetypes[ENEMY_TYPE_HELICOPTER];
+    heli->width = ini_parser_get_int(parser, "Enemy", "flying_enemy_width", 30);
+    heli->height = ini_parser_get_int(parser, "Enemy", "flying_enemy_height", 20);
+    heli->base_hp = FLY_BASE_HP;
+    heli->hp_per_difficulty = FLY_HP_PER_ROUND;
+    heli->base_speed = 1.0;
+    heli->speed_per_difficulty = 0.2;
+    heli->burst_count = flying_enemy_burst_count;
+    heli->shot_interval = flying_enemy_shot_interval;
+    heli->rest_time = flying_enemy_rest_time;
+
     ini_parser_destroy(parser);
-    
-    for (int i = 0; i < MAX_ENEMIES; i++) {
-        enemies[i].alive = false;
-        enemies[i].x = 0.0;
-        enemies[i].y = 0.0;
-        enemies[i].vx = 0.0;
-        enemies[i].vy = 0.0;
-        enemies[i].on_ground = true;
-        enemies[i].hp = 0;
-        enemies[i].max_hp = 0;
-        enemies[i].last_x = 0.0;
-        enemies[i].stuck_time = 0.0;
-        enemies[i].speed = 0.0;
-        enemies[i].jump_timer = 0.0;
-        enemies[i].facing_right = true;  // Default facing right
-        
-        // Set dimensions from config
-        enemies[i].width = enemy_width;
-        enemies[i].height = enemy_height;
-    }
+
+    enemy_tuning_build(&default_tuning);
+    archetypes_loaded = true;
 }
 
+const EnemyArchetype* enemy_get_archetype(EnemyType type) {
+    if (type < 0 || type >= ENEMY_TYPE_COUNT) return NULL;
+    return &default_tuning.archetypes[type];
+}
 
-void enemy_sprites_init() {
-    
-    enemy_sprites.land_enemy_sheet = NULL; // not using total combined sheet
-    
-    enemy_sprites.land_enemy_sprites = malloc(3 * sizeof(ALLEGRO_BITMAP*));
-    for (int i = 0; i < 3; i++) {
-        char enemy_sprite_file_path[256];
-        snprintf(enemy_sprite_file_path, sizeof(enemy_sprite_file_path), "TankBoy/resources/sprites/enemy%d.png", i+1);
-        enemy_sprites.land_enemy_sprites[i] = al_load_bitmap(enemy_sprite_file_path);
-        if (enemy_sprites.land_enemy_sprites[i] == NULL) {
-            printf("wrong location of enemy sprite!!\n");
-        }
+const EnemyTuning* enemy_default_tuning(void) {
+    if (!archetypes_loaded) enemy_archetypes_init();
+    return &default_tuning;
+}
+
+EnemyType enemy_type_from_string(const char* name) {
+    if (!name) return ENEMY_TYPE_UNKNOWN;
+    for (int t = 0; t < ENEMY_TYPE_COUNT; t++) {
+        if (strcmp(name, default_tuning.archetypes[t].name) == 0) return (EnemyType)t;
     }
+    return ENEMY_TYPE_UNKNOWN;
 }
 
+// Random initial jump timer within the configured interval
+static double random_jump_timer(Rng* rng) {
+    int steps = (int)((enemy_jump_interval_max - enemy_jump_interval_min) * 10);
+    return enemy_jump_interval_min + rng_int(rng, 0, steps - 1) / 10.0;
+}
 
-void flying_enemy_sprites_init() {
+// Place a ground enemy from its template; y is snapped to the ground when a map is given
+static void spawn_ground_from_template(World* world, Enemy* e, int difficulty, double x, double y, const Map* map) {
+    *e = world->tuning->ground_templates[clamp_difficulty(difficulty)];
+    e->id = world->next_enemy_id++;
+    e->rng = rng_substream(&world->rng, e->id);
+    e->x = x;
+    e->last_x = x;
+    e->y = map ? map_get_ground_level(map, (int)x, e->width) - e->height : y;
+    e->prev_x = e->x;
+    e->prev_y = e->y;
+    e->jump_timer = random_jump_timer(&e->rng);
+}
 
-    char* flying_enemy_sprite_file = "TankBoy/resources/sprites/helicopters.png";
-    enemy_sprites.flying_enemy_sheet = al_load_bitmap(flying_enemy_sprite_file);
-    if (enemy_sprites.flying_enemy_sheet == NULL) {
-        printf("wrong location of flying enemy sprite!!\n");
-    }
-    
-    enemy_sprites.flying_enemy_sprites = malloc(3 * sizeof(ALLEGRO_BITMAP*));
-    int width = al_get_bitmap_width(enemy_sprites.flying_enemy_sheet) / 3;
-    int height = al_get_bitmap_height(enemy_sprites.flying_enemy_sheet);
-    for (int i = 0; i < 3; i++) {
-        enemy_sprites.flying_enemy_sprites[i] = al_create_sub_bitmap(enemy_sprites.flying_enemy_sheet, i*width, 0, width, height);
+static void spawn_flying_from_template(World* world, FlyingEnemy* fe, int difficulty, double x, double y) {
+    const EnemyArchetype* heli = &world->tuning->archetypes[ENEMY_TYPE_HELICOPTER];
+    *fe = world->tuning->flying_templates[clamp_difficulty(difficulty)];
+    fe->id = world->next_enemy_id++;
+    fe->rng = rng_substream(&world->rng, fe->id);
+    fe->x = x;
+    fe->y = y;
+    fe->prev_x = x;
+    fe->prev_y = y;
+    fe->base_y = y;
+    fe->spawn_x = x;  // Store spawn position
+    fe->vx = (rng_bool(&fe->rng) ? 1.0 : -1.0) * (heli->base_speed + fe->difficulty * heli->speed_per_difficulty);
+    fe->rest_timer = 0.5 + rng_int(&fe->rng, 0, 49) / 100.0;
+    fe->facing_right = (fe->vx > 0);  // Set based on initial velocity
+}
+
+
+// ===== Enemy Initialization =====
+
+void enemies_init(World* world) {
+    if (!archetypes_loaded) enemy_archetypes_init();
+    world->next_enemy_id = 0;
+
+    Enemy* enemies = world->enemies;
+    for (int i = 0; i < MAX_ENEMIES; i++) {
+        enemies[i] = world->tuning->ground_templates[1];
+        enemies[i].alive = false;
+        enemies[i].hp = 0;
+        enemies[i].max_hp = 0;
+        enemies[i].speed = 0.0;
     }
 }
 
-void flying_enemies_init(void) {
-    // Load flying enemy dimensions from config
-    IniParser* parser = ini_parser_create();
-    ini_parser_load_file(parser, "TankBoy/config.ini");
-    int flying_enemy_width = ini_parser_get_int(parser, "Enemy", "flying_enemy_width", 30);
-    int flying_enemy_height = ini_parser_get_int(parser, "Enemy", "flying_enemy_height", 20);
-    ini_parser_destroy(parser);
-    
+
+void flying_enemies_init(World* world) {
+    if (!archetypes_loaded) enemy_archetypes_init();
+
+    FlyingEnemy* f_enemies = world->flying_enemies;
     for (int i = 0; i < MAX_FLY_ENEMIES; i++) {
+        f_enemies[i] = world->tuning->flying_templates[1];
         f_enemies[i].alive = false;
-        f_enemies[i].x = 0.0;
-        f_enemies[i].y = 0.0;
-        f_enemies[i].vx = 0.0;
-        f_enemies[i].base_y = 0.0;
-        f_enemies[i].spawn_x = 0.0;
-        f_enemies[i].angle = 0.0;
-        f_enemies[i].x_angle = 0.0;
-        f_enemies[i].in_burst = false;
-        f_enemies[i].burst_shots_left = 0;
-        f_enemies[i].shot_interval = flying_enemy_shot_interval;
-        f_enemies[i].shot_timer = 0.0;
-        f_enemies[i].rest_timer = flying_enemy_rest_time;
         f_enemies[i].hp = 0;
         f_enemies[i].max_hp = 0;
-        f_enemies[i].facing_right = true;  // Default facing right
-        
-        // Set dimensions from config
-        f_enemies[i].width = flying_enemy_width;
-        f_enemies[i].height = flying_enemy_height;
     }
 }
 
@@ -172,228 +349,71 @@ void flying_enemies_init(void) {
 
 // ===== Enemy Spawning =====
 
-void load_enemies_from_csv_with_map(int stage_number, const Map* map) {
-    char csv_path[256];
-    snprintf(csv_path, sizeof(csv_path), "TankBoy/resources/stages/enemies%d.csv", stage_number);
-    
-    FILE* file = fopen(csv_path, "r");
-    if (!file) {
-        printf("Warning: Could not open enemy CSV file: %s\n", csv_path);
-        return;
-    }
-    
-    char line[256];
-    int line_count = 0;
-    
-    // Skip header line
-    if (fgets(line, sizeof(line), file)) {
-        line_count++;
-    }
-    
-    int enemy_index = 0;
-    while (fgets(line, sizeof(line), file) && enemy_index < MAX_ENEMIES) {
-        line_count++;
-        
-        // Remove newline
-        line[strcspn(line, "\n")] = 0;
-        
-        char* token = strtok(line, ",");
-        if (!token) continue;
-        
-        double x = atof(token);
-        
-        token = strtok(NULL, ",");
-        if (!token) continue;
-        double y = atof(token);
-        
-        token = strtok(NULL, ",");
-        if (!token) continue;
-        char enemy_type[32];
-        strncpy(enemy_type, token, sizeof(enemy_type) - 1);
-        enemy_type[sizeof(enemy_type) - 1] = 0;
-        
-        token = strtok(NULL, ",");
-        int difficulty = token ? atoi(token) : 1;
-        
-        // Find available enemy slot
-        while (enemy_index < MAX_ENEMIES && enemies[enemy_index].alive) {
-            enemy_index++;
-        }
-        
-        if (enemy_index >= MAX_ENEMIES) break;
-        
-        // Initialize enemy based on type
-        if (strcmp(enemy_type, "tank") == 0) {
-            // Load enemy dimensions from config
-            IniParser* parser = ini_parser_create();
-            ini_parser_load_file(parser, "TankBoy/config.ini");
-            int enemy_width = ini_parser_get_int(parser, "Enemy", "enemy_width", 25);
-            int enemy_height = ini_parser_get_int(parser, "Enemy", "enemy_height", 15);
-            ini_parser_destroy(parser);
-            
-            enemies[enemy_index].alive = true;
-            enemies[enemy_index].x = x;
-            
-            // Use actual map ground level if map is available
-            if (map) {
-                int ground_level = map_get_ground_level(map, (int)x, enemy_width);
-                enemies[enemy_index].y = ground_level - enemy_height;
-            } else {
-                enemies[enemy_index].y = y;
-            }
-            
-            enemies[enemy_index].vx = 0.0;
-            enemies[enemy_index].vy = 0.0;
-            enemies[enemy_index].on_ground = true;
-            enemies[enemy_index].max_hp = ENEMY_BASE_HP + difficulty * 40;
-            enemies[enemy_index].hp = enemies[enemy_index].max_hp;
-            enemies[enemy_index].last_x = x;
-            enemies[enemy_index].stuck_time = 0.0;
-            enemies[enemy_index].speed = enemy_base_speed + difficulty * enemy_speed_per_difficulty;
-            enemies[enemy_index].jump_timer = enemy_jump_interval_min + (rand() % (int)((enemy_jump_interval_max - enemy_jump_interval_min) * 10)) / 10.0;  // Random initial timer
-            
-            // Set dimensions from config
-            enemies[enemy_index].width = enemy_width;
-            enemies[enemy_index].height = enemy_height;
-            
-            // Store difficulty for scoring
-            enemies[enemy_index].difficulty = difficulty;
-            enemies[enemy_index].facing_right = true;  // Default facing right
-            
-            printf("Spawned tank enemy at (%f, %f) with difficulty %d\n", x, enemies[enemy_index].y, difficulty);
+// Place one enemy into a free slot (used by the wave scheduler)
+bool enemy_spawn(World* world, EnemyType type, int difficulty, double x, double y) {
+    Enemy* enemies = world->enemies;
+    FlyingEnemy* f_enemies = world->flying_enemies;
+
+    if (type == ENEMY_TYPE_TANK) {
+        for (int i = 0; i < MAX_ENEMIES; i++) {
+            if (enemies[i].alive) continue;
+            spawn_ground_from_template(world, &enemies[i], difficulty, x, y, (const Map*)&world->map);
+            return true;
         }
-        else if (strcmp(enemy_type, "helicopter") == 0) {
-            // Find available flying enemy slot
-            int fly_index = 0;
-            while (fly_index < MAX_FLY_ENEMIES && f_enemies[fly_index].alive) {
-                fly_index++;
-            }
-            
-            if (fly_index < MAX_FLY_ENEMIES) {
-                // Load flying enemy dimensions from config
-                IniParser* parser = ini_parser_create();
-                ini_parser_load_file(parser, "TankBoy/config.ini");
-                int flying_enemy_width = ini_parser_get_int(parser, "Enemy", "flying_enemy_width", 30);
-                int flying_enemy_height = ini_parser_get_int(parser, "Enemy", "flying_enemy_height", 20);
-                ini_parser_destroy(parser);
-                
-                f_enemies[fly_index].alive = true;
-                f_enemies[fly_index].x = x;
-                f_enemies[fly_index].y = y;
-                f_enemies[fly_index].base_y = y;
-                f_enemies[fly_index].spawn_x = x;  // Store spawn position
-                f_enemies[fly_index].vx = (rand() % 2 ? 1.0 : -1.0) * (1.0 + difficulty * 0.2);
-                f_enemies[fly_index].angle = 0.0;
-                f_enemies[fly_index].x_angle = 0.0;
-                f_enemies[fly_index].in_burst = false;
-                f_enemies[fly_index].burst_shots_left = 0;
-                f_enemies[fly_index].shot_interval = 0.05;
-                f_enemies[fly_index].shot_timer = 0.0;
-                f_enemies[fly_index].rest_timer = 0.5 + (rand() % 50) / 100.0;
-                f_enemies[fly_index].max_hp = FLY_BASE_HP + FLY_HP_PER_ROUND * difficulty;
-                f_enemies[fly_index].hp = f_enemies[fly_index].max_hp;
-                
-                // Set dimensions from config
-                f_enemies[fly_index].width = flying_enemy_width;
-                f_enemies[fly_index].height = flying_enemy_height;
-                
-                // Store difficulty for scoring
-                f_enemies[fly_index].difficulty = difficulty;
-                f_enemies[fly_index].facing_right = (f_enemies[fly_index].vx > 0);  // Set based on initial velocity
-                
-                printf("Spawned helicopter enemy at (%f, %f) with difficulty %d\n", x, y, difficulty);
-            }
+    }
+    else if (type == ENEMY_TYPE_HELICOPTER) {
+        for (int i = 0; i < MAX_FLY_ENEMIES; i++) {
+            if (f_enemies[i].alive) continue;
+            spawn_flying_from_template(world, &f_enemies[i], difficulty, x, y);
+            return true;
         }
-        
-        enemy_index++;
     }
-    
-    fclose(file);
-    printf("Loaded %d enemies from CSV\n", enemy_index);
+    return false;
 }
 
-void spawn_enemies(int round_number) {
+void spawn_enemies(World* world, int round_number) {
+    Enemy* enemies = world->enemies;
     int count = round_number + 2;
     int map_width = map_get_map_width();
+    Rng* rng = &world->rng;
     
     for (int i = 0; i < MAX_ENEMIES && count > 0; i++) {
         if (!enemies[i].alive) {
-            // Load enemy dimensions from config
-            IniParser* parser = ini_parser_create();
-            ini_parser_load_file(parser, "TankBoy/config.ini");
-            int enemy_width = ini_parser_get_int(parser, "Enemy", "enemy_width", 25);
-            int enemy_height = ini_parser_get_int(parser, "Enemy", "enemy_height", 15);
-            ini_parser_destroy(parser);
-            
-            enemies[i].alive = true;
-
             // Spawn enemies at map edges, but ensure they're within bounds
-            if (rand() % 2) {
-                enemies[i].x = 50 + rand() % 100; // Left side
+            double x;
+            if (rng_bool(rng)) {
+                x = 50 + rng_int(rng, 0, 99); // Left side
             } else {
-                enemies[i].x = map_width - 150 + rand() % 100; // Right side
+                x = map_width - 150 + rng_int(rng, 0, 99); // Right side
             }
 
             // Get ground level at spawn position and place enemy on ground
-            int ground_level = map_get_ground_level(NULL, (int)enemies[i].x, enemy_width);
-            enemies[i].y = ground_level - enemy_height;
-            
-            enemies[i].vx = 0.0;
-            enemies[i].vy = 0.0;
-            enemies[i].on_ground = true;
+            spawn_ground_from_template(world, &enemies[i], 1, x, 0.0, NULL);
+            enemies[i].y = map_get_ground_level(NULL, (int)x, enemies[i].width) - enemies[i].height;
 
+            // Round-based spawns scale with the round instead of the stage difficulty
             enemies[i].max_hp = ENEMY_BASE_HP + ENEMY_HP_PER_ROUND * round_number;
             enemies[i].hp = enemies[i].max_hp;
-
-            enemies[i].last_x = enemies[i].x;
-            enemies[i].stuck_time = 0.0;
-
             enemies[i].speed = enemy_base_speed + round_number * enemy_speed_per_difficulty;
-            enemies[i].jump_timer = enemy_jump_interval_min + (rand() % (int)((enemy_jump_interval_max - enemy_jump_interval_min) * 10)) / 10.0;  // Random initial timer
-
-            // Set dimensions from config
-            enemies[i].width = enemy_width;
-            enemies[i].height = enemy_height;
 
             count--;
         }
     }
 }
 
-void spawn_flying_enemy(int round_number) {
+void spawn_flying_enemy(World* world, int round_number) {
+    FlyingEnemy* f_enemies = world->flying_enemies;
     int map_width = map_get_map_width();
+    Rng* rng = &world->rng;
     
     for (int i = 0; i < MAX_FLY_ENEMIES; i++) {
         if (!f_enemies[i].alive) {
-            // Load flying enemy dimensions from config
-            IniParser* parser = ini_parser_create();
-            ini_parser_load_file(parser, "TankBoy/config.ini");
-            int flying_enemy_width = ini_parser_get_int(parser, "Enemy", "flying_enemy_width", 30);
-            int flying_enemy_height = ini_parser_get_int(parser, "Enemy", "flying_enemy_height", 20);
-            ini_parser_destroy(parser);
-            
-            f_enemies[i].alive = true;
-            f_enemies[i].x = rand() % map_width;
-            f_enemies[i].base_y = 100 + rand() % 100;
-            f_enemies[i].y = f_enemies[i].base_y;
-            f_enemies[i].spawn_x = f_enemies[i].x;  // 스폰 위치 저장
-            f_enemies[i].vx = (rand() % 2 ? 1.0 : -1.0) * (1.0 + round_number * 0.2);
-            f_enemies[i].angle = 0.0;
-            f_enemies[i].x_angle = 0.0;
-
-            f_enemies[i].in_burst = false;
-            f_enemies[i].burst_shots_left = 0;
-            f_enemies[i].shot_interval = 0.05;
-            f_enemies[i].shot_timer = 0.0;
-            f_enemies[i].rest_timer = 0.5 + (rand() % 50) / 100.0;
+            double x = rng_int(rng, 0, map_width - 1);
+            double base_y = 100 + rng_int(rng, 0, 99);
+            spawn_flying_from_template(world, &f_enemies[i], 1, x, base_y);
 
             f_enemies[i].max_hp = FLY_BASE_HP + FLY_HP_PER_ROUND * round_number;
             f_enemies[i].hp = f_enemies[i].max_hp;
-            
-            // Set dimensions from config
-            f_enemies[i].width = flying_enemy_width;
-            f_enemies[i].height = flying_enemy_height;
-            
             break;
         }
     }
@@ -401,7 +421,8 @@ void spawn_flying_enemy(int round_number) {
 
 // ===== Enemy Updates =====
 
-void enemies_update_roi_with_map(double dt, double camera_x, double camera_y, int buffer_width, int buffer_height, const Map* map) {
+void enemies_update_roi(World* world, double dt) {
+    const Map* map = (const Map*)&world->map;
     const double gravity = 0.5;
     const double jump_power = -8.5;
     const double stuck_threshold = 1.0;
@@ -410,13 +431,13 @@ void enemies_update_roi_with_map(double dt, double camera_x, double camera_y, in
     int map_height = map_get_map_height();
     
     // Calculate ROI (Region of Interest) - 2x buffer size around camera
-    double roi_left = camera_x - buffer_width;
-    double roi_right = camera_x + buffer_width * 2;
-    double roi_top = camera_y - buffer_height;
-    double roi_bottom = camera_y + buffer_height * 2;
+    double roi_left = world->camera_x - world->view_width;
+    double roi_right = world->camera_x + world->view_width * 2;
+    double roi_top = world->camera_y - world->view_height;
+    double roi_bottom = world->camera_y + world->view_height * 2;
 
     for (int i = 0; i < MAX_ENEMIES; i++) {
-        Enemy* e = &enemies[i];
+        Enemy* e = &world->enemies[i];
         if (!e->alive) continue;
         
         // Skip enemies outside ROI
@@ -425,7 +446,7 @@ void enemies_update_roi_with_map(double dt, double camera_x, double camera_y, in
         }
 
         // Get tank position for AI
-        double tank_x = get_tank_x();
+        double tank_x = world->tank.x;
         double dir = (tank_x > e->x) ? 1.0 : -1.0;
         
         // Set constant speed based on direction
@@ -439,6 +460,12 @@ void enemies_update_roi_with_map(double dt, double camera_x, double camera_y, in
         }
         // If vx == 0, keep previous facing direction
 
+        // Crowd separation: spread out instead of stacking on the same x
+        double sep_x, sep_y;
+        spatial_hash_separation(&world->spatial, SPATIAL_GROUND_ENEMY, i, e->x + e->width * 0.5, e->y + e->height * 0.5,
+                                ENEMY_SEPARATION_RADIUS, &sep_x, &sep_y);
+        e->vx += sep_x * ENEMY_SEPARATION_STRENGTH;
+
         e->vy += gravity;
 
         // Fixed interval jump logic
@@ -448,7 +475,7 @@ void enemies_update_roi_with_map(double dt, double camera_x, double camera_y, in
                 e->vy = jump_power;
                 e->on_ground = false;
                 // Reset timer with fixed interval from config
-                e->jump_timer = enemy_jump_interval_min + (rand() % (int)((enemy_jump_interval_max - enemy_jump_interval_min) * 10)) / 10.0;
+                e->jump_timer = random_jump_timer(&e->rng);
             } else {
                 e->jump_timer -= dt;
             }
@@ -529,7 +556,7 @@ void enemies_update_roi_with_map(double dt, double camera_x, double camera_y, in
     }
 }
 
-void enemies_update_with_map(double dt, const Map* map) {
+void enemies_update_with_map(World* world, double dt, const Map* map) {
     const double gravity = 0.5;
     const double jump_power = -8.5;
     const double stuck_threshold = 1.0;
@@ -538,11 +565,11 @@ void enemies_update_with_map(double dt, const Map* map) {
     int map_height = map_get_map_height();
 
     for (int i = 0; i < MAX_ENEMIES; i++) {
-        Enemy* e = &enemies[i];
+        Enemy* e = &world->enemies[i];
         if (!e->alive) continue;
 
         // Get tank position for AI
-        double tank_x = get_tank_x();
+        double tank_x = world->tank.x;
         double dir = (tank_x > e->x) ? 1.0 : -1.0;
         
         // Set constant speed based on direction
@@ -556,6 +583,12 @@ void enemies_update_with_map(double dt, const Map* map) {
         }
         // If vx == 0, keep previous facing direction
 
+        // Crowd separation: spread out instead of stacking on the same x
+        double sep_x, sep_y;
+        spatial_hash_separation(&world->spatial, SPATIAL_GROUND_ENEMY, i, e->x + e->width * 0.5, e->y + e->height * 0.5,
+                                ENEMY_SEPARATION_RADIUS, &sep_x, &sep_y);
+        e->vx += sep_x * ENEMY_SEPARATION_STRENGTH;
+
         e->vy += gravity;
 
         // Fixed interval jump logic
@@ -565,7 +598,7 @@ void enemies_update_with_map(double dt, const Map* map) {
                 e->vy = jump_power;
                 e->on_ground = false;
                 // Reset timer with fixed interval from config
-                e->jump_timer = enemy_jump_interval_min + (rand() % (int)((enemy_jump_interval_max - enemy_jump_interval_min) * 10)) / 10.0;
+                e->jump_timer = random_jump_timer(&e->rng);
             } else {
                 e->jump_timer -= dt;
             }
@@ -646,24 +679,26 @@ void enemies_update_with_map(double dt, const Map* map) {
     }
 }
 
-void enemies_update(double dt) {
-    enemies_update_with_map(dt, NULL);
+void enemies_update(World* world, double dt) {
+    enemies_update_with_map(world, dt, NULL);
 }
 
-void flying_enemies_update_roi(double dt, double camera_x, double camera_y, int buffer_width, int buffer_height) {
+void flying_enemies_update_roi(World* world, double dt) {
     int map_width = map_get_map_width();
     int map_height = map_get_map_height();
+    FlyOscillatorStep step = flying_enemy_oscillator_step(dt);
+    const EnemyArchetype* heli = &world->tuning->archetypes[ENEMY_TYPE_HELICOPTER];
     
     // Calculate ROI (Region of Interest) - symmetric around camera with configurable multiplier
-    double roi_half_width = buffer_width * roi_multiplier;
-    double roi_half_height = buffer_height * roi_multiplier;
-    double roi_left = camera_x - roi_half_width;
-    double roi_right = camera_x + roi_half_width;
-    double roi_top = camera_y - roi_half_height;
-    double roi_bottom = camera_y + roi_half_height;
+    double roi_half_width = world->view_width * roi_multiplier;
+    double roi_half_height = world->view_height * roi_multiplier;
+    double roi_left = world->camera_x - roi_half_width;
+    double roi_right = world->camera_x + roi_half_width;
+    double roi_top = world->camera_y - roi_half_height;
+    double roi_bottom = world->camera_y + roi_half_height;
 
     for (int i = 0; i < MAX_FLY_ENEMIES; i++) {
-        FlyingEnemy* fe = &f_enemies[i];
+        FlyingEnemy* fe = &world->flying_enemies[i];
         if (!fe->alive) continue;
         
         // Skip enemies outside ROI
@@ -671,26 +706,9 @@ void flying_enemies_update_roi(double dt, double camera_x, double camera_y, int
             continue;
         }
 
-        // Y-axis: maintain existing trigonometric movement (up-down oscillation)
-        fe->angle += dt * 2.0;
-        fe->y = fe->base_y + sin(fe->angle) * 30.0;
-        
-        // X-axis: left-right movement based on trigonometry centered on spawn position
-        fe->x_angle += dt * 1.5;  // x-axis movement speed (adjustable)
-        double x_offset = sin(fe->x_angle) * 150.0;  // ±150 pixel range from spawn position (adjustable)
-        double old_x = fe->x;
-        fe->x = fe->spawn_x + x_offset;
-        
-        // Calculate velocity for direction tracking
-        fe->vx = (fe->x - old_x) / dt;  // Approximate velocity
-        
-        // Update facing direction based on velocity
-        if (fe->vx > 0) {
-            fe->facing_right = true;
-        } else if (fe->vx < 0) {
-            fe->facing_right = false;
-        }
-        // If vx == 0, keep previous facing direction
+        flying_enemy_separate(world, fe, i, dt, map_width, map_height);
+
+        flying_enemy_fly(fe, &step);
 
         // 맵 경계 체크 (삼각함수 기반이므로 bounce 대신 경계 제한)
         if (fe->x < 0) { 
@@ -712,47 +730,14 @@ void flying_enemies_update_roi(double dt, double camera_x, double camera_y, int
             fe->shot_timer -= dt;
 
             while (fe->shot_timer <= 0.0 && fe->burst_shots_left > 0) {
-                // Check distance to player before shooting
-                double tank_x = get_tank_x();
-                double tank_y = get_tank_y();
-                double dx = tank_x - fe->x;
-                double dy = tank_y - fe->y;
-                double distance_to_player = sqrt(dx * dx + dy * dy);
-                
-                // Only shoot if player is within shooting range
-                if (distance_to_player <= max_shooting_distance) {
-                    // Create enemy bullet - shoot towards player tank
-                    for (int j = 0; j < MAX_BULLETS; j++) {
-                        Bullet* bullets = get_bullets();
-                        if (bullets && !bullets[j].alive) {
-                            bullets[j].alive = true;
-                            bullets[j].x = fe->x + fe->width / 2.0;
-                            bullets[j].y = fe->y + fe->height / 2.0;
-                            bullets[j].weapon = 0;      // MG round
-                            bullets[j].from_enemy = true;
-                            bullets[j].width = flying_enemy_bullet_width;
-                            bullets[j].height = flying_enemy_bullet_height;
-                            
-                            // Calculate bullet direction towards player tank
-                            double ang = atan2(dy, dx);
-                            
-                            // Set bullet angle for visual orientation
-                            bullets[j].angle = ang;
-
-                            // Set bullet velocity
-                            bullets[j].vx = cos(ang) * flying_enemy_bullet_speed;
-                            bullets[j].vy = sin(ang) * flying_enemy_bullet_speed;
-                            break;
-                        }
-                    }
-                }
+                flying_enemy_fire_at_tank(world, fe);
 
                 fe->burst_shots_left--;
-                fe->shot_timer += flying_enemy_shot_interval;
+                fe->shot_timer += fe->shot_interval;
 
                 if (fe->burst_shots_left <= 0) {
                     fe->in_burst = false;
-                    fe->rest_timer = flying_enemy_rest_time;
+                    fe->rest_timer = heli->rest_time;
                 }
             }
         }
@@ -760,41 +745,26 @@ void flying_enemies_update_roi(double dt, double camera_x, double camera_y, int
             fe->rest_timer -= dt;
             if (fe->rest_timer <= 0.0) {
                 fe->in_burst = true;
-                fe->burst_shots_left = flying_enemy_burst_count;
+                fe->burst_shots_left = heli->burst_count;
                 fe->shot_timer = 0.0; // fire immediately
             }
         }
     }
 }
 
-void flying_enemies_update(double dt) {
+void flying_enemies_update(World* world, double dt) {
     int map_width = map_get_map_width();
     int map_height = map_get_map_height();
+    FlyOscillatorStep step = flying_enemy_oscillator_step(dt);
+    const EnemyArchetype* heli = &world->tuning->archetypes[ENEMY_TYPE_HELICOPTER];
 
     for (int i = 0; i < MAX_FLY_ENEMIES; i++) {
-        FlyingEnemy* fe = &f_enemies[i];
+        FlyingEnemy* fe = &world->flying_enemies[i];
         if (!fe->alive) continue;
 
-        // Y-axis: maintain existing trigonometric movement (up-down oscillation)
-        fe->angle += dt * 2.0;
-        fe->y = fe->base_y + sin(fe->angle) * 30.0;
-        
-        // X-axis: left-right movement based on trigonometry centered on spawn position
-        fe->x_angle += dt * 1.5;  // x-axis movement speed (adjustable)
-        double x_offset = sin(fe->x_angle) * 150.0;  // ±150 pixel range from spawn position (adjustable)
-        double old_x = fe->x;
-        fe->x = fe->spawn_x + x_offset;
-        
-        // Calculate velocity for direction tracking
-        fe->vx = (fe->x - old_x) / dt;  // Approximate velocity
-        
-        // Update facing direction based on velocity
-        if (fe->vx > 0) {
-            fe->facing_right = true;
-        } else if (fe->vx < 0) {
-            fe->facing_right = false;
-        }
-        // If vx == 0, keep previous facing direction
+        flying_enemy_separate(world, fe, i, dt, map_width, map_height);
+
+        flying_enemy_fly(fe, &step);
 
         // 맵 경계 체크 (삼각함수 기반이므로 bounce 대신 경계 제한)
         if (fe->x < 0) { 
@@ -816,47 +786,14 @@ void flying_enemies_update(double dt) {
             fe->shot_timer -= dt;
 
             while (fe->shot_timer <= 0.0 && fe->burst_shots_left > 0) {
-                // Check distance to player before shooting
-                double tank_x = get_tank_x();
-                double tank_y = get_tank_y();
-                double dx = tank_x - fe->x;
-                double dy = tank_y - fe->y;
-                double distance_to_player = sqrt(dx * dx + dy * dy);
-                
-                // Only shoot if player is within shooting range
-                if (distance_to_player <= max_shooting_distance) {
-                    // Create enemy bullet - shoot towards player tank
-                    for (int j = 0; j < MAX_BULLETS; j++) {
-                        Bullet* bullets = get_bullets();
-                        if (bullets && !bullets[j].alive) {
-                            bullets[j].alive = true;
-                            bullets[j].x = fe->x + fe->width / 2.0;
-                            bullets[j].y = fe->y + fe->height / 2.0;
-                            bullets[j].weapon = 0;      // MG round
-                            bullets[j].from_enemy = true;
-                            bullets[j].width = flying_enemy_bullet_width;
-                            bullets[j].height = flying_enemy_bullet_height;
-                            
-                            // Calculate bullet direction towards player tank
-                            double ang = atan2(dy, dx);
-                            
-                            // Set bullet angle for visual orientation
-                            bullets[j].angle = ang;
-
-                            // Set bullet velocity
-                            bullets[j].vx = cos(ang) * flying_enemy_bullet_speed;
-                            bullets[j].vy = sin(ang) * flying_enemy_bullet_speed;
-                            break;
-                        }
-                    }
-                }
+                flying_enemy_fire_at_tank(world, fe);
 
                 fe->burst_shots_left--;
-                fe->shot_timer += flying_enemy_shot_interval;
+                fe->shot_timer += fe->shot_interval;
 
                 if (fe->burst_shots_left <= 0) {
                     fe->in_burst = false;
-                    fe->rest_timer = flying_enemy_rest_time;
+                    fe->rest_timer = heli->rest_time;
                 }
             }
         }
@@ -864,165 +801,187 @@ void flying_enemies_update(double dt) {
             fe->rest_timer -= dt;
             if (fe->rest_timer <= 0.0) {
                 fe->in_burst = true;
-                fe->burst_shots_left = flying_enemy_burst_count;
+                fe->burst_shots_left = heli->burst_count;
                 fe->shot_timer = 0.0; // fire immediately
             }
         }
     }
 }
 
-// ===== Enemy Rendering =====
+// ===== Render Interpolation =====
+
+// Remember positions at the start of a tick for render interpolation
+void enemies_store_previous(World* world) {
+    Enemy* enemies = world->enemies;
+    FlyingEnemy* f_enemies = world->flying_enemies;
 
-void enemies_draw(double camera_x, double camera_y) {
     for (int i = 0; i < MAX_ENEMIES; i++) {
-        Enemy* e = &enemies[i];
-        if (!e->alive) continue;
-        
-        // Convert world coordinates to screen coordinates
-        double sx = e->x - camera_x;
-        double sy = e->y - camera_y;
-        
-        // Draw enemy (basic rectangle for now)
-        // al_draw_filled_rectangle(sx, sy, sx + e->width, sy + e->height, al_map_rgb(200, 50, 50));
-        
-        // draw enemy sprite with flip based on movement direction
-        int width = al_get_bitmap_width(enemy_sprites.land_enemy_sprites[e->difficulty-1]);
-        int height = al_get_bitmap_height(enemy_sprites.land_enemy_sprites[e->difficulty-1]);
-        
-        // Determine flip flags based on facing direction
-        int flip_flags = 0;
-        if (e->facing_right) {
-            flip_flags = ALLEGRO_FLIP_HORIZONTAL; // Flip horizontally when facing right
-        }
-        
-        al_draw_scaled_bitmap(enemy_sprites.land_enemy_sprites[e->difficulty-1],
-            0, 0,
-            width, height,
-            e->x - camera_x, e->y - camera_y,
-            e->width, e->height,
-            flip_flags);
-
-        // HP bar would be drawn by HUD system
+        enemies[i].prev_x = enemies[i].x;
+        enemies[i].prev_y = enemies[i].y;
     }
-}
-
-void flying_enemies_draw(double camera_x, double camera_y) {
     for (int i = 0; i < MAX_FLY_ENEMIES; i++) {
-        FlyingEnemy* fe = &f_enemies[i];
-        if (!fe->alive) continue;
-
-
-        // Convert world coordinates to screen coordinates
-        // al_draw_filled_rectangle(fe->x - camera_x, fe->y - camera_y, 
-        //     fe->x - camera_x + fe->width, fe->y - camera_y + fe->height, 
-        //     al_map_rgb(180, 0, 180));
-
-        int width = al_get_bitmap_width(enemy_sprites.flying_enemy_sprites[fe->difficulty-1]);
-        int height = al_get_bitmap_height(enemy_sprites.flying_enemy_sprites[fe->difficulty-1]);
-        
-        // Determine flip flags based on facing direction
-        int flip_flags = 0;
-        if (fe->facing_right) {
-            flip_flags = ALLEGRO_FLIP_HORIZONTAL; // Flip horizontally when facing right
-        }
-        
-        al_draw_scaled_bitmap(enemy_sprites.flying_enemy_sprites[fe->difficulty-1],
-            0, 0,
-            width, height,
-            fe->x - camera_x, fe->y - camera_y,
-            fe->width, fe->height,
-            flip_flags);
+        f_enemies[i].prev_x = f_enemies[i].x;
+        f_enemies[i].prev_y = f_enemies[i].y;
     }
 }
 
 // ===== Enemy Utilities =====
 
-bool any_ground_enemies_alive(void) {
+bool any_ground_enemies_alive(const World* world) {
     for (int i = 0; i < MAX_ENEMIES; ++i)
-        if (enemies[i].alive) return true;
+        if (world->enemies[i].alive) return true;
     return false;
 }
 
-bool any_flying_enemies_alive(void) {
+bool any_flying_enemies_alive(const World* world) {
     for (int i = 0; i < MAX_FLY_ENEMIES; ++i)
-        if (f_enemies[i].alive) return true;
+        if (world->flying_enemies[i].alive) return true;
     return false;
 }
 
-int get_alive_enemy_count(void) {
+int get_alive_enemy_count(const World* world) {
     int count = 0;
     for (int i = 0; i < MAX_ENEMIES; i++) {
-        if (enemies[i].alive) count++;
+        if (world->enemies[i].alive) count++;
     }
     return count;
 }
 
-int get_alive_flying_enemy_count(void) {
+int get_alive_flying_enemy_count(const World* world) {
     int count = 0;
     for (int i = 0; i < MAX_FLY_ENEMIES; i++) {
-        if (f_enemies[i].alive) count++;
+        if (world->flying_enemies[i].alive) count++;
     }
     return count;
 }
 
 // ===== Enemy Damage and Effects =====
 
-void damage_enemy(Enemy* enemy, int damage) {
+void damage_enemy(World* world, Enemy* enemy, int damage) {
     if (!enemy || !enemy->alive) return;
     
+    double cx = enemy->x + enemy->width * 0.5;
+    double cy = enemy->y + enemy->height * 0.5;
     enemy->hp -= damage;
+    game_event_emit(world, GAME_EVENT_ENEMY_DAMAGED, cx, cy, damage);
     if (enemy->hp <= 0) {
         enemy->alive = false;
         // Add score based on difficulty when enemy is killed
-        add_score_for_enemy_kill(enemy->difficulty);
+        add_score_for_enemy_kill(world, enemy->difficulty);
+        game_event_emit(world, GAME_EVENT_ENEMY_KILLED, cx, cy, enemy->difficulty);
     }
 }
 
-void damage_flying_enemy(FlyingEnemy* fe, int damage) {
+void damage_flying_enemy(World* world, FlyingEnemy* fe, int damage) {
     if (!fe || !fe->alive) return;
     
+    double cx = fe->x + fe->width * 0.5;
+    double cy = fe->y + fe->height * 0.5;
     fe->hp -= damage;
+    game_event_emit(world, GAME_EVENT_ENEMY_DAMAGED, cx, cy, damage);
     if (fe->hp <= 0) {
         fe->alive = false;
         // Add score based on difficulty when flying enemy is killed
-        add_score_for_enemy_kill(fe->difficulty);
+        add_score_for_enemy_kill(world, fe->difficulty);
+        game_event_emit(world, GAME_EVENT_ENEMY_KILLED, cx, cy, fe->difficulty);
     }
 }
 
-void apply_cannon_explosion(double ex, double ey, double radius) {
-    // ground enemies
-    for (int i = 0; i < MAX_ENEMIES; ++i) {
-        Enemy* e = &enemies[i];
-        if (!e->alive) continue;
-        double cx = e->x + e->width * 0.5;
-        double cy = e->y + e->height * 0.5;
-        double dx = cx - ex, dy = cy - ey;
-        double dist = sqrt(dx * dx + dy * dy);
-        int dmg = (int)(DMG_CANNON * (1.0 - (dist / radius)));
-        if (dmg > 0) {
-            damage_enemy(e, dmg);
-            if (e->alive && dist < 1.0) dist = 1.0;
-            if (e->alive && dist < radius) {
-                double nx = dx / dist, ny = dy / dist;
-                e->vx += nx * CANNON_SPLASH_KB;
-                e->vy -= fabs(ny) * KNOCKBACK_ENEMY_VY;
-            }
-        }
+// Splash damage and knockback accumulated over every explosion in a batch,
+// so each enemy is damaged once and only enemies near an impact are touched
+typedef struct {
+    const World* world;
+    double ex, ey;
+    double radius, radius_sq;
+
+    int ground_dmg[MAX_ENEMIES];
+    double ground_kb_vx[MAX_ENEMIES];
+    double ground_kb_vy[MAX_ENEMIES];
+    int ground_touched[MAX_ENEMIES];
+    int ground_touched_count;
+
+    int fly_dmg[MAX_FLY_ENEMIES];
+    int fly_touched[MAX_FLY_ENEMIES];
+    int fly_touched_count;
+} SplashBatch;
+
+static void splash_visit(const SpatialEntry* entry, void* user) {
+    SplashBatch* batch = (SplashBatch*)user;
+    double cx, cy;
+
+    if (entry->type == SPATIAL_GROUND_ENEMY) {
+        const Enemy* e = &batch->world->enemies[entry->index];
+        if (!e->alive) return;
+        cx = e->x + e->width * 0.5;
+        cy = e->y + e->height * 0.5;
+    } else {
+        const FlyingEnemy* fe = &batch->world->flying_enemies[entry->index];
+        if (!fe->alive) return;
+        cx = fe->x + fe->width * 0.5;
+        cy = fe->y + fe->height * 0.5;
     }
 
-    // flying enemies: apply damage only
-    for (int i = 0; i < MAX_FLY_ENEMIES; ++i) {
-        FlyingEnemy* fe = &f_enemies[i];
-        if (!fe->alive) continue;
-        double cx = fe->x + fe->width * 0.5;
-        double cy = fe->y + fe->height * 0.5;
-        double dx = cx - ex, dy = cy - ey;
-        double dist = sqrt(dx * dx + dy * dy);
-        int dmg = (int)(DMG_CANNON * (1.0 - (dist / radius)));
-        if (dmg > 0) {
-            damage_flying_enemy(fe, dmg);
+    double dx = cx - batch->ex, dy = cy - batch->ey;
+    double dist_sq = dx * dx + dy * dy;
+    if (dist_sq >= batch->radius_sq) return;  // outside splash, no sqrt
+
+    double dist = sqrt(dist_sq);
+    int dmg = (int)(DMG_CANNON * (1.0 - (dist / batch->radius)));
+    if (dmg <= 0) return;
+
+    if (entry->type == SPATIAL_GROUND_ENEMY) {
+        int i = entry->index;
+        if (batch->ground_dmg[i] == 0) batch->ground_touched[batch->ground_touched_count++] = i;
+        batch->ground_dmg[i] += dmg;
+
+        if (dist < 1.0) dist = 1.0;
+        double nx = dx / dist, ny = dy / dist;
+        batch->ground_kb_vx[i] += nx * CANNON_SPLASH_KB;
+        batch->ground_kb_vy[i] += fabs(ny) * KNOCKBACK_ENEMY_VY;
+    } else {
+        // flying enemies: apply damage only
+        int i = entry->index;
+        if (batch->fly_dmg[i] == 0) batch->fly_touched[batch->fly_touched_count++] = i;
+        batch->fly_dmg[i] += dmg;
+    }
+}
+
+void apply_cannon_explosions(World* world, const CannonExplosion* explosions, int count, double radius) {
+    if (!explosions || count <= 0 || radius <= 0.0) return;
+
+    SplashBatch batch;
+    memset(&batch, 0, sizeof(batch));
+    batch.world = world;
+    batch.radius = radius;
+    batch.radius_sq = radius * radius;
+
+    for (int k = 0; k < count; k++) {
+        batch.ex = explosions[k].x;
+        batch.ey = explosions[k].y;
+        game_event_emit(world, GAME_EVENT_CANNON_EXPLODED, batch.ex, batch.ey, (int)radius);
+        spatial_hash_query_radius(&world->spatial, batch.ex, batch.ey, radius, splash_visit, &batch);
+    }
+
+    // ground enemies: damage, then knockback if they survived
+    for (int t = 0; t < batch.ground_touched_count; t++) {
+        int i = batch.ground_touched[t];
+        Enemy* e = &world->enemies[i];
+        damage_enemy(world, e, batch.ground_dmg[i]);
+        if (e->alive) {
+            e->vx += batch.ground_kb_vx[i];
+            e->vy -= batch.ground_kb_vy[i];
         }
     }
+
+    for (int t = 0; t < batch.fly_touched_count; t++) {
+        int i = batch.fly_touched[t];
+        damage_flying_enemy(world, &world->flying_enemies[i], batch.fly_dmg[i]);
+    }
+}
+
+void apply_cannon_explosion(World* world, double ex, double ey, double radius) {
+    CannonExplosion explosion = { ex, ey };
+    apply_cannon_explosions(world, &explosion, 1, radius);
 }
 
 // ===== Enemy Movement Helpers =====
@@ -1072,27 +1031,3 @@ void handle_enemy_stuck_jump(Enemy* enemy, double dt) {
         enemy->stuck_time = 0.0;
     }
 }
-// ===== Getter functions for external access =====
-
-Enemy* get_enemies(void) {
-    return enemies;
-}
-
-FlyingEnemy* get_flying_enemies(void) {
-    return f_enemies;
-}
-
-void flying_enemy_sprites_deinit()
-{
-    al_destroy_bitmap(enemy_sprites.land_enemy_sheet);
-    al_destroy_bitmap(enemy_sprites.flying_enemy_sheet);
-
-    al_destroy_bitmap(enemy_sprites.land_enemy_sprites[0]);
-    al_destroy_bitmap(enemy_sprites.land_enemy_sprites[1]);
-    al_destroy_bitmap(enemy_sprites.land_enemy_sprites[2]);
-
-    al_destroy_bitmap(enemy_sprites.flying_enemy_sprites[0]);
-    al_destroy_bitmap(enemy_sprites.flying_enemy_sprites[1]);
-    al_destroy_bitmap(enemy_sprites.flying_enemy_sprites[2]);
-
-}
\ No newline at end of file
@@ -1,16 +1,17 @@
 #ifndef ENEMY_H
 #define ENEMY_H
 
-#include <allegro5/allegro5.h>
-#include <allegro5/allegro_primitives.h>
 #include <stdbool.h>
 #include "map_generation.h"
 #include "bullet.h"
+#include "rng.h"
 
-
+struct World;  // world.h (owns the enemy pools)
 
 // ===== Constants =====
-#define MAX_ENEMIES 20
+#ifndef MAX_ENEMIES
+#define MAX_ENEMIES 20  // STRESS=1 ./build_headless.sh raises it for --stress
+#endif
 #define MAX_FLY_ENEMIES 10
 #define MAX_BULLETS 100
 
@@ -39,6 +40,10 @@ extern double max_shooting_distance;
 #define FLY_BASE_HP 12
 #define FLY_HP_PER_ROUND 3
 
+// Difficulty levels placed by the stage files (1..3, one sprite each)
+#define ENEMY_DIFFICULTY_LEVELS 3
+#define ENEMY_HP_PER_DIFFICULTY 40
+
 #define DMG_MG 4
 #define DMG_CANNON 200
 #define DMG_ENEMY_CONTACT 10
@@ -49,15 +54,51 @@ extern double max_shooting_distance;
 #define KNOCKBACK_ENEMY_VX 4.5
 #define KNOCKBACK_ENEMY_VY 3.5
 
+// Crowd separation (neighbours found through the spatial hash)
+#define ENEMY_SEPARATION_RADIUS   40.0   // px between ground enemy centers
+#define ENEMY_SEPARATION_STRENGTH 1.5    // max extra px/tick from neighbours
+#define FLY_SEPARATION_RADIUS     120.0  // px between helicopter centers
+#define FLY_SEPARATION_SPEED      60.0   // max px/s drift of the patrol anchor
+
+// Helicopter flight path (bob / patrol shape)
+#define FLY_BOB_AMPLITUDE 30.0      // ±30 pixel up-down
+#define FLY_BOB_RATE 2.0            // rad/s
+#define FLY_PATROL_AMPLITUDE 150.0  // ±150 pixel range from spawn position
+#define FLY_PATROL_RATE 1.5         // rad/s
+
 // Cannon splash radius & knockback
 #define CANNON_SPLASH_RADIUS 90.0
 #define CANNON_SPLASH_KB     6.0
 
 // ===== Data Types =====
 
+// Enemy types placed by enemies*.csv (enemy_type column)
+typedef enum {
+    ENEMY_TYPE_TANK,
+    ENEMY_TYPE_HELICOPTER,
+    ENEMY_TYPE_COUNT,
+    ENEMY_TYPE_UNKNOWN = -1
+} EnemyType;
+
+// Per-type tuning, read from config.ini once at startup
+typedef struct {
+    const char* name;            // enemy_type string used in the stage CSV
+    int width, height;
+    int base_hp;
+    int hp_per_difficulty;
+    double base_speed;
+    double speed_per_difficulty;
+
+    // Burst fire (helicopter only)
+    int burst_count;
+    double shot_interval;
+    double rest_time;
+} EnemyArchetype;
+
 // Ground enemy: chases player; jumps if stuck ~2s
 typedef struct {
     double x, y, vx, vy;
+    double prev_x, prev_y;   // Position at the start of the last tick (render interpolation)
     bool alive;
     bool on_ground;
 
@@ -78,15 +119,27 @@ typedef struct {
     
     // Direction tracking for sprite flipping
     bool facing_right;  // true = right, false = left
+
+    // Sprite slot in enemy_sprites (by difficulty)
+    int sprite_index;
+
+    // Spawn serial and the random stream derived from it
+    unsigned int id;
+    Rng rng;
 } Enemy;
 
 // Flying enemy: sine flight, burst fire (10 shots in ~0.5s) then rest
 typedef struct {
     double x, y, vx;
+    double prev_x, prev_y;   // Position at the start of the last tick (render interpolation)
     double base_y;
     double spawn_x;  // 스폰 위치 x좌표 저장
-    double angle;
-    double x_angle;  // x축 움직임용 각도
+
+    // Oscillator phases kept as unit phasors (sin, cos) and advanced by a
+    // rotation recurrence each tick instead of calling sin() per enemy
+    double y_sin, y_cos;  // up-down bob phase
+    double x_sin, x_cos;  // x축 움직임 phase
+    int osc_steps;        // steps since last renormalization
     bool alive;
 
     bool in_burst;
@@ -106,66 +159,89 @@ typedef struct {
     
     // Difficulty for scoring
     int difficulty;
+
+    // Sprite slot in enemy_sprites (by difficulty)
+    int sprite_index;
+
+    // Spawn serial and the random stream derived from it
+    unsigned int id;
+    Rng rng;
 } FlyingEnemy;
 
 
-typedef struct _enemy_sprites
-{
-    ALLEGRO_BITMAP* land_enemy_sheet;
-    ALLEGRO_BITMAP* flying_enemy_sheet;
+// Balance values a world plays with: the archetypes and the ready-to-spawn
+// templates built from them. The default set is read from config.ini; batch
+// sweeps copy it, change archetype values and call enemy_tuning_build
+typedef struct {
+    EnemyArchetype archetypes[ENEMY_TYPE_COUNT];
+    double splash_radius;   // Cannon splash radius (CANNON_SPLASH_RADIUS by default)
+
+    // Per difficulty, index 1..ENEMY_DIFFICULTY_LEVELS
+    Enemy ground_templates[ENEMY_DIFFICULTY_LEVELS + 1];
+    FlyingEnemy flying_templates[ENEMY_DIFFICULTY_LEVELS + 1];
+} EnemyTuning;
+
+
+// Per-tick rotation (cos, sin) shared by every helicopter for one dt
+typedef struct {
+    double y_cos, y_sin;
+    double x_cos, x_sin;
+} FlyOscillatorStep;
+
+
+// Cannon impact queued for a batched splash pass
+typedef struct {
+    double x, y;
+} CannonExplosion;
 
-    ALLEGRO_BITMAP** land_enemy_sprites;
-    ALLEGRO_BITMAP** flying_enemy_sprites;
-} enemy_sprites_t;
 
 // ===== Function Declarations =====
 
 // Enemy initialization and management
-void enemies_init(void);
-void flying_enemies_init(void);
+void enemy_archetypes_init(void);
+const EnemyArchetype* enemy_get_archetype(EnemyType type);
+const EnemyTuning* enemy_default_tuning(void);
+void enemy_tuning_build(EnemyTuning* tuning);   // Rebuild the templates from the archetypes
+EnemyType enemy_type_from_string(const char* name);
+void enemies_init(struct World* world);
+void flying_enemies_init(struct World* world);
 
 // Enemy spawning
-void load_enemies_from_csv(int stage_number);
-void load_enemies_from_csv_with_map(int stage_number, const Map* map);
-void spawn_enemies(int round_number);
-void spawn_flying_enemy(int round_number);
-
-// Enemy updates
-void enemies_update(double dt);
-void enemies_update_with_map(double dt, const Map* map);
-void flying_enemies_update(double dt);
-void enemies_update_roi(double dt, double camera_x, double camera_y, int buffer_width, int buffer_height);
-void enemies_update_roi_with_map(double dt, double camera_x, double camera_y, int buffer_width, int buffer_height, const Map* map);
-void flying_enemies_update_roi(double dt, double camera_x, double camera_y, int buffer_width, int buffer_height);
-
-// Enemy rendering
-void enemies_draw(double camera_x, double camera_y);
-void flying_enemies_draw(double camera_x, double camera_y);
+bool enemy_spawn(struct World* world, EnemyType type, int difficulty, double x, double y);
+void spawn_enemies(struct World* world, int round_number);
+void spawn_flying_enemy(struct World* world, int round_number);
+
+// Enemy updates (the ROI variants only move enemies near the world camera)
+void enemies_update(struct World* world, double dt);
+void enemies_update_with_map(struct World* world, double dt, const Map* map);
+void flying_enemies_update(struct World* world, double dt);
+void enemies_update_roi(struct World* world, double dt);
+void flying_enemies_update_roi(struct World* world, double dt);
+
+// Helicopter flight: one step per update pass, then flying_enemy_fly per helicopter
+// moves it along its path (position, vx, facing; no bounds or firing)
+FlyOscillatorStep flying_enemy_oscillator_step(double dt);
+void flying_enemy_reset_oscillators(FlyingEnemy* fe);
+void flying_enemy_fly(FlyingEnemy* fe, const FlyOscillatorStep* step);
+
+// Render interpolation
+void enemies_store_previous(struct World* world);
 
 // Enemy utilities
-bool any_ground_enemies_alive(void);
-bool any_flying_enemies_alive(void);
-int get_alive_enemy_count(void);
-int get_alive_flying_enemy_count(void);
+bool any_ground_enemies_alive(const struct World* world);
+bool any_flying_enemies_alive(const struct World* world);
+int get_alive_enemy_count(const struct World* world);
+int get_alive_flying_enemy_count(const struct World* world);
 
 // Enemy damage and effects
-void damage_enemy(Enemy* enemy, int damage);
-void damage_flying_enemy(FlyingEnemy* fe, int damage);
-void apply_cannon_explosion(double ex, double ey, double radius);
+void damage_enemy(struct World* world, Enemy* enemy, int damage);
+void damage_flying_enemy(struct World* world, FlyingEnemy* fe, int damage);
+void apply_cannon_explosion(struct World* world, double ex, double ey, double radius);
+void apply_cannon_explosions(struct World* world, const CannonExplosion* explosions, int count, double radius);
 
 // Enemy movement helpers
 double get_enemy_ground_y(double x);
 void handle_enemy_stuck_jump(Enemy* enemy, double dt);
 
-// Getter functions for external access
-Enemy* get_enemies(void);
-FlyingEnemy* get_flying_enemies(void);
-
-//sprite
-void flying_enemy_sprites_init();
-void enemy_sprites_init();
-//void must_init(bool test, const char* description);
-void flying_enemy_sprites_deinit();
-
 #endif // ENEMY_H
 
@@ -0,0 +1,113 @@
+#include "enemy_render.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// sprite
+
+enemy_sprites_t enemy_sprites;
+
+
+void enemy_sprites_init() {
+    const EnemyArchetype* tank = enemy_get_archetype(ENEMY_TYPE_TANK);
+
+    for (int i = 0; i < ENEMY_SPRITE_COUNT; i++) {
+        char enemy_sprite_file_path[256];
+        snprintf(enemy_sprite_file_path, sizeof(enemy_sprite_file_path), "TankBoy/resources/sprites/enemy%d.png", i+1);
+        ALLEGRO_BITMAP* sheet = al_load_bitmap(enemy_sprite_file_path);
+        if (sheet == NULL) {
+            printf("wrong location of enemy sprite!!\n");
+        }
+
+        if (sprite_atlas_add(&enemy_sprites.land_enemy_sprites[i], sheet, 0, 0,
+                sheet ? al_get_bitmap_width(sheet) : 0, sheet ? al_get_bitmap_height(sheet) : 0,
+                tank->width, tank->height)) {
+            al_destroy_bitmap(sheet);
+            sheet = NULL;
+        }
+        enemy_sprites.land_enemy_sheets[i] = sheet;
+    }
+}
+
+
+void flying_enemy_sprites_init() {
+    const EnemyArchetype* heli = enemy_get_archetype(ENEMY_TYPE_HELICOPTER);
+
+    char* flying_enemy_sprite_file = "TankBoy/resources/sprites/helicopters.png";
+    enemy_sprites.flying_enemy_sheet = al_load_bitmap(flying_enemy_sprite_file);
+    if (enemy_sprites.flying_enemy_sheet == NULL) {
+        printf("wrong location of flying enemy sprite!!\n");
+        return;
+    }
+    
+    // Three frames side by side
+    int width = al_get_bitmap_width(enemy_sprites.flying_enemy_sheet) / ENEMY_SPRITE_COUNT;
+    int height = al_get_bitmap_height(enemy_sprites.flying_enemy_sheet);
+    bool all_in_atlas = true;
+    for (int i = 0; i < ENEMY_SPRITE_COUNT; i++) {
+        if (!sprite_atlas_add(&enemy_sprites.flying_enemy_sprites[i], enemy_sprites.flying_enemy_sheet,
+                i*width, 0, width, height, heli->width, heli->height)) {
+            all_in_atlas = false;
+        }
+    }
+    if (all_in_atlas) {
+        al_destroy_bitmap(enemy_sprites.flying_enemy_sheet);
+        enemy_sprites.flying_enemy_sheet = NULL;
+    }
+}
+
+
+// ===== Enemy Rendering =====
+
+void enemies_draw(const Enemy* enemies, double camera_x, double camera_y, double alpha) {
+    // Every sprite is in the one atlas: let Allegro batch them into a single draw
+    al_hold_bitmap_drawing(true);
+    for (int i = 0; i < MAX_ENEMIES; i++) {
+        const Enemy* e = &enemies[i];
+        if (!e->alive) continue;
+        
+        // Convert interpolated world coordinates to screen coordinates
+        double sx = e->prev_x + (e->x - e->prev_x) * alpha - camera_x;
+        double sy = e->prev_y + (e->y - e->prev_y) * alpha - camera_y;
+        
+        // Draw enemy (basic rectangle for now)
+        // al_draw_filled_rectangle(sx, sy, sx + e->width, sy + e->height, al_map_rgb(200, 50, 50));
+        
+        // draw enemy sprite, mirrored when facing right
+        sprite_atlas_draw(&enemy_sprites.land_enemy_sprites[e->sprite_index], sx, sy, e->width, e->height, e->facing_right);
+
+        // HP bar would be drawn by HUD system
+    }
+    al_hold_bitmap_drawing(false);
+}
+
+void flying_enemies_draw(const FlyingEnemy* f_enemies, double camera_x, double camera_y, double alpha) {
+    al_hold_bitmap_drawing(true);
+    for (int i = 0; i < MAX_FLY_ENEMIES; i++) {
+        const FlyingEnemy* fe = &f_enemies[i];
+        if (!fe->alive) continue;
+
+        double sx = fe->prev_x + (fe->x - fe->prev_x) * alpha - camera_x;
+        double sy = fe->prev_y + (fe->y - fe->prev_y) * alpha - camera_y;
+
+
+        // Convert world coordinates to screen coordinates
+        // al_draw_filled_rectangle(fe->x - camera_x, fe->y - camera_y, 
+        //     fe->x - camera_x + fe->width, fe->y - camera_y + fe->height, 
+        //     al_map_rgb(180, 0, 180));
+
+        // Mirrored when facing right
+        sprite_atlas_draw(&enemy_sprites.flying_enemy_sprites[fe->sprite_index], sx, sy, fe->width, fe->height, fe->facing_right);
+    }
+    al_hold_bitmap_drawing(false);
+}
+
+void flying_enemy_sprites_deinit()
+{
+    // The atlas itself goes with sprite_atlas_free
+    for (int i = 0; i < ENEMY_SPRITE_COUNT; i++) {
+        if (enemy_sprites.land_enemy_sheets[i]) al_destroy_bitmap(enemy_sprites.land_enemy_sheets[i]);
+        enemy_sprites.land_enemy_sheets[i] = NULL;
+    }
+    if (enemy_sprites.flying_enemy_sheet) al_destroy_bitmap(enemy_sprites.flying_enemy_sheet);
+    enemy_sprites.flying_enemy_sheet = NULL;
+}
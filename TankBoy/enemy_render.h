@@ -0,0 +1,31 @@
+#ifndef ENEMY_RENDER_H
+#define ENEMY_RENDER_H
+
+#include <allegro5/allegro5.h>
+#include <allegro5/allegro_primitives.h>
+#include "enemy.h"
+#include "sprite_atlas.h"
+
+#define ENEMY_SPRITE_COUNT 3 // One look per difficulty level
+
+// Sprites are made at the archetype sizes (sprite_atlas.h); a source image is
+// only kept when its sprites did not fit in the atlas
+typedef struct _enemy_sprites
+{
+    ALLEGRO_BITMAP* land_enemy_sheets[ENEMY_SPRITE_COUNT];
+    ALLEGRO_BITMAP* flying_enemy_sheet;
+
+    AtlasSprite land_enemy_sprites[ENEMY_SPRITE_COUNT];
+    AtlasSprite flying_enemy_sprites[ENEMY_SPRITE_COUNT];
+} enemy_sprites_t;
+
+// Enemy rendering (kept apart from enemy.c so the simulation builds without Allegro)
+void enemies_draw(const Enemy* enemies, double camera_x, double camera_y, double alpha);
+void flying_enemies_draw(const FlyingEnemy* f_enemies, double camera_x, double camera_y, double alpha);
+
+//sprite
+void flying_enemy_sprites_init();
+void enemy_sprites_init();
+void flying_enemy_sprites_deinit();
+
+#endif // ENEMY_RENDER_H
@@ -0,0 +1,259 @@
+#include "enemy_waves.h"
+#include "world.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define WAVE_MAX_FIELDS 6
+
+// ===== Helpers =====
+
+static bool wave_queue_add(WaveQueue* queue, const EnemyWaveEntry* entry) {
+    if (queue->count >= queue->capacity) {
+        size_t new_capacity = queue->capacity ? queue->capacity * 2 : INITIAL_WAVE_CAPACITY;
+        EnemyWaveEntry* new_entries = realloc(queue->entries, new_capacity * sizeof(EnemyWaveEntry));
+        if (!new_entries) return false;
+
+        queue->entries = new_entries;
+        queue->capacity = new_capacity;
+    }
+
+    queue->entries[queue->count] = *entry;
+    queue->count++;
+    return true;
+}
+
+static void wave_queue_free(WaveQueue* queue) {
+    free(queue->entries);
+    queue->entries = NULL;
+    queue->count = 0;
+    queue->capacity = 0;
+    queue->head = 0;
+}
+
+static bool wave_queue_copy(WaveQueue* dst, const WaveQueue* src) {
+    if (dst->capacity < src->count) {
+        EnemyWaveEntry* new_entries = realloc(dst->entries, src->count * sizeof(EnemyWaveEntry));
+        if (!new_entries) return false;
+
+        dst->entries = new_entries;
+        dst->capacity = src->count;
+    }
+
+    if (src->count > 0) memcpy(dst->entries, src->entries, src->count * sizeof(EnemyWaveEntry));
+    dst->count = src->count;
+    dst->head = 0;
+    return true;
+}
+
+static int compare_spawn_time(const void* a, const void* b) {
+    const EnemyWaveEntry* ea = (const EnemyWaveEntry*)a;
+    const EnemyWaveEntry* eb = (const EnemyWaveEntry*)b;
+    if (ea->spawn_time < eb->spawn_time) return -1;
+    if (ea->spawn_time > eb->spawn_time) return 1;
+    return ea->order - eb->order;
+}
+
+static int compare_trigger_x(const void* a, const void* b) {
+    const EnemyWaveEntry* ea = (const EnemyWaveEntry*)a;
+    const EnemyWaveEntry* eb = (const EnemyWaveEntry*)b;
+    if (ea->trigger_x < eb->trigger_x) return -1;
+    if (ea->trigger_x > eb->trigger_x) return 1;
+    return ea->order - eb->order;
+}
+
+static int sleep_bucket(double x) {
+    return (int)floor(x / WAVE_SLEEP_BUCKET_WIDTH);
+}
+
+static int compare_sleep_x(const void* a, const void* b) {
+    const EnemyWaveEntry* ea = (const EnemyWaveEntry*)a;
+    const EnemyWaveEntry* eb = (const EnemyWaveEntry*)b;
+    if (ea->x < eb->x) return -1;
+    if (ea->x > eb->x) return 1;
+    return ea->order - eb->order;
+}
+
+// Release entries from the head while the slot pool has room
+static int release_due(World* world, WaveQueue* queue, bool by_position) {
+    int spawned = 0;
+    while (queue->head < queue->count) {
+        const EnemyWaveEntry* entry = &queue->entries[queue->head];
+        if (by_position ? (entry->trigger_x > world->tank.x) : (entry->spawn_time > world->waves.stage_clock)) break;
+
+        // No free slot: keep the entry at the head and retry next tick
+        if (!enemy_spawn(world, entry->type, entry->difficulty, entry->x, entry->y)) break;
+
+        queue->head++;
+        spawned++;
+    }
+    return spawned;
+}
+
+// Grow the awake window to cover every column touching [wake_left, wake_right]
+static int wake_sleepers(World* world, double wake_left, double wake_right) {
+    EnemyWaves* waves = &world->waves;
+    const EnemyWaveEntry* sleepers = waves->sleeper_queue.entries;
+    int left_bucket = sleep_bucket(wake_left);
+    int right_bucket = sleep_bucket(wake_right);
+    int spawned = 0;
+
+    if (!waves->wake_started) {
+        // First column at or right of the initial view (binary search)
+        size_t lo = 0, hi = waves->sleeper_queue.count;
+        while (lo < hi) {
+            size_t mid = (lo + hi) / 2;
+            if (sleep_bucket(sleepers[mid].x) < left_bucket) lo = mid + 1;
+            else hi = mid;
+        }
+        waves->wake_lo = waves->wake_hi = lo;
+        waves->wake_started = true;
+    }
+
+    // Leading edge moving right
+    while (waves->wake_hi < waves->sleeper_queue.count && sleep_bucket(sleepers[waves->wake_hi].x) <= right_bucket) {
+        const EnemyWaveEntry* entry = &sleepers[waves->wake_hi];
+        if (!enemy_spawn(world, entry->type, entry->difficulty, entry->x, entry->y)) return spawned;
+        waves->wake_hi++;
+        spawned++;
+    }
+
+    // Leading edge moving left
+    while (waves->wake_lo > 0 && sleep_bucket(sleepers[waves->wake_lo - 1].x) >= left_bucket) {
+        const EnemyWaveEntry* entry = &sleepers[waves->wake_lo - 1];
+        if (!enemy_spawn(world, entry->type, entry->difficulty, entry->x, entry->y)) return spawned;
+        waves->wake_lo--;
+        spawned++;
+    }
+    return spawned;
+}
+
+// ===== Load =====
+
+void enemy_waves_init(EnemyWaves* waves) {
+    memset(waves, 0, sizeof(*waves));
+}
+
+bool enemy_waves_load(EnemyWaves* waves, int stage_number) {
+    enemy_waves_free(waves);
+    waves->stage_clock = 0.0;
+
+    char csv_path[256];
+    snprintf(csv_path, sizeof(csv_path), "TankBoy/resources/stages/enemies%d.csv", stage_number);
+
+    FILE* file = fopen(csv_path, "r");
+    if (!file) {
+        printf("Warning: Could not open enemy CSV file: %s\n", csv_path);
+        return false;
+    }
+
+    char line[256];
+    bool first_line = true;
+    int order = 0;
+
+    while (fgets(line, sizeof(line), file)) {
+        // Skip header line
+        if (first_line) {
+            first_line = false;
+            continue;
+        }
+
+        line[strcspn(line, "\r\n")] = 0;
+        if (line[0] == 0) continue;
+
+        // Parse CSV line: x,y,enemy_type,difficulty[,spawn_time[,trigger_x]]
+        char* fields[WAVE_MAX_FIELDS];
+        int field_count = csv_split_fields(line, fields, WAVE_MAX_FIELDS);
+        if (field_count < 3) continue;
+
+        EnemyWaveEntry entry;
+        entry.x = atof(fields[0]);
+        entry.y = atof(fields[1]);
+        entry.type = enemy_type_from_string(fields[2]);
+        entry.difficulty = (field_count > 3 && fields[3][0]) ? atoi(fields[3]) : 1;
+        entry.spawn_time = (field_count > 4 && fields[4][0]) ? atof(fields[4]) : 0.0;
+        entry.trigger_x = (field_count > 5 && fields[5][0]) ? atof(fields[5]) : 0.0;
+        entry.order = order++;
+
+        if (entry.type == ENEMY_TYPE_UNKNOWN) {
+            printf("Warning: Unknown enemy type '%s' in %s\n", fields[2], csv_path);
+            continue;
+        }
+
+        if (entry.trigger_x > 0.0) wave_queue_add(&waves->trigger_queue, &entry);
+        else if (entry.spawn_time > 0.0) wave_queue_add(&waves->timed_queue, &entry);
+        else wave_queue_add(&waves->sleeper_queue, &entry);
+    }
+
+    fclose(file);
+
+    if (waves->timed_queue.count > 1)
+        qsort(waves->timed_queue.entries, waves->timed_queue.count, sizeof(EnemyWaveEntry), compare_spawn_time);
+    if (waves->trigger_queue.count > 1)
+        qsort(waves->trigger_queue.entries, waves->trigger_queue.count, sizeof(EnemyWaveEntry), compare_trigger_x);
+    if (waves->sleeper_queue.count > 1)
+        qsort(waves->sleeper_queue.entries, waves->sleeper_queue.count, sizeof(EnemyWaveEntry), compare_sleep_x);
+
+    printf("Loaded %d wave entries from CSV (%d dormant, %d timed, %d position-triggered)\n",
+        order, (int)waves->sleeper_queue.count, (int)waves->timed_queue.count, (int)waves->trigger_queue.count);
+    return true;
+}
+
+bool enemy_waves_copy(EnemyWaves* dst, const EnemyWaves* src) {
+    bool ok = wave_queue_copy(&dst->timed_queue, &src->timed_queue)
+        && wave_queue_copy(&dst->trigger_queue, &src->trigger_queue)
+        && wave_queue_copy(&dst->sleeper_queue, &src->sleeper_queue);
+    dst->stage_clock = 0.0;
+    dst->wake_lo = dst->wake_hi = 0;
+    dst->wake_started = false;
+    return ok;
+}
+
+void enemy_waves_free(EnemyWaves* waves) {
+    wave_queue_free(&waves->timed_queue);
+    wave_queue_free(&waves->trigger_queue);
+    wave_queue_free(&waves->sleeper_queue);
+    waves->wake_lo = waves->wake_hi = 0;
+    waves->wake_started = false;
+}
+
+// ===== Update =====
+
+int enemy_waves_update(World* world, double dt, double wake_left, double wake_right) {
+    world->waves.stage_clock += dt;
+
+    int spawned = wake_sleepers(world, wake_left, wake_right);
+    spawned += release_due(world, &world->waves.timed_queue, false);
+    spawned += release_due(world, &world->waves.trigger_queue, true);
+    return spawned;
+}
+
+bool enemy_waves_pending(const EnemyWaves* waves) {
+    return waves->timed_queue.head < waves->timed_queue.count || waves->trigger_queue.head < waves->trigger_queue.count
+        || waves->wake_hi - waves->wake_lo < waves->sleeper_queue.count;
+}
+
+// ===== Keyframes =====
+
+void enemy_waves_get_cursor(const EnemyWaves* waves, EnemyWavesCursor* cursor) {
+    cursor->stage_clock = waves->stage_clock;
+    cursor->timed_head = waves->timed_queue.head;
+    cursor->trigger_head = waves->trigger_queue.head;
+    cursor->wake_lo = waves->wake_lo;
+    cursor->wake_hi = waves->wake_hi;
+    cursor->wake_started = waves->wake_started;
+}
+
+void enemy_waves_set_cursor(EnemyWaves* waves, const EnemyWavesCursor* cursor) {
+    const WaveQueue* timed = &waves->timed_queue;
+    const WaveQueue* trigger = &waves->trigger_queue;
+    const WaveQueue* sleepers = &waves->sleeper_queue;
+
+    waves->stage_clock = cursor->stage_clock;
+    waves->timed_queue.head = cursor->timed_head <= timed->count ? cursor->timed_head : timed->count;
+    waves->trigger_queue.head = cursor->trigger_head <= trigger->count ? cursor->trigger_head : trigger->count;
+    waves->wake_hi = cursor->wake_hi <= sleepers->count ? cursor->wake_hi : sleepers->count;
+    waves->wake_lo = cursor->wake_lo <= waves->wake_hi ? cursor->wake_lo : waves->wake_hi;
+    waves->wake_started = cursor->wake_started;
+}
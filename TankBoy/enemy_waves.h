@@ -0,0 +1,81 @@
+#ifndef ENEMY_WAVES_H
+#define ENEMY_WAVES_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "enemy.h"
+#include "map_generation.h"
+
+struct World;  // world.h (owns the wave state)
+
+// ===== Constants =====
+#define INITIAL_WAVE_CAPACITY 32
+#define WAVE_SLEEP_BUCKET_WIDTH 256.0   // World pixels per sleeper column
+
+// ===== Data Types =====
+
+// One row of enemies*.csv: x,y,enemy_type,difficulty[,spawn_time[,trigger_x]]
+// Rows with neither column set are placed enemies: they sleep until the
+// camera's wake window reaches their column
+typedef struct {
+    double spawn_time;   // > 0: released this many seconds after stage start
+    double trigger_x;    // > 0: released when the tank reaches this x
+    EnemyType type;
+    double x, y;
+    int difficulty;
+    int order;           // Row in the file, keeps CSV order for equal keys
+} EnemyWaveEntry;
+
+// Time-released and position-released entries live in two queues, each sorted
+// by its own key, so a tick only looks at the heads that are actually due
+typedef struct {
+    EnemyWaveEntry* entries;
+    size_t count;
+    size_t capacity;
+    size_t head;         // Next entry to release
+} WaveQueue;
+
+// One stage's wave table and the progress through it
+typedef struct {
+    WaveQueue timed_queue;
+    WaveQueue trigger_queue;
+    double stage_clock;
+
+    // Dormant enemies, sorted by sleeper column. Entries [wake_lo, wake_hi) have
+    // been woken; the window only grows outward as the camera edges reach new
+    // columns, so sleepers never show up in any per-tick loop
+    WaveQueue sleeper_queue;
+    size_t wake_lo, wake_hi;
+    bool wake_started;
+} EnemyWaves;
+
+// Progress through the loaded wave table (the table itself never changes mid-stage)
+typedef struct {
+    double stage_clock;
+    size_t timed_head, trigger_head;
+    size_t wake_lo, wake_hi;
+    bool wake_started;
+} EnemyWavesCursor;
+
+// ===== Function Declarations =====
+
+// Empty table, nothing pending
+void enemy_waves_init(EnemyWaves* waves);
+
+// Parse enemies<stage>.csv into the sorted wave table (the only file read per stage)
+bool enemy_waves_load(EnemyWaves* waves, int stage_number);
+bool enemy_waves_copy(EnemyWaves* dst, const EnemyWaves* src);  // Loaded table, progress reset
+void enemy_waves_free(EnemyWaves* waves);
+
+// Advance the stage clock, wake sleeper columns inside [wake_left, wake_right]
+// and spawn every due entry into the world; returns the number spawned
+int enemy_waves_update(struct World* world, double dt, double wake_left, double wake_right);
+
+// True while some entry has not been spawned yet (dormant ones included)
+bool enemy_waves_pending(const EnemyWaves* waves);
+
+// Save / restore progress for keyframes (the same stage's table must be loaded)
+void enemy_waves_get_cursor(const EnemyWaves* waves, EnemyWavesCursor* cursor);
+void enemy_waves_set_cursor(EnemyWaves* waves, const EnemyWavesCursor* cursor);
+
+#endif // ENEMY_WAVES_H
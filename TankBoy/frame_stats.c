@@ -0,0 +1,204 @@
+#include "frame_stats.h"
+#include <stdio.h>
+#include <math.h>
+
+// ===== Globals =====
+typedef struct {
+    double frame_ms;
+    int state;
+    long long frame_index;
+} WorstFrame;
+
+static unsigned int histogram[FRAME_STATS_BUCKETS];
+static unsigned int state_histogram[FRAME_STATS_MAX_STATES][FRAME_STATS_BUCKETS];
+static long long state_frames[FRAME_STATS_MAX_STATES];
+static long long state_ticks[FRAME_STATS_MAX_STATES];
+static double state_total_ms[FRAME_STATS_MAX_STATES];
+
+static long long frame_count = 0;
+static double total_ms = 0.0;
+static double min_ms = 0.0;
+static double max_ms = 0.0;
+
+static WorstFrame worst[FRAME_STATS_WORST]; // Sorted, slowest first
+static int worst_count = 0;
+
+// ===== Helpers =====
+
+static int bucket_index(double frame_ms) {
+    if (frame_ms <= FRAME_STATS_MIN_MS) return 0;
+    int index = (int)(log2(frame_ms / FRAME_STATS_MIN_MS) * FRAME_STATS_BUCKETS_PER_OCTAVE);
+    return index < FRAME_STATS_BUCKETS ? index : FRAME_STATS_BUCKETS - 1;
+}
+
+static double bucket_lower_ms(int index) {
+    return FRAME_STATS_MIN_MS * pow(2.0, (double)index / FRAME_STATS_BUCKETS_PER_OCTAVE);
+}
+
+static int clamp_state(int state) {
+    if (state < 0) return 0;
+    return state < FRAME_STATS_MAX_STATES ? state : FRAME_STATS_MAX_STATES - 1;
+}
+
+// Geometric interpolation inside the bucket holding the requested rank
+static double histogram_percentile(const unsigned int* buckets, long long count, double percentile) {
+    if (count == 0) return 0.0;
+
+    double target = percentile / 100.0 * (double)count;
+    long long cumulative = 0;
+    for (int i = 0; i < FRAME_STATS_BUCKETS; i++) {
+        if (buckets[i] == 0) continue;
+        if ((double)(cumulative + buckets[i]) >= target) {
+            double lower = bucket_lower_ms(i);
+            double upper = bucket_lower_ms(i + 1);
+            double fraction = (target - (double)cumulative) / (double)buckets[i];
+            if (fraction < 0.0) fraction = 0.0;
+            double value = lower * pow(upper / lower, fraction);
+            if (value < min_ms) value = min_ms;
+            if (value > max_ms) value = max_ms;
+            return value;
+        }
+        cumulative += buckets[i];
+    }
+    return max_ms;
+}
+
+static const char* state_label(const char* const* state_names, int state_count, int state) {
+    return (state_names && state < state_count) ? state_names[state] : "unknown";
+}
+
+// ===== Recording =====
+
+void frame_stats_record_frame(double frame_ms, int state) {
+    if (frame_ms < 0.0) return;
+    state = clamp_state(state);
+
+    int bucket = bucket_index(frame_ms);
+    histogram[bucket]++;
+    state_histogram[state][bucket]++;
+    state_frames[state]++;
+    state_total_ms[state] += frame_ms;
+
+    if (frame_count == 0 || frame_ms < min_ms) min_ms = frame_ms;
+    if (frame_ms > max_ms) max_ms = frame_ms;
+    total_ms += frame_ms;
+
+    // Keep the slowest frames (insertion into a short sorted list)
+    if (worst_count < FRAME_STATS_WORST || frame_ms > worst[worst_count - 1].frame_ms) {
+        int pos = worst_count < FRAME_STATS_WORST ? worst_count++ : FRAME_STATS_WORST - 1;
+        while (pos > 0 && worst[pos - 1].frame_ms < frame_ms) {
+            worst[pos] = worst[pos - 1];
+            pos--;
+        }
+        worst[pos].frame_ms = frame_ms;
+        worst[pos].state = state;
+        worst[pos].frame_index = frame_count;
+    }
+
+    frame_count++;
+}
+
+void frame_stats_record_ticks(int state, int ticks) {
+    state_ticks[clamp_state(state)] += ticks;
+}
+
+// ===== Summary =====
+
+int frame_stats_frame_count(void) {
+    return (int)frame_count;
+}
+
+double frame_stats_percentile_ms(double percentile) {
+    return histogram_percentile(histogram, frame_count, percentile);
+}
+
+// ===== Report =====
+
+bool frame_stats_write_json(const char* path, const char* const* state_names, int state_count) {
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        printf("Warning: Could not write frame stats file: %s\n", path);
+        return false;
+    }
+
+#ifdef _DEBUG
+    const char* configuration = "Debug";
+#else
+    const char* configuration = "Release";
+#endif
+
+    fprintf(file, "{\n");
+    fprintf(file, "  \"build\": \"%s %s %s\",\n", configuration, __DATE__, __TIME__);
+    fprintf(file, "  \"frames\": %lld,\n", frame_count);
+    fprintf(file, "  \"total_ms\": %.3f,\n", total_ms);
+    fprintf(file, "  \"mean_ms\": %.4f,\n", frame_count ? total_ms / frame_count : 0.0);
+    fprintf(file, "  \"min_ms\": %.4f,\n", min_ms);
+    fprintf(file, "  \"max_ms\": %.4f,\n", max_ms);
+    fprintf(file, "  \"p50_ms\": %.4f,\n", frame_stats_percentile_ms(50.0));
+    fprintf(file, "  \"p90_ms\": %.4f,\n", frame_stats_percentile_ms(90.0));
+    fprintf(file, "  \"p99_ms\": %.4f,\n", frame_stats_percentile_ms(99.0));
+    fprintf(file, "  \"p99_9_ms\": %.4f,\n", frame_stats_percentile_ms(99.9));
+
+    fprintf(file, "  \"worst_frames\": [\n");
+    for (int i = 0; i < worst_count; i++) {
+        fprintf(file, "    {\"frame\": %lld, \"ms\": %.4f, \"state\": \"%s\"}%s\n",
+            worst[i].frame_index, worst[i].frame_ms, state_label(state_names, state_count, worst[i].state),
+            i + 1 < worst_count ? "," : "");
+    }
+    fprintf(file, "  ],\n");
+
+    fprintf(file, "  \"states\": {\n");
+    for (int s = 0; s < state_count && s < FRAME_STATS_MAX_STATES; s++) {
+        long long frames = state_frames[s];
+        fprintf(file, "    \"%s\": {\"frames\": %lld, \"ticks\": %lld, \"mean_ms\": %.4f, "
+            "\"p50_ms\": %.4f, \"p99_ms\": %.4f}%s\n",
+            state_label(state_names, state_count, s), frames, state_ticks[s],
+            frames ? state_total_ms[s] / frames : 0.0,
+            histogram_percentile(state_histogram[s], frames, 50.0),
+            histogram_percentile(state_histogram[s], frames, 99.0),
+            s + 1 < state_count && s + 1 < FRAME_STATS_MAX_STATES ? "," : "");
+    }
+    fprintf(file, "  },\n");
+
+    // Non-empty buckets only: [lower_ms, count]
+    fprintf(file, "  \"histogram\": [");
+    bool first = true;
+    for (int i = 0; i < FRAME_STATS_BUCKETS; i++) {
+        if (histogram[i] == 0) continue;
+        fprintf(file, "%s[%.4f, %u]", first ? "" : ", ", bucket_lower_ms(i), histogram[i]);
+        first = false;
+    }
+    fprintf(file, "]\n");
+    fprintf(file, "}\n");
+
+    fclose(file);
+    printf("Frame stats written: %s (%lld frames, p99 %.2f ms)\n", path, frame_count, frame_stats_percentile_ms(99.0));
+    return true;
+}
+
+bool frame_stats_write_csv(const char* path, const char* const* state_names, int state_count) {
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        printf("Warning: Could not write frame stats file: %s\n", path);
+        return false;
+    }
+
+    // One row per non-empty bucket: edges, total count, then one column per state
+    fprintf(file, "lower_ms,upper_ms,count");
+    for (int s = 0; s < state_count && s < FRAME_STATS_MAX_STATES; s++) {
+        fprintf(file, ",%s", state_label(state_names, state_count, s));
+    }
+    fprintf(file, "\n");
+
+    for (int i = 0; i < FRAME_STATS_BUCKETS; i++) {
+        if (histogram[i] == 0) continue;
+        fprintf(file, "%.4f,%.4f,%u", bucket_lower_ms(i), bucket_lower_ms(i + 1), histogram[i]);
+        for (int s = 0; s < state_count && s < FRAME_STATS_MAX_STATES; s++) {
+            fprintf(file, ",%u", state_histogram[s][i]);
+        }
+        fprintf(file, "\n");
+    }
+
+    fclose(file);
+    return true;
+}
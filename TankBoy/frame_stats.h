@@ -0,0 +1,34 @@
+#ifndef FRAME_STATS_H
+#define FRAME_STATS_H
+
+#include <stdbool.h>
+
+// Per-session frame-time statistics, always on.
+// Frame times go into fixed-size log-bucketed histograms (one overall, one per
+// game state), so recording is a log2 and an increment; percentiles, the worst
+// frames and per-state tick counts are written as JSON and CSV at shutdown.
+
+#define FRAME_STATS_MIN_MS 0.0625        // Lower edge of the first bucket
+#define FRAME_STATS_BUCKETS_PER_OCTAVE 8 // ~9% bucket width
+#define FRAME_STATS_BUCKETS 136          // 17 octaves: up to ~8 s, longer frames land in the last bucket
+#define FRAME_STATS_MAX_STATES 8
+#define FRAME_STATS_WORST 10
+
+#define FRAME_STATS_JSON_FILE "TankBoy/frame_stats.json"
+#define FRAME_STATS_CSV_FILE "TankBoy/frame_stats.csv"
+
+// ===== Function Declarations =====
+
+// Recording (state = GameState value, used only as an index)
+void frame_stats_record_frame(double frame_ms, int state);
+void frame_stats_record_ticks(int state, int ticks);
+
+// Summary queries
+int frame_stats_frame_count(void);
+double frame_stats_percentile_ms(double percentile); // 0..100, overall histogram
+
+// Write the session report; state_names[i] labels state i
+bool frame_stats_write_json(const char* path, const char* const* state_names, int state_count);
+bool frame_stats_write_csv(const char* path, const char* const* state_names, int state_count);
+
+#endif // FRAME_STATS_H
@@ -0,0 +1,15 @@
+#include "game_events.h"
+#include "world.h"
+#include <stddef.h>
+
+void game_events_set_handler(World* world, GameEventHandler handler, void* user) {
+    world->event_handler = handler;
+    world->event_user = user;
+}
+
+void game_event_emit(const World* world, GameEventType type, double x, double y, int value) {
+    if (!world->event_handler) return;
+
+    GameEvent event = { type, x, y, value };
+    world->event_handler(&event, world->event_user);
+}
@@ -0,0 +1,35 @@
+#ifndef GAME_EVENTS_H
+#define GAME_EVENTS_H
+
+// Simulation -> presentation notifications (sound effects, HUD updates, particles).
+// The simulation only emits; whoever owns audio/HUD installs a handler on
+// that world. With no handler installed (headless builds) events are dropped.
+
+struct World;  // world.h (holds the handler)
+
+// ===== Data Types =====
+
+typedef enum {
+    GAME_EVENT_CANNON_FIRED,   // x, y: muzzle position
+    GAME_EVENT_MG_FIRED,       // x, y: muzzle position
+    GAME_EVENT_TANK_DAMAGED,   // value: tank HP after the hit
+    GAME_EVENT_ENEMY_KILLED,   // x, y: enemy centre, value: difficulty
+    GAME_EVENT_ENEMY_DAMAGED,  // x, y: enemy centre, value: damage dealt
+    GAME_EVENT_CANNON_EXPLODED, // x, y: impact point, value: splash radius
+    GAME_EVENT_BULLET_HIT_TERRAIN // x, y: impact point, value: weapon (0=MG, 1=Cannon)
+} GameEventType;
+
+typedef struct {
+    GameEventType type;
+    double x, y;
+    int value;
+} GameEvent;
+
+typedef void (*GameEventHandler)(const GameEvent* event, void* user);
+
+// ===== Function Declarations =====
+
+void game_events_set_handler(struct World* world, GameEventHandler handler, void* user);
+void game_event_emit(const struct World* world, GameEventType type, double x, double y, int value);
+
+#endif // GAME_EVENTS_H
@@ -6,7 +6,20 @@
 #include <allegro5/allegro_ttf.h>
 #include "enemy.h"
 #include "collision.h"
+#include "spatial_hash.h"
+#include "enemy_waves.h"
 #include "ranking.h"
+#include "game_events.h"
+#include "tank_render.h"
+#include "bullet_render.h"
+#include "map_render.h"
+#include "enemy_render.h"
+#include "profiler.h"
+#include "profiler_render.h"
+#include "replay.h"
+#include "snapshot.h"
+#include "background.h"
+#include "sprite_atlas.h"
 
 // =================== Config Loading ===================
 
@@ -58,6 +71,10 @@ void load_game_config(GameConfig* config, const char* config_file) {
     config->game_speed = ini_parser_get_int(parser, "Game", "game_speed", 60);
     config->max_lives = ini_parser_get_int(parser, "Game", "max_lives", 3);
     config->max_bullets = ini_parser_get_int(parser, "Game", "max_bullets", 100);
+    const char* rng_seed = ini_parser_get_string(parser, "Game", "rng_seed", "0");
+    config->rng_seed = strtoull(rng_seed, NULL, 10);
+    config->replay_keyframe_seconds = ini_parser_get_int(parser, "Game", "replay_keyframe_seconds", 5);
+    if (config->replay_keyframe_seconds < 1) config->replay_keyframe_seconds = 1;
 
     // Font
     const char* font_file = ini_parser_get_string(parser, "Font", "font_file", "TankBoy/resources/fonts/pressstart.ttf");
@@ -104,38 +121,23 @@ static void draw_button(const Button* btn, const GameConfig* cfg, ALLEGRO_FONT*
     al_draw_text(font, fg, btn->x + btn->width / 2, btn->y + btn->height / 2 - 8, ALLEGRO_ALIGN_CENTER, btn->text);
 }
 
-static void draw_menu(const GameSystem* game_system) {
-    // Draw intro background if loaded
-    if (game_system->intro_bg) {
-        // Scale background to fill the entire buffer (crop if necessary)
-        int bg_width = al_get_bitmap_width(game_system->intro_bg);
-        int bg_height = al_get_bitmap_height(game_system->intro_bg);
-        
-        // Calculate scaling to fill the buffer completely (may crop parts of the image)
-        float scale_x = (float)game_system->config.buffer_width / bg_width;
-        float scale_y = (float)game_system->config.buffer_height / bg_height;
-        float scale = (scale_x > scale_y) ? scale_x : scale_y; // Use the larger scale to fill
-        
-        // Calculate scaled dimensions
-        int scaled_width = (int)(bg_width * scale);
-        int scaled_height = (int)(bg_height * scale);
-        
-        // Calculate position to center the image (may be negative if image is larger than buffer)
-        int x = (game_system->config.buffer_width - scaled_width) / 2;
-        int y = (game_system->config.buffer_height - scaled_height) / 2;
-        
-        al_draw_scaled_bitmap(game_system->intro_bg, 0, 0, bg_width, bg_height, 
-                              x, y, scaled_width, scaled_height, 0);
-    } else {
-        // Fallback to solid color if background not loaded
+// Full-screen background for the still screens (pre-scaled once, see background.h);
+// solid menu colour if the image did not load
+static void draw_screen_background(const GameSystem* game_system, ALLEGRO_BITMAP* image) {
+    if (!background_draw_fill(image, game_system->config.buffer_width, game_system->config.buffer_height)) {
         al_clear_to_color(al_map_rgb(game_system->config.menu_bg_r, game_system->config.menu_bg_g, game_system->config.menu_bg_b));
     }
+}
+
+static void draw_menu(const GameSystem* game_system, const RenderSnapshot* snapshot) {
+    // Draw intro background if loaded
+    draw_screen_background(game_system, game_system->intro_bg);
     
     al_draw_text(game_system->title_font, al_map_rgb(game_system->config.text_r, game_system->config.text_g, game_system->config.text_b),
         game_system->config.buffer_width / 2, 100, ALLEGRO_ALIGN_CENTER, "TANK BOY");
-    draw_button(&game_system->start_button, &game_system->config, game_system->font);
-    draw_button(&game_system->exit_button, &game_system->config, game_system->font);
-    draw_button(&game_system->ranking_button, &game_system->config, game_system->font);
+    draw_button(&snapshot->start_button, &game_system->config, game_system->font);
+    draw_button(&snapshot->exit_button, &game_system->config, game_system->font);
+    draw_button(&snapshot->ranking_button, &game_system->config, game_system->font);
 }
 
 // =================== Coordinate Conversion ===================
@@ -145,6 +147,174 @@ static void display_to_buffer_coords(int display_x, int display_y, int* buffer_x
     *buffer_y = (int)(display_y / cfg->display_scale);
 }
 
+// =================== Replay Playback ===================
+
+// Playback speed table (REPLAY_SPEED_COUNT entries, keys 1-5)
+static const double replay_speeds[REPLAY_SPEED_COUNT] = { 0.25, 1.0, 4.0, 16.0, REPLAY_SPEED_UNCAPPED };
+static const char* const replay_speed_names[REPLAY_SPEED_COUNT] = { "0.25x", "1x", "4x", "16x", "MAX" };
+
+// Keyframe k holds the state just before tick k * interval was played
+typedef struct {
+    uint8_t* snapshot;        // World state (snapshot.h), a few KB
+    size_t snapshot_size;
+    ReplayCursor cursor;
+    GameState state;
+    bool stage_clear;
+    bool game_over;
+} PlaybackKeyframe;
+
+static PlaybackKeyframe* keyframes = NULL;
+static int keyframe_count = 0;
+static int keyframe_capacity = 0;
+static bool replay_seeking = false; // Fast-forwarding to a seek target (no sound)
+
+double game_system_playback_speed(const GameSystem* game_system) {
+    if (!replay_is_playing()) return 1.0;
+    return replay_speeds[game_system->replay_speed];
+}
+
+static unsigned long long keyframe_interval_ticks(const GameSystem* game_system) {
+    return (unsigned long long)game_system->config.replay_keyframe_seconds * SIM_TICK_RATE;
+}
+
+// Called before each replay tick; keyframes are only ever appended in order
+static void capture_keyframe_if_due(GameSystem* game_system) {
+    unsigned long long interval = keyframe_interval_ticks(game_system);
+    if (replay_ticks_played() != (unsigned long long)keyframe_count * interval) return;
+
+    if (keyframe_count >= keyframe_capacity) {
+        int new_capacity = keyframe_capacity ? keyframe_capacity * 2 : 32;
+        PlaybackKeyframe* new_keyframes = realloc(keyframes, new_capacity * sizeof(PlaybackKeyframe));
+        if (!new_keyframes) return;
+
+        keyframes = new_keyframes;
+        keyframe_capacity = new_capacity;
+    }
+
+    PlaybackKeyframe* keyframe = &keyframes[keyframe_count];
+    size_t capacity = snapshot_max_size(&game_system->world);
+    keyframe->snapshot = malloc(capacity);
+    if (!keyframe->snapshot) return;
+
+    // Shrink to the bytes actually used
+    keyframe->snapshot_size = snapshot_save(&game_system->world, keyframe->snapshot, capacity);
+    uint8_t* shrunk = realloc(keyframe->snapshot, keyframe->snapshot_size);
+    if (shrunk) keyframe->snapshot = shrunk;
+
+    replay_get_cursor(&keyframe->cursor);
+    keyframe->state = game_system->current_state;
+    keyframe->stage_clear = game_system->stage_clear;
+    keyframe->game_over = game_system->game_over;
+    keyframe_count++;
+}
+
+static void free_keyframes(void) {
+    for (int i = 0; i < keyframe_count; i++) free(keyframes[i].snapshot);
+    free(keyframes);
+    keyframes = NULL;
+    keyframe_count = 0;
+    keyframe_capacity = 0;
+}
+
+static void restore_keyframe(GameSystem* game_system, const PlaybackKeyframe* keyframe) {
+    if (!snapshot_load(&game_system->world, keyframe->snapshot, keyframe->snapshot_size)) return;
+    replay_set_cursor(&keyframe->cursor);
+
+    if (game_system->current_state != keyframe->state) switch_audio_for_state(keyframe->state);
+    game_system->current_state = keyframe->state;
+    game_system->stage_clear = keyframe->stage_clear;
+    game_system->game_over = keyframe->game_over;
+    update_tank_hp_display(game_system->world.tank.hp);
+}
+
+// Jump to the nearest keyframe at or before the target, then simulate the rest silently
+static void seek_replay(GameSystem* game_system, long long target_tick) {
+    if (keyframe_count == 0) return;
+    if (target_tick < 0) target_tick = 0;
+
+    unsigned long long target = (unsigned long long)target_tick;
+    int index = (int)(target / keyframe_interval_ticks(game_system));
+    if (index >= keyframe_count) index = keyframe_count - 1;
+
+    // Seeking forward past the current tick: no need to go back to a keyframe
+    unsigned long long current = replay_ticks_played();
+    if (target < current || keyframes[index].cursor.ticks > current) restore_keyframe(game_system, &keyframes[index]);
+
+    replay_seeking = true;
+    while (replay_is_playing() && game_system->running && replay_ticks_played() < target) {
+        unsigned long long before = replay_ticks_played();
+        game_system_step(game_system, SIM_DT);
+        if (replay_ticks_played() == before && replay_is_playing() && game_system->current_state != STATE_GAME) break;
+    }
+    replay_seeking = false;
+}
+
+// Replay keys: 1-5 speed, Left/Right seek by one keyframe interval, Home restarts, ESC quits
+static void handle_replay_keys(ALLEGRO_EVENT* event, GameSystem* game_system) {
+    if (event->type != ALLEGRO_EVENT_KEY_DOWN) return;
+
+    int keycode = event->keyboard.keycode;
+    long long interval = (long long)keyframe_interval_ticks(game_system);
+    long long current = (long long)replay_ticks_played();
+
+    if (keycode >= ALLEGRO_KEY_1 && keycode < ALLEGRO_KEY_1 + REPLAY_SPEED_COUNT) {
+        game_system->replay_speed = keycode - ALLEGRO_KEY_1;
+        printf("Replay speed: %s\n", replay_speed_names[game_system->replay_speed]);
+    }
+    else if (keycode == ALLEGRO_KEY_LEFT) seek_replay(game_system, current - interval);
+    else if (keycode == ALLEGRO_KEY_RIGHT) seek_replay(game_system, current + interval);
+    else if (keycode == ALLEGRO_KEY_HOME) seek_replay(game_system, 0);
+    else if (keycode == ALLEGRO_KEY_ESCAPE) game_system->running = false;
+#ifdef TANKBOY_PROFILE
+    else if (keycode == ALLEGRO_KEY_F3) profiler_toggle_overlay();
+#endif
+}
+
+static void draw_replay_status(const GameSystem* game_system, const RenderSnapshot* snapshot) {
+    unsigned long long seconds = snapshot->replay_ticks / SIM_TICK_RATE;
+    char status[128];
+    snprintf(status, sizeof(status), "REPLAY %s  %02llu:%02llu   1-5 speed  LEFT/RIGHT seek  HOME restart",
+        replay_speed_names[snapshot->replay_speed], seconds / 60, seconds % 60);
+    al_draw_text(game_system->font, al_map_rgb(255, 255, 0), 20, game_system->config.buffer_height - 40, 0, status);
+}
+
+// =================== Game Events ===================
+
+// Presentation side of the simulation events: sound effects, HUD and particles
+static void handle_game_event(const GameEvent* event, void* user) {
+    GameSystem* game_system = (GameSystem*)user;
+    ParticleBurstLog* bursts = &game_system->particle_bursts;
+
+    // Fast-forward and seeking run silent; seeking shows no effects either
+    bool audible = !replay_seeking && game_system_playback_speed(game_system) == 1.0;
+
+    switch (event->type) {
+    case GAME_EVENT_CANNON_FIRED:
+        if (audible) play_cannon_sound();
+        break;
+    case GAME_EVENT_MG_FIRED:
+        if (audible) play_machine_sound();
+        break;
+    case GAME_EVENT_TANK_DAMAGED:
+        update_tank_hp_display(event->value);
+        break;
+    case GAME_EVENT_ENEMY_KILLED:
+        if (!replay_seeking) particle_burst_push(bursts, PARTICLE_BURST_DEBRIS, event->x, event->y, event->value);
+        break;
+    case GAME_EVENT_ENEMY_DAMAGED:
+        if (!replay_seeking) particle_burst_push(bursts, PARTICLE_BURST_SPARKS, event->x, event->y, event->value);
+        break;
+    case GAME_EVENT_CANNON_EXPLODED:
+        if (!replay_seeking) particle_burst_push(bursts, PARTICLE_BURST_EXPLOSION, event->x, event->y, event->value);
+        break;
+    case GAME_EVENT_BULLET_HIT_TERRAIN:
+        if (!replay_seeking) particle_burst_push(bursts, PARTICLE_BURST_DIRT, event->x, event->y, event->value == 1 ? 3.0 : 1.0);
+        break;
+    default:
+        break;
+    }
+}
+
 // =================== Game Initialization ===================
 
 void init_game_system(ALLEGRO_DISPLAY* display, ALLEGRO_EVENT_QUEUE* queue, GameSystem* game_system) {
@@ -206,36 +376,18 @@ void init_game_system(ALLEGRO_DISPLAY* display, ALLEGRO_EVENT_QUEUE* queue, Game
 
     game_system->current_state = STATE_MENU;
     game_system->running = true;
-    game_system->current_stage = 1; // Initialize current stage first
 
     input_system_init(&game_system->input);
-    
-    // Load spawn points and initialize tank position
-    char spawn_file[256];
-    snprintf(spawn_file, sizeof(spawn_file), "TankBoy/resources/stages/spawns%d.csv", game_system->current_stage);
-    
-    double tank_x = 100.0; // Default position
-    double tank_y = 2000.0; // Default position
-    
-    if (spawn_points_load(&game_system->spawn_points, spawn_file)) {
-        SpawnPoint* tank_spawn = spawn_points_get_tank_spawn(&game_system->spawn_points);
-        if (tank_spawn) {
-            tank_x = (double)tank_spawn->x;
-            tank_y = (double)tank_spawn->y;
-            printf("Tank spawn loaded from file: (%.0f, %.0f)\n", tank_x, tank_y);
-        }
-    } else {
-        printf("Using default tank spawn position: (%.0f, %.0f)\n", tank_x, tank_y);
-    }
-    
-    tank_init(&game_system->player_tank, tank_x, tank_y);
 
-    game_system->max_bullets = game_system->config.max_bullets;
-    game_system->bullets = malloc(sizeof(Bullet) * game_system->max_bullets);
-    bullets_init(game_system->bullets, game_system->max_bullets);
+    // Seed the world generator; a clock seed is printed so the run can be repeated
+    if (game_system->config.rng_seed == 0) {
+        game_system->config.rng_seed = rng_seed_from_time();
+    }
+    printf("RNG seed: %llu\n", game_system->config.rng_seed);
 
-    game_system->camera_x = 0;
-    game_system->camera_y = 0;
+    // Simulation state (World owns the tank, bullets, enemies and rng)
+    world_init(&game_system->world, game_system->config.max_bullets,
+        game_system->config.buffer_width, game_system->config.buffer_height, game_system->config.rng_seed);
 
     head_up_display_init("config.ini");
 
@@ -259,12 +411,8 @@ void init_game_system(ALLEGRO_DISPLAY* display, ALLEGRO_EVENT_QUEUE* queue, Game
         game_system->title_font = game_system->font; // Fallback to regular font
     }
     
-    // Initialize and load map
-    char map_file[256];
-    snprintf(map_file, sizeof(map_file), "TankBoy/resources/stages/stage%d.csv", game_system->current_stage);
-    if (!map_load(&game_system->current_map, map_file))
-        map_init(&game_system->current_map);
-    printf("location : %s\n", map_file);
+    // Load stage 1 map, spawns and wave table (enemies spawn once the game starts)
+    world_load_stage(&game_system->world, 1);
 
 
     char map_sprite_file[256];
@@ -277,35 +425,28 @@ void init_game_system(ALLEGRO_DISPLAY* display, ALLEGRO_EVENT_QUEUE* queue, Game
     char tank_sprite_file[256];
     snprintf(tank_sprite_file, sizeof(tank_sprite_file), "TankBoy/resources/sprites/tank_sprite_sheet_croped.png");
     printf("location : %s\n", tank_sprite_file);
-    tank_sprite_init(tank_sprite_file);
+    tank_sprite_init(tank_sprite_file, game_system->world.tank.width, game_system->world.tank.height);
     
-    // Load enemies from CSV file after map is loaded
-    load_enemies_from_csv_with_map(1, (const Map*)&game_system->current_map); // Load stage 1 enemies
-    
-    // Initialize enemy system
-    game_system->round_number = 1;
-    game_system->enemies_spawned = false;
-
     enemy_sprites_init();
     flying_enemy_sprites_init();
     bullet_sprites_init();
     hud_sprites_init();
     
-    // Set global references for getter functions
-    set_global_tank_ref(&game_system->player_tank);
-    set_global_bullet_ref(game_system->bullets, game_system->max_bullets);
-    set_global_game_system(game_system);
+    // Sound effects and HUD updates raised by the simulation
+    game_events_set_handler(&game_system->world, handle_game_event, game_system);
 
     game_system->stage_clear = false;
     game_system->stage_clear_timer = 0.0;
     game_system->stage_clear_scale = 1.0;
-    game_system->score = 0.0;  // Initialize score
     
     // Initialize game over system
     game_system->game_over = false;
     game_system->game_over_timer = 0.0;
     game_system->game_over_scale = 1.0;
 
+    game_system->replay_speed = REPLAY_SPEED_DEFAULT;
+    game_system->particle_bursts.count = 0;
+
     // Initialize ranking system
     ranking_init();
     
@@ -320,9 +461,8 @@ void init_game_system(ALLEGRO_DISPLAY* display, ALLEGRO_EVENT_QUEUE* queue, Game
 // =================== Cleanup ===================
 
 void cleanup_game_system(GameSystem* game_system, ALLEGRO_EVENT_QUEUE* queue, ALLEGRO_DISPLAY* display) {
-    map_free(&game_system->current_map);
-    spawn_points_free(&game_system->spawn_points);
-    free(game_system->bullets);
+    free_keyframes();
+    world_free(&game_system->world);
     al_destroy_bitmap(game_system->buffer);
     al_destroy_font(game_system->font);
     if (game_system->title_font && game_system->title_font != game_system->font) {
@@ -330,12 +470,21 @@ void cleanup_game_system(GameSystem* game_system, ALLEGRO_EVENT_QUEUE* queue, AL
     }
     
     // Destroy background images
+    background_cache_free();
+    flying_enemy_sprites_deinit();
+    sprite_atlas_free();
+    particles_free();
+    head_up_display_deinit();
     if (game_system->bg_green) al_destroy_bitmap(game_system->bg_green);
     if (game_system->bg_volcano) al_destroy_bitmap(game_system->bg_volcano);
     if (game_system->bg_snow) al_destroy_bitmap(game_system->bg_snow);
     if (game_system->intro_bg) al_destroy_bitmap(game_system->intro_bg);
     if (game_system->ranking_bg) al_destroy_bitmap(game_system->ranking_bg);
     
+#ifdef TANKBOY_PROFILE
+    profiler_overlay_deinit();
+#endif
+
     al_destroy_event_queue(queue);
     al_destroy_display(display);
     map_sprites_deinit();
@@ -345,6 +494,56 @@ void cleanup_game_system(GameSystem* game_system, ALLEGRO_EVENT_QUEUE* queue, AL
     audio_cleanup();
 }
 
+// =================== Game Flow ===================
+
+// Shared by the buttons and replay playback; recorded so a replay hits them at the same tick
+static void start_new_game(GameSystem* game_system) {
+    replay_record_command(REPLAY_CMD_NEW_GAME);
+
+    game_system->game_over = false;
+    game_system->stage_clear = false;
+    world_new_game(&game_system->world);
+
+    // Reset game state flags and switch audio
+    game_system->current_state = STATE_GAME;
+    switch_audio_for_state(STATE_GAME);
+}
+
+static void advance_to_next_stage(GameSystem* game_system) {
+    replay_record_command(REPLAY_CMD_NEXT_STAGE);
+
+    game_system->stage_clear = false;
+    world_load_stage(&game_system->world, game_system->world.stage + 1);
+}
+
+static void finish_replay(GameSystem* game_system) {
+    const World* world = &game_system->world;
+    printf("Replay finished after %llu ticks: stage %d, score %d, rank #%d, tank at (%.3f, %.3f)\n",
+        replay_ticks_played(), world->stage, (int)world->score,
+        ranking_get_player_rank((int)world->score), world->tank.x, world->tank.y);
+
+    replay_play_end();
+    game_system->running = false;
+}
+
+// Apply the UI commands due before the next recorded tick
+static void apply_replay_commands(GameSystem* game_system) {
+    ReplayCommand command;
+    while (replay_next_command(&command)) {
+        switch (command) {
+        case REPLAY_CMD_NEW_GAME:
+            start_new_game(game_system);
+            break;
+        case REPLAY_CMD_NEXT_STAGE:
+            advance_to_next_stage(game_system);
+            break;
+        default:
+            finish_replay(game_system);
+            return;
+        }
+    }
+}
+
 // =================== Input Handling ===================
 
 static void handle_keyboard_input(ALLEGRO_EVENT* event, GameSystem* game_system) {
@@ -367,11 +566,11 @@ static void handle_keyboard_input(ALLEGRO_EVENT* event, GameSystem* game_system)
         if (game_system->current_state == STATE_NAME_INPUT) {
             // Process name input and add score to ranking
             if (strlen(game_system->name_input.buffer) > 0) {
-                ranking_add_score_with_name((int)game_system->score, game_system->current_stage, game_system->name_input.buffer);
+                ranking_add_score_with_name((int)game_system->world.score, game_system->world.stage, game_system->name_input.buffer);
                 printf("Score added with name: %s\n", game_system->name_input.buffer);
             } else {
                 // Use default name if no input
-                ranking_add_score((int)game_system->score, game_system->current_stage);
+                ranking_add_score((int)game_system->world.score, game_system->world.stage);
                 printf("Score added with default name\n");
             }
             // Go to ranking page
@@ -380,6 +579,31 @@ static void handle_keyboard_input(ALLEGRO_EVENT* event, GameSystem* game_system)
         }
         break;
     // Removed U key force clear - now auto clears when all enemies defeated
+#ifdef TANKBOY_PROFILE
+    case ALLEGRO_KEY_F3:
+        profiler_toggle_overlay();
+        break;
+    case ALLEGRO_KEY_F4:
+        // Dump the trace captured so far (capture keeps running)
+        if (profiler_trace_active()) profiler_trace_write(PROFILE_TRACE_FILE);
+        break;
+#endif
+    case ALLEGRO_KEY_F5:
+        if (game_system->current_state == STATE_GAME) snapshot_write_file(&game_system->world, SNAPSHOT_QUICKSAVE_FILE);
+        break;
+    case ALLEGRO_KEY_F9:
+        // Quick load; the session recording would no longer replay, so it stops here
+        if (game_system->current_state == STATE_GAME
+            && snapshot_read_file(&game_system->world, SNAPSHOT_QUICKSAVE_FILE)) {
+            if (replay_is_recording()) {
+                replay_record_end();
+                printf("Session recording stopped (quick load)\n");
+            }
+            game_system->stage_clear = false;
+            game_system->game_over = false;
+            update_tank_hp_display(game_system->world.tank.hp);
+        }
+        break;
     }
     
     // Handle text input for name input state
@@ -400,12 +624,12 @@ static void handle_mouse_input(ALLEGRO_EVENT* event, GameSystem* game_system) {
         }
         else if (game_system->current_state == STATE_GAME && game_system->stage_clear && game_system->stage_clear_timer < 0) {
             // can change cannon angle in clear state
-            double cx = game_system->player_tank.x - game_system->camera_x + get_tank_width() / 2;
-            double cy = game_system->player_tank.y - game_system->camera_y + get_tank_height() / 2;
-            game_system->player_tank.cannon_angle = atan2(by - cy, bx - cx);
+            double cx = game_system->world.tank.x - game_system->world.camera_x + game_system->world.tank.width / 2;
+            double cy = game_system->world.tank.y - game_system->world.camera_y + game_system->world.tank.height / 2;
+            game_system->world.tank.cannon_angle = atan2(by - cy, bx - cx);
             
             // Handle hover for stage clear/end screen buttons
-            if (game_system->current_stage >= 3) {
+            if (game_system->world.stage >= 3) {
                 // Game end screen - handle menu button hover
                 game_system->menu_button.hovered = is_point_in_button(bx, by, &game_system->menu_button);
             } else {
@@ -423,9 +647,9 @@ static void handle_mouse_input(ALLEGRO_EVENT* event, GameSystem* game_system) {
             game_system->menu_button.hovered = is_point_in_button(bx, by, &game_system->menu_button);
         }
         else if (game_system->current_state == STATE_GAME) {
-            double cx = game_system->player_tank.x - game_system->camera_x + get_tank_width() / 2;
-            double cy = game_system->player_tank.y - game_system->camera_y + get_tank_height() / 2;
-            game_system->player_tank.cannon_angle = atan2(by - cy, bx - cx);
+            double cx = game_system->world.tank.x - game_system->world.camera_x + game_system->world.tank.width / 2;
+            double cy = game_system->world.tank.y - game_system->world.camera_y + game_system->world.tank.height / 2;
+            game_system->world.tank.cannon_angle = atan2(by - cy, bx - cx);
         }
         break;
 
@@ -435,47 +659,7 @@ static void handle_mouse_input(ALLEGRO_EVENT* event, GameSystem* game_system) {
         if (game_system->current_state == STATE_MENU) {
             if (is_point_in_button(bx, by, &game_system->start_button)) {
                 // Initialize for new game start
-                game_system->score = 0;
-                game_system->current_stage = 1;
-                game_system->game_over = false;
-                game_system->stage_clear = false;
-                game_system->round_number = 1;
-                char map_file[256];
-                snprintf(map_file, sizeof(map_file), "TankBoy/resources/stages/stage%d.csv", game_system->current_stage);
-                if (!map_load(&game_system->current_map, map_file))
-                    map_init(&game_system->current_map);
-                
-                // Load spawn points for the new stage
-                char spawn_file[256];
-                snprintf(spawn_file, sizeof(spawn_file), "TankBoy/resources/stages/spawns%d.csv", game_system->current_stage);
-                
-                double tank_x = 100.0; // Default position
-                double tank_y = 2000.0; // Default position
-                
-                // Free previous spawn points
-                spawn_points_free(&game_system->spawn_points);
-                
-                if (spawn_points_load(&game_system->spawn_points, spawn_file)) {
-                    SpawnPoint* tank_spawn = spawn_points_get_tank_spawn(&game_system->spawn_points);
-                    if (tank_spawn) {
-                        tank_x = (double)tank_spawn->x;
-                        tank_y = (double)tank_spawn->y;
-                        printf("Tank spawn loaded for stage %d: (%.0f, %.0f)\n", game_system->current_stage, tank_x, tank_y);
-                    }
-                } else {
-                    printf("Using default tank spawn position for stage %d: (%.0f, %.0f)\n", game_system->current_stage, tank_x, tank_y);
-                }
-                
-                tank_init(&game_system->player_tank, tank_x, tank_y);
-                
-                // Reset enemies for new game
-                enemies_init();
-                flying_enemies_init();
-                game_system->enemies_spawned = false;
-                
-                // Reset game state flags and switch audio
-                game_system->current_state = STATE_GAME;
-                switch_audio_for_state(STATE_GAME);
+                start_new_game(game_system);
             }
             else if (is_point_in_button(bx, by, &game_system->exit_button)) game_system->running = false;
             else if (is_point_in_button(bx, by, &game_system->ranking_button)) {
@@ -485,7 +669,7 @@ static void handle_mouse_input(ALLEGRO_EVENT* event, GameSystem* game_system) {
         }
         else if (game_system->current_state == STATE_GAME && game_system->stage_clear && game_system->stage_clear_timer < 0) {
             // Handle button clicks on stage clear/end screen
-            if (game_system->current_stage >= 3) {
+            if (game_system->world.stage >= 3) {
                 // Game end screen - handle menu button
                 if (is_point_in_button(bx, by, &game_system->menu_button)) {
                     game_system->current_state = STATE_MENU;
@@ -496,41 +680,7 @@ static void handle_mouse_input(ALLEGRO_EVENT* event, GameSystem* game_system) {
                 // Stage clear screen - handle next button
                 if (is_point_in_button(bx, by, &game_system->next_button)) {
                     // Move to next stage
-                    game_system->stage_clear = false;
-                    game_system->current_stage++;
-
-                    char map_file[256];
-                    snprintf(map_file, sizeof(map_file), "TankBoy/resources/stages/stage%d.csv", game_system->current_stage);
-                    if (!map_load(&game_system->current_map, map_file))
-                        map_init(&game_system->current_map);
-
-                    // Load spawn points for the new stage
-                    char spawn_file[256];
-                    snprintf(spawn_file, sizeof(spawn_file), "TankBoy/resources/stages/spawns%d.csv", game_system->current_stage);
-                    
-                    double tank_x = 100.0; // Default position
-                    double tank_y = 2000.0; // Default position
-                    
-                    // Free previous spawn points
-                    spawn_points_free(&game_system->spawn_points);
-                    
-                    if (spawn_points_load(&game_system->spawn_points, spawn_file)) {
-                        SpawnPoint* tank_spawn = spawn_points_get_tank_spawn(&game_system->spawn_points);
-                        if (tank_spawn) {
-                            tank_x = (double)tank_spawn->x;
-                            tank_y = (double)tank_spawn->y;
-                            printf("Tank spawn loaded for stage %d: (%.0f, %.0f)\n", game_system->current_stage, tank_x, tank_y);
-                        }
-                    } else {
-                        printf("Using default tank spawn position for stage %d: (%.0f, %.0f)\n", game_system->current_stage, tank_x, tank_y);
-                    }
-                    
-                    tank_init(&game_system->player_tank, tank_x, tank_y);
-                    
-                    // Reset enemies for new stage
-                    enemies_init();
-                    flying_enemies_init();
-                    game_system->enemies_spawned = false;
+                    advance_to_next_stage(game_system);
                 }
             }
         }
@@ -541,7 +691,7 @@ static void handle_mouse_input(ALLEGRO_EVENT* event, GameSystem* game_system) {
                 game_system->current_state = STATE_NAME_INPUT;
                 text_input_reset(&game_system->name_input);
                 switch_audio_for_state(STATE_NAME_INPUT);
-                printf("Enter your name for final score %d\n", (int)game_system->score);
+                printf("Enter your name for final score %d\n", (int)game_system->world.score);
             }
             else if (is_point_in_button(bx, by, &game_system->menu_button)) {
                 game_system->current_state = STATE_MENU;
@@ -575,21 +725,43 @@ static void handle_mouse_input(ALLEGRO_EVENT* event, GameSystem* game_system) {
 // =================== Game Update ===================
 
 void update_game_state(ALLEGRO_EVENT* event, GameSystem* game_system) {
+    // A replay drives the game itself; live input only gets the playback keys
+    if (replay_is_playing()) {
+        handle_replay_keys(event, game_system);
+        return;
+    }
+
     handle_keyboard_input(event, game_system);
     handle_mouse_input(event, game_system);
     input_system_update(&game_system->input, event);
+}
 
-    if (game_system->current_state != STATE_GAME) return;
-    if (event->type != ALLEGRO_EVENT_TIMER) return;
+// =================== Simulation Step ===================
 
+void game_system_step(GameSystem* game_system, double dt) {
+    if (replay_is_playing()) {
+        capture_keyframe_if_due(game_system);
+        apply_replay_commands(game_system);
+        if (!replay_is_playing()) return;
+    }
+    if (game_system->current_state != STATE_GAME) return;
 
+    // Sim input for this tick: from the replay, or recorded as it goes in
+    if (replay_is_playing()) {
+        if (!replay_read_tick(&game_system->input, &game_system->world.tank.cannon_angle)) {
+            finish_replay(game_system);
+            return;
+        }
+    }
+    else {
+        replay_record_tick(&game_system->input, game_system->world.tank.cannon_angle);
+    }
 
-    tank_update(&game_system->player_tank, &game_system->input, 1.0 / 60.0,
-        game_system->bullets, game_system->max_bullets, (const Map*)&game_system->current_map);
-    bullets_update(game_system->bullets, game_system->max_bullets, (const Map*)&game_system->current_map);
+    world_step(&game_system->world, &game_system->input, dt);
+    PROFILE_FRAME_END(PROFILE_FRAME_SIM);   // Sim scopes close here, render scopes on the render thread
 
     // Check for game over condition
-    if (get_tank_hp() <= 0 && !game_system->game_over) {
+    if (game_system->world.tank_destroyed && !game_system->game_over) {
         game_system->game_over = true;
         game_system->game_over_timer = 0.0;
         game_system->game_over_scale = 1.0;
@@ -598,75 +770,34 @@ void update_game_state(ALLEGRO_EVENT* event, GameSystem* game_system) {
         game_system->current_state = STATE_NAME_INPUT;
         text_input_reset(&game_system->name_input);
         switch_audio_for_state(STATE_NAME_INPUT);
-        printf("Game over! Enter your name for score %d\n", (int)game_system->score);
-    }
-
-    // Update camera to follow tank
-    game_system->camera_x = game_system->player_tank.x - game_system->config.buffer_width / 3.0;
-    game_system->camera_y = game_system->player_tank.y - game_system->config.buffer_height / 2.0;
-    
-    // Set camera position for HP bar drawing
-    set_camera_position(game_system->camera_x, game_system->camera_y);
-    
-    // Spawn enemies if not spawned yet (but not during stage clear)
-    if (!game_system->enemies_spawned && !game_system->stage_clear) {
-        load_enemies_from_csv_with_map(game_system->current_stage, (const Map*)&game_system->current_map);
-        // spawn_flying_enemy(game_system->round_number); // Removed: CSV already contains all enemies
-        game_system->enemies_spawned = true;
-    }
-    
-    // Update enemy systems with map reference
-    enemies_update_roi_with_map(1.0/60.0, game_system->camera_x, game_system->camera_y, 
-                      game_system->config.buffer_width, game_system->config.buffer_height, (const Map*)&game_system->current_map);
-    flying_enemies_update_roi(1.0/60.0, game_system->camera_x, game_system->camera_y, 
-                             game_system->config.buffer_width, game_system->config.buffer_height);
-    
-    // Update collision detection (only when not game over)
-    if (!game_system->game_over) {
-        bullets_hit_enemies();
-        bullets_hit_tank();
-        tank_touch_ground_enemy();
-        tank_touch_flying_enemy();
-    }
-    
-    // Check if all enemies are cleared for next round (but not during stage clear)
-    int total_alive_enemies = get_alive_enemy_count() + get_alive_flying_enemy_count();
-    if (total_alive_enemies == 0 && !game_system->stage_clear) {
-        game_system->round_number++;
-        game_system->enemies_spawned = false;
+        printf("Game over! Enter your name for score %d\n", (int)game_system->world.score);
     }
     
     // HUD update only when not in Stage Clear!
     if (!game_system->stage_clear) {
         game_system->hud = head_up_display_update(
-            (int)game_system->score,
-            game_system->player_tank.weapon,
-            game_system->current_stage
+            (int)game_system->world.score,
+            game_system->world.tank.weapon,
+            game_system->world.stage
         );
         
         // Update HUD with enemy counts and round
-        game_system->hud.enemies_alive = get_alive_enemy_count();
-        game_system->hud.flying_enemies_alive = get_alive_flying_enemy_count();
-        game_system->hud.round = game_system->round_number;
-        game_system->hud.player_hp = get_tank_hp();
-        game_system->hud.player_max_hp = get_tank_max_hp();
+        game_system->hud.enemies_alive = get_alive_enemy_count(&game_system->world);
+        game_system->hud.flying_enemies_alive = get_alive_flying_enemy_count(&game_system->world);
+        game_system->hud.round = game_system->world.round_number;
+        game_system->hud.player_hp = game_system->world.tank.hp;
+        game_system->hud.player_max_hp = game_system->world.tank.max_hp;
         
-        // Auto stage clear when all enemies are defeated
-        int total_enemies = game_system->hud.enemies_alive + game_system->hud.flying_enemies_alive;
-        if (total_enemies == 0) {
-            // Add health bonus when clearing stage
-            int current_hp = get_tank_hp();
-            int health_bonus = current_hp * 10;  // HP * 10 = 보너스 점수
-            game_system->score += health_bonus;
-                       
+        // The world flags the clear (health bonus already added); show the clear screen
+        if (game_system->world.stage_cleared) {
             game_system->stage_clear = true;
             
             // Add score to ranking when game is completed (stage 3)
-            if (game_system->current_stage >= 3) {                
+            if (game_system->world.stage >= 3) {                
                 // Transition to stage complete state instead of directly adding to ranking
                 game_system->current_state = STATE_STAGE_COMPLETE;
                 switch_audio_for_state(STATE_STAGE_COMPLETE);
-                printf("Game completed! Final score %d\n", (int)game_system->score);
+                printf("Game completed! Final score %d\n", (int)game_system->world.score);
                 
                 game_system->stage_clear_timer = -1.0; // Infinite wait for click
             } else {
@@ -680,55 +811,148 @@ void update_game_state(ALLEGRO_EVENT* event, GameSystem* game_system) {
     if (game_system->stage_clear) {
         // Only update timer if it's not waiting for click (-1.0)
         if (game_system->stage_clear_timer > 0) {
-            game_system->stage_clear_timer -= 1.0 / 60.0;
+            game_system->stage_clear_timer -= dt;
         }
         
         // Always animate scale for visual effect
         static double animation_time = 0.0;
-        animation_time += 1.0 / 60.0;
+        animation_time += dt;
         game_system->stage_clear_scale = 1.0 + 0.2 * sin(animation_time * 3.14);
         
         // Auto advance only if timer runs out (for old U-key triggers)
         if (game_system->stage_clear_timer > 0 && game_system->stage_clear_timer <= 0) {
             // Stage 3 clear -> Game End processing
-            if (game_system->current_stage >= 3) {
+            if (game_system->world.stage >= 3) {
                 game_system->current_state = STATE_MENU;
                 game_system->stage_clear = false;
                 return;
             }
 
             // Move to next stage
-            game_system->stage_clear = false;
-            game_system->current_stage++;
-
-            char map_file[256];
-            snprintf(map_file, sizeof(map_file), "TankBoy/resources/stages/stage%d.csv", game_system->current_stage);
-            if (!map_load(&game_system->current_map, map_file))
-                map_init(&game_system->current_map);
-
-            tank_init(&game_system->player_tank, 50.0, 480.0);
+            advance_to_next_stage(game_system);
         }
         // For new auto-clear, wait for click (timer = -1.0)
     }
 
     // Handle Game Over animation
     if (game_system->game_over) {
-        game_system->game_over_timer += 1.0 / 60.0;
+        game_system->game_over_timer += dt;
         
         // Animate scale for visual effect
         static double game_over_animation_time = 0.0;
-        game_over_animation_time += 1.0 / 60.0;
+        game_over_animation_time += dt;
         game_system->game_over_scale = 1.0 + 0.3 * sin(game_over_animation_time * 4.0);
     }
 }
 
+// =================== Render Snapshot ===================
+
+// What a still screen shows; it is redrawn only when this changes
+typedef struct {
+    GameState state;
+    bool hovered[6];
+    bool clicked[6];
+    char name[sizeof(((TextInput*)0)->buffer)];
+    bool cursor_visible;
+} IdleView;
+
+static IdleView last_idle_view;
+
+static bool name_cursor_visible(void) {
+    return (long long)(al_get_time() / NAME_CURSOR_BLINK_PERIOD) % 2 == 0;
+}
+
+bool game_system_is_idle(const GameSystem* game_system) {
+    if (replay_is_playing()) return false;
+    switch (game_system->current_state) {
+    case STATE_MENU:
+    case STATE_RANKING:
+    case STATE_NAME_INPUT:
+    case STATE_STAGE_COMPLETE:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool game_system_view_changed(const GameSystem* game_system) {
+    const Button* buttons[6] = {
+        &game_system->start_button, &game_system->exit_button, &game_system->ranking_button,
+        &game_system->next_button, &game_system->menu_button, &game_system->ranking_page_button
+    };
+
+    IdleView view;
+    memset(&view, 0, sizeof(view)); // Padding too, for the memcmp
+    view.state = game_system->current_state;
+    for (int i = 0; i < 6; i++) {
+        view.hovered[i] = buttons[i]->hovered;
+        view.clicked[i] = buttons[i]->clicked;
+    }
+    memcpy(view.name, game_system->name_input.buffer, sizeof(view.name));
+    view.cursor_visible = game_system->current_state == STATE_NAME_INPUT && name_cursor_visible();
+
+    if (memcmp(&view, &last_idle_view, sizeof(view)) == 0) return false;
+    last_idle_view = view;
+    return true;
+}
+
+// Main thread: copy what the next frame draws; the render thread never sees live state
+void game_system_fill_snapshot(GameSystem* game_system, RenderSnapshot* snapshot) {
+    const World* world = &game_system->world;
+
+    // Stage complete layout; the mouse hit tests read these positions too
+    if (game_system->current_state == STATE_STAGE_COMPLETE) {
+        int button_y = game_system->config.buffer_height / 2 + 80;
+        game_system->ranking_page_button.y = button_y;
+        game_system->menu_button.y = button_y + game_system->config.button_spacing;
+    }
+
+    snapshot->state = game_system->current_state;
+    snapshot->idle = game_system_is_idle(game_system);
+    snapshot->stage_clear = game_system->stage_clear;
+    snapshot->stage_clear_waiting = game_system->stage_clear_timer < 0;
+    snapshot->game_over = game_system->game_over;
+    snapshot->start_button = game_system->start_button;
+    snapshot->exit_button = game_system->exit_button;
+    snapshot->ranking_button = game_system->ranking_button;
+    snapshot->next_button = game_system->next_button;
+    snapshot->menu_button = game_system->menu_button;
+    snapshot->ranking_page_button = game_system->ranking_page_button;
+    snapshot->name_input = game_system->name_input;
+    snapshot->cursor_visible = name_cursor_visible();
+    snapshot->hud = game_system->hud;
+    snapshot->ranking_count = 0;
+    if (game_system->current_state == STATE_RANKING) {
+        snapshot->ranking_count = ranking_copy_top(snapshot->rankings, RANKING_DISPLAY_COUNT);
+    }
+
+    snapshot->stage = world->stage;
+    snapshot->score = world->score;
+    snapshot->tank = world->tank;
+    memcpy(snapshot->bullets, world->bullets, sizeof(Bullet) * world->max_bullets);
+    snapshot->max_bullets = world->max_bullets;
+    memcpy(snapshot->enemies, world->enemies, sizeof(snapshot->enemies));
+    memcpy(snapshot->flying_enemies, world->flying_enemies, sizeof(snapshot->flying_enemies));
+
+    // The map only changes with the stage
+    if (snapshot->map_stage != world->stage && map_copy(&snapshot->map, &world->map)) {
+        snapshot->map_stage = world->stage;
+    }
+
+    snapshot->particle_bursts = game_system->particle_bursts;
+
+    snapshot->replay_playing = replay_is_playing();
+    snapshot->replay_ticks = replay_ticks_played();
+    snapshot->replay_speed = game_system->replay_speed;
+}
+
 // =================== Rendering ===================
 
-void disp_pre_draw(GameSystem* game_system) {
+void disp_pre_draw(const GameSystem* game_system) {
     al_set_target_bitmap(game_system->buffer);
 }
 
-void disp_post_draw(GameSystem* game_system) {
+void disp_post_draw(const GameSystem* game_system) {
     al_set_target_backbuffer(al_get_current_display());
     double w = game_system->config.buffer_width * game_system->config.display_scale;
     double h = game_system->config.buffer_height * game_system->config.display_scale;
@@ -736,12 +960,17 @@ void disp_post_draw(GameSystem* game_system) {
     al_flip_display();
 }
 
-static void draw_game(const GameSystem* game_system) {
+static void draw_game(const GameSystem* game_system, const RenderSnapshot* snapshot, double alpha) {
+    // Camera follows the interpolated tank so it stays locked to the drawn sprite
+    const Tank* tank = &snapshot->tank;
+    double camera_x = tank->prev_x + (tank->x - tank->prev_x) * alpha - game_system->config.buffer_width / 3.0;
+    double camera_y = tank->prev_y + (tank->y - tank->prev_y) * alpha - game_system->config.buffer_height / 2.0;
+
     al_clear_to_color(al_map_rgb(game_system->config.game_bg_r, game_system->config.game_bg_g, game_system->config.game_bg_b));
 
     // Draw background based on current stage
     ALLEGRO_BITMAP* current_bg = NULL;
-    switch (game_system->current_stage) {
+    switch (snapshot->stage) {
         case 1:
             current_bg = game_system->bg_green;
             break;
@@ -756,39 +985,38 @@ static void draw_game(const GameSystem* game_system) {
             break;
     }
     
-    // Draw background if loaded
-    if (current_bg) {
-        // Calculate background position to follow camera
-        int bg_width = al_get_bitmap_width(current_bg);
-        int bg_height = al_get_bitmap_height(current_bg);
-        
-        // Draw background with parallax effect (background moves slower than camera)
-        double bg_x = -(game_system->camera_x * 0.3); // Parallax factor
-        double bg_y = -(game_system->camera_y * 0.1); // Less vertical movement
-        
-        // Draw background tiles to cover the entire screen
-        for (int x = (int)bg_x - bg_width; x < game_system->config.buffer_width + bg_width; x += bg_width) {
-            for (int y = (int)bg_y - bg_height; y < game_system->config.buffer_height + bg_height; y += bg_height) {
-                al_draw_bitmap(current_bg, x, y, 0);
-            }
-        }
-    }
-
-    map_draw((const Map*)&game_system->current_map, game_system->camera_x, game_system->camera_y, game_system->config.buffer_width, game_system->config.buffer_height);
+    // Background with parallax (moves slower than the camera), from a pre-tiled strip
+    double bg_x = -(camera_x * 0.3); // Parallax factor
+    double bg_y = -(camera_y * 0.1); // Less vertical movement
+    background_draw_parallax(current_bg, bg_x, bg_y, game_system->config.buffer_width, game_system->config.buffer_height);
+
+    PROFILE_BEGIN(PROF_MAP_DRAW);
+    map_draw(&snapshot->map, camera_x, camera_y, game_system->config.buffer_width, game_system->config.buffer_height);
+    PROFILE_END(PROF_MAP_DRAW);
     
     // Only draw tank and game elements when not game over
-    if (!game_system->game_over) {
-        tank_draw(&game_system->player_tank, game_system->camera_x, game_system->camera_y);
-        enemies_draw(game_system->camera_x, game_system->camera_y);
-        flying_enemies_draw(game_system->camera_x, game_system->camera_y);
-        bullets_draw(game_system->bullets, game_system->max_bullets, game_system->camera_x, game_system->camera_y);
-        draw_enemy_hp_bars();
-        draw_flying_enemy_hp_bars();
+    if (!snapshot->game_over) {
+        PROFILE_BEGIN(PROF_ENTITY_DRAW);
+        tank_draw(&snapshot->tank, camera_x, camera_y, alpha);
+        enemies_draw(snapshot->enemies, camera_x, camera_y, alpha);
+        flying_enemies_draw(snapshot->flying_enemies, camera_x, camera_y, alpha);
+        bullets_draw(snapshot->bullets, snapshot->max_bullets, camera_x, camera_y, alpha);
+        draw_enemy_hp_bars(snapshot->enemies, camera_x, camera_y, alpha);
+        draw_flying_enemy_hp_bars(snapshot->flying_enemies, camera_x, camera_y, alpha);
+        PROFILE_END(PROF_ENTITY_DRAW);
     }
+
+    // Particles: spawn what this snapshot brought, step on frame time, one draw call
+    PROFILE_BEGIN(PROF_PARTICLES);
+    double now = al_get_time();
+    particles_spawn_new(&snapshot->particle_bursts, now);
+    particles_update(now, snapshot->tick_speed);
+    particles_draw(camera_x, camera_y, game_system->config.buffer_width, game_system->config.buffer_height);
+    PROFILE_END(PROF_PARTICLES);
     
     
 
-    if (game_system->game_over) {
+    if (snapshot->game_over) {
         // Game Over screen - draw over everything
         int cx = game_system->config.buffer_width / 2;
         int cy = game_system->config.buffer_height / 2;
@@ -802,43 +1030,44 @@ static void draw_game(const GameSystem* game_system) {
         
         // Final score display
         char score_text[64];
-        snprintf(score_text, sizeof(score_text), "Final Score: %d", (int)game_system->score);
+        snprintf(score_text, sizeof(score_text), "Final Score: %d", (int)snapshot->score);
         al_draw_text(game_system->font, al_map_rgb(255, 255, 255), cx, cy - 20, ALLEGRO_ALIGN_CENTER, score_text);
         
         // Stage reached
         char stage_text[64];
-        snprintf(stage_text, sizeof(stage_text), "Stage Reached: %d", game_system->current_stage);
+        snprintf(stage_text, sizeof(stage_text), "Stage Reached: %d", snapshot->stage);
         al_draw_text(game_system->font, al_map_rgb(255, 255, 255), cx, cy + 20, ALLEGRO_ALIGN_CENTER, stage_text);
         
         // Back to Menu button
-        draw_button(&game_system->menu_button, &game_system->config, game_system->font);
+        draw_button(&snapshot->menu_button, &game_system->config, game_system->font);
     }
-    else if (!game_system->stage_clear) {
-        head_up_display_draw(&game_system->hud);
-
+    else if (!snapshot->stage_clear) {
+        PROFILE_BEGIN(PROF_HUD_DRAW);
+        head_up_display_draw(&snapshot->hud);
+        PROFILE_END(PROF_HUD_DRAW);
     }
     else {
         int cx = game_system->config.buffer_width / 2;
         int cy = game_system->config.buffer_height / 2;
 
-        if (game_system->current_stage >= 3) {  // Ending when Stage 3 is cleared
+        if (snapshot->stage >= 3) {  // Ending when Stage 3 is cleared
             al_draw_text(game_system->font, al_map_rgb(255, 0, 0), cx, cy - 20, ALLEGRO_ALIGN_CENTER, "Congratulations! You won the game!");
             
             // Show final score
             char score_text[64];
-            snprintf(score_text, sizeof(score_text), "Final Score: %d", (int)game_system->score);
+            snprintf(score_text, sizeof(score_text), "Final Score: %d", (int)snapshot->score);
             al_draw_text(game_system->font, al_map_rgb(255, 255, 255), cx, cy + 20, ALLEGRO_ALIGN_CENTER, score_text);
             
             // Show health bonus info
             char health_bonus_text[64];
-            int current_hp = get_tank_hp();
+            int current_hp = snapshot->tank.hp;
             int health_bonus = current_hp * 10;            
             snprintf(health_bonus_text, sizeof(health_bonus_text), "Health Bonus: +%d", health_bonus);
             al_draw_text(game_system->font, al_map_rgb(0, 255, 0), cx, cy + 50, ALLEGRO_ALIGN_CENTER, health_bonus_text);
             
             // Show Back to Menu button for game end
-            if (game_system->stage_clear_timer < 0) {
-                draw_button(&game_system->next_button, &game_system->config, game_system->font);
+            if (snapshot->stage_clear_waiting) {
+                draw_button(&snapshot->next_button, &game_system->config, game_system->font);
             }
         }
         else {
@@ -846,82 +1075,36 @@ static void draw_game(const GameSystem* game_system) {
             
             // Show current score
             char score_text[64];
-            snprintf(score_text, sizeof(score_text), "Score: %d", (int)game_system->score);
+            snprintf(score_text, sizeof(score_text), "Score: %d", (int)snapshot->score);
             al_draw_text(game_system->font, al_map_rgb(255, 255, 255), cx, cy + 40, ALLEGRO_ALIGN_CENTER, score_text);
             
             // Show health bonus info
             char health_bonus_text[64];
-            int current_hp = get_tank_hp();
+            int current_hp = snapshot->tank.hp;
             int health_bonus = current_hp * 10;
             
             snprintf(health_bonus_text, sizeof(health_bonus_text), "Health Bonus: +%d", health_bonus);
             al_draw_text(game_system->font, al_map_rgb(0, 255, 0), cx, cy + 70, ALLEGRO_ALIGN_CENTER, health_bonus_text);
             
             // Show Next button if waiting for click
-            if (game_system->stage_clear_timer < 0) {
-                draw_button(&game_system->next_button, &game_system->config, game_system->font);
+            if (snapshot->stage_clear_waiting) {
+                draw_button(&snapshot->next_button, &game_system->config, game_system->font);
             }
         }
     }
 }
 
-void render_game(GameSystem* game_system) {
+void render_game(const GameSystem* game_system, const RenderSnapshot* snapshot, double alpha) {
     disp_pre_draw(game_system);
-    if (game_system->current_state == STATE_MENU) draw_menu(game_system);
-    else if (game_system->current_state == STATE_RANKING) {
+    if (snapshot->state == STATE_MENU) draw_menu(game_system, snapshot);
+    else if (snapshot->state == STATE_RANKING) {
         // Draw ranking screen with background
-        if (game_system->ranking_bg) {
-            // Scale background to fill the entire buffer (crop if necessary)
-            int bg_width = al_get_bitmap_width(game_system->ranking_bg);
-            int bg_height = al_get_bitmap_height(game_system->ranking_bg);
-            
-            // Calculate scaling to fill the buffer completely (may crop parts of the image)
-            float scale_x = (float)game_system->config.buffer_width / bg_width;
-            float scale_y = (float)game_system->config.buffer_height / bg_height;
-            float scale = (scale_x > scale_y) ? scale_x : scale_y; // Use the larger scale to fill
-            
-            // Calculate scaled dimensions
-            int scaled_width = (int)(bg_width * scale);
-            int scaled_height = (int)(bg_height * scale);
-            
-            // Calculate position to center the image (may be negative if image is larger than buffer)
-            int x = (game_system->config.buffer_width - scaled_width) / 2;
-            int y = (game_system->config.buffer_height - scaled_height) / 2;
-            
-            al_draw_scaled_bitmap(game_system->ranking_bg, 0, 0, bg_width, bg_height, 
-                                  x, y, scaled_width, scaled_height, 0);
-        } else {
-            // Fallback to solid color if background not loaded
-            al_clear_to_color(al_map_rgb(game_system->config.menu_bg_r, game_system->config.menu_bg_g, game_system->config.menu_bg_b));
-        }
-        ranking_draw(game_system->camera_x, game_system->camera_y);
+        draw_screen_background(game_system, game_system->ranking_bg);
+        ranking_draw(snapshot->rankings, snapshot->ranking_count);
     }
-    else if (game_system->current_state == STATE_STAGE_COMPLETE) {
+    else if (snapshot->state == STATE_STAGE_COMPLETE) {
         // Draw stage complete screen with intro background
-        if (game_system->intro_bg) {
-            // Scale background to fill the entire buffer (crop if necessary)
-            int bg_width = al_get_bitmap_width(game_system->intro_bg);
-            int bg_height = al_get_bitmap_height(game_system->intro_bg);
-            
-            // Calculate scaling to fill the buffer completely (may crop parts of the image)
-            float scale_x = (float)game_system->config.buffer_width / bg_width;
-            float scale_y = (float)game_system->config.buffer_height / bg_height;
-            float scale = (scale_x > scale_y) ? scale_x : scale_y; // Use the larger scale to fill
-            
-            // Calculate scaled dimensions
-            int scaled_width = (int)(bg_width * scale);
-            int scaled_height = (int)(bg_height * scale);
-            
-            // Calculate position to center the image (may be negative if image is larger than buffer)
-            int x = (game_system->config.buffer_width - scaled_width) / 2;
-            int y = (game_system->config.buffer_height - scaled_height) / 2;
-            
-            al_draw_scaled_bitmap(game_system->intro_bg, 0, 0, bg_width, bg_height, 
-                                  x, y, scaled_width, scaled_height, 0);
-        } else {
-            // Fallback to solid color if background not loaded
-            al_clear_to_color(al_map_rgb(game_system->config.menu_bg_r, game_system->config.menu_bg_g, game_system->config.menu_bg_b));
-        }
+        draw_screen_background(game_system, game_system->intro_bg);
         
         int cx = game_system->config.buffer_width / 2;
         int cy = game_system->config.buffer_height / 2;
@@ -932,48 +1115,21 @@ void render_game(GameSystem* game_system) {
         
         // Final score display
         char score_text[64];
-        snprintf(score_text, sizeof(score_text), "Final Score: %d", (int)game_system->score);
+        snprintf(score_text, sizeof(score_text), "Final Score: %d", (int)snapshot->score);
         al_draw_text(game_system->font, al_map_rgb(255, 255, 0), cx, cy - 30, ALLEGRO_ALIGN_CENTER, score_text);
         
         // Stage display
         char stage_text[64];
-        snprintf(stage_text, sizeof(stage_text), "Stages Completed: %d", game_system->current_stage);
+        snprintf(stage_text, sizeof(stage_text), "Stages Completed: %d", snapshot->stage);
         al_draw_text(game_system->font, al_map_rgb(255, 255, 255), cx, cy, ALLEGRO_ALIGN_CENTER, stage_text);
         
-        // Buttons
-        int button_y = cy + 80;
-        game_system->ranking_page_button.y = button_y;
-        game_system->menu_button.y = button_y + game_system->config.button_spacing;
-        
-        draw_button(&game_system->ranking_page_button, &game_system->config, game_system->font);
-        draw_button(&game_system->menu_button, &game_system->config, game_system->font);
+        // Buttons (laid out by game_system_fill_snapshot)
+        draw_button(&snapshot->ranking_page_button, &game_system->config, game_system->font);
+        draw_button(&snapshot->menu_button, &game_system->config, game_system->font);
     }
-    else if (game_system->current_state == STATE_NAME_INPUT) {
+    else if (snapshot->state == STATE_NAME_INPUT) {
         // Draw name input screen with intro background
-        if (game_system->intro_bg) {
-            // Scale background to fill the entire buffer (crop if necessary)
-            int bg_width = al_get_bitmap_width(game_system->intro_bg);
-            int bg_height = al_get_bitmap_height(game_system->intro_bg);
-            
-            // Calculate scaling to fill the buffer completely (may crop parts of the image)
-            float scale_x = (float)game_system->config.buffer_width / bg_width;
-            float scale_y = (float)game_system->config.buffer_height / bg_height;
-            float scale = (scale_x > scale_y) ? scale_x : scale_y; // Use the larger scale to fill
-            
-            // Calculate scaled dimensions
-            int scaled_width = (int)(bg_width * scale);
-            int scaled_height = (int)(bg_height * scale);
-            
-            // Calculate position to center the image (may be negative if image is larger than buffer)
-            int x = (game_system->config.buffer_width - scaled_width) / 2;
-            int y = (game_system->config.buffer_height - scaled_height) / 2;
-            
-            al_draw_scaled_bitmap(game_system->intro_bg, 0, 0, bg_width, bg_height, 
-                                  x, y, scaled_width, scaled_height, 0);
-        } else {
-            // Fallback to solid color if background not loaded
-            al_clear_to_color(al_map_rgb(game_system->config.menu_bg_r, game_system->config.menu_bg_g, game_system->config.menu_bg_b));
-        }
+        draw_screen_background(game_system, game_system->intro_bg);
         
         int cx = game_system->config.buffer_width / 2;
         int cy = game_system->config.buffer_height / 2;
@@ -983,12 +1139,12 @@ void render_game(GameSystem* game_system) {
         
         // Score display
         char score_text[64];
-        snprintf(score_text, sizeof(score_text), "Score: %d", (int)game_system->score);
+        snprintf(score_text, sizeof(score_text), "Score: %d", (int)snapshot->score);
         al_draw_text(game_system->font, al_map_rgb(255, 255, 0), cx, cy - 50, ALLEGRO_ALIGN_CENTER, score_text);
         
         // Stage display
         char stage_text[64];
-        snprintf(stage_text, sizeof(stage_text), "Stage: %d", game_system->current_stage);
+        snprintf(stage_text, sizeof(stage_text), "Stage: %d", snapshot->stage);
         al_draw_text(game_system->font, al_map_rgb(255, 255, 0), cx, cy - 20, ALLEGRO_ALIGN_CENTER, stage_text);
         
         // Name input box with better visual feedback
@@ -1000,18 +1156,15 @@ void render_game(GameSystem* game_system) {
         al_draw_rectangle(input_x, input_y, input_x + 300, input_y + 30, al_map_rgb(255, 255, 255), 2);
         
         // Draw current text
-        if (strlen(game_system->name_input.buffer) > 0) {
-            al_draw_text(game_system->font, al_map_rgb(255, 255, 255), input_x + 5, input_y + 5, 0, game_system->name_input.buffer);
+        if (strlen(snapshot->name_input.buffer) > 0) {
+            al_draw_text(game_system->font, al_map_rgb(255, 255, 255), input_x + 5, input_y + 5, 0, snapshot->name_input.buffer);
         } else {
             al_draw_text(game_system->font, al_map_rgb(128, 128, 128), input_x + 5, input_y + 5, 0, "Type your name : ");
         }
         
-        // Draw cursor (blinking)
-        static double cursor_timer = 0;
-        cursor_timer += 0.016; // Assuming 60 FPS
-        
-        if ((int)(cursor_timer * 2) % 2 == 0) {
-            int cursor_x = input_x + 5 + al_get_text_width(game_system->font, game_system->name_input.buffer);
+        // Draw cursor (blinking, phase taken on the main thread)
+        if (snapshot->cursor_visible) {
+            int cursor_x = input_x + 5 + al_get_text_width(game_system->font, snapshot->name_input.buffer);
             al_draw_line(cursor_x, input_y + 5, cursor_x, input_y + 25, al_map_rgb(255, 255, 255), 2);
         }
         
@@ -1021,33 +1174,21 @@ void render_game(GameSystem* game_system) {
         
         // Show current input length
         char length_text[64];
-        snprintf(length_text, sizeof(length_text), "Characters: %d/%d", (int)strlen(game_system->name_input.buffer), game_system->name_input.max_length);
+        snprintf(length_text, sizeof(length_text), "Characters: %d/%d", (int)strlen(snapshot->name_input.buffer), snapshot->name_input.max_length);
         al_draw_text(game_system->font, al_map_rgb(150, 150, 150), cx, cy + 140, ALLEGRO_ALIGN_CENTER, length_text);
     }
-    else if (game_system->current_state == STATE_GAME || game_system->current_state == STATE_GAME_OVER) draw_game(game_system);
-    disp_post_draw(game_system);
-}
+    else if (snapshot->state == STATE_GAME || snapshot->state == STATE_GAME_OVER) draw_game(game_system, snapshot, alpha);
 
-// ================= Score System =================
+    if (snapshot->replay_playing) draw_replay_status(game_system, snapshot);
 
-static GameSystem* global_game_system = NULL; // For enemy kill scoring
+#ifdef TANKBOY_PROFILE
+    // Profiler overlay goes on top of everything, HUD included
+    profiler_overlay_draw(8, 8);
+#endif
 
-void set_global_game_system(GameSystem* gs) {
-    global_game_system = gs;
-}
-
-void add_score_for_enemy_kill(int difficulty) {
-    if (!global_game_system) return;
-    
-    int score_points = 0;
-    switch (difficulty) {
-        case 1: score_points = 500; break;
-        case 2: score_points = 1000; break;
-        case 3: score_points = 1500; break;
-        default: score_points = 500; break; // Default to level 1 score
-    }
-    
-    global_game_system->score += score_points;
+    PROFILE_BEGIN(PROF_DISP_POST_DRAW);
+    disp_post_draw(game_system);
+    PROFILE_END(PROF_DISP_POST_DRAW);
 }
 
 // ================= Audio Management =================
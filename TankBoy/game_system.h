@@ -14,9 +14,26 @@
 #include "input_system.h"   // Keyboard and mouse input handling
 #include "head_up_display.h" // HUD and UI display system
 #include "audio.h"           // Audio system for BGM
+#include "rng.h"             // Deterministic random numbers
+#include "world.h"           // Simulation state and fixed-tick step
+#include "ranking.h"         // High score table
+#include "particles.h"       // Explosion and impact effects
 
 // MAX_BULLETS is now loaded from config.ini
 
+// Fixed simulation tick; velocities are tuned in pixels per tick at this rate
+#define SIM_TICK_RATE 60
+#define SIM_DT (1.0 / SIM_TICK_RATE)
+#define SIM_MAX_STEPS_PER_FRAME 5   // Catch-up limit after a stall (drops the rest)
+
+// Replay playback speeds (keys 1-5); uncapped runs as many ticks as fit in a frame
+#define REPLAY_SPEED_COUNT 5
+#define REPLAY_SPEED_DEFAULT 1      // 1x
+#define REPLAY_SPEED_UNCAPPED 0.0
+
+// Name input cursor: on/off half period (blinks at 2 Hz, also the idle wake-up timer)
+#define NAME_CURSOR_BLINK_PERIOD 0.5
+
 typedef struct {
     // Display buffer settings
     int buffer_width;
@@ -40,6 +57,8 @@ typedef struct {
     int game_speed;
     int max_lives;
     int max_bullets;
+    unsigned long long rng_seed; // 0 = seed from the clock
+    int replay_keyframe_seconds; // Keyframe spacing for replay seeking
     
     // Font settings
     char font_file[256];
@@ -83,23 +102,13 @@ typedef struct {
     GameConfig config;        // Game configuration settings
     ALLEGRO_BITMAP* buffer;  // Off-screen rendering buffer
 
-    // Player & Input
-    Tank player_tank;         // Player tank character
+    // Simulation (map, tank, bullets, camera, rng, round and score)
+    World world;
+
+    // Input
     InputState input;         // Input system state
     TextInput name_input;     // Text input for player name
 
-    // Bullet System
-    Bullet* bullets;          // Dynamic bullet array
-    int max_bullets;          // Maximum number of bullets
-
-    // Camera System
-    double camera_x, camera_y; // Camera position for viewport
-
-    // Map & Stage System
-    Map current_map;          // Current stage map
-    SpawnPoints spawn_points; // Current stage spawn points
-    int current_stage;        // Current stage number
-
     // HUD System
     Head_Up_Display_Data hud; // Heads-up display data
     
@@ -113,37 +122,82 @@ typedef struct {
     // Fonts
     ALLEGRO_FONT* title_font;   // Large font for titles
     
-    // Enemy System
-    int round_number;         // Current round number
-    bool enemies_spawned;     // Enemy spawn flag
-
     // Stage Clear & Score System
     bool stage_clear;         // Stage clear flag
     double stage_clear_timer; // Stage clear animation timer
     double stage_clear_scale; // Stage clear animation scale
-    double score;             // Current score
     double displayed_score;   // Score displayed in HUD
     
     // Game Over System
     bool game_over;           // Game over flag
     double game_over_timer;   // Game over animation timer
     double game_over_scale;   // Game over animation scale
+
+    // Replay Playback
+    int replay_speed;         // Index into the playback speed table
+
+    // Effects (spawned and drawn by the render thread)
+    ParticleBurstLog particle_bursts;
 } GameSystem;
 
+// Everything one frame needs, copied from the GameSystem on the main thread and
+// drawn by the render thread (render_thread.h). Nothing in here points into live
+// game state; bitmaps and fonts are loaded once at init and never change.
+typedef struct {
+    bool valid;               // Filled at least once
+    bool idle;                // Still screen: drawn once per publish, not per refresh
+
+    // Screen & UI
+    GameState state;
+    bool stage_clear;
+    bool stage_clear_waiting; // Clear screen is waiting for the Next click
+    bool game_over;
+    Button start_button, exit_button, ranking_button;
+    Button next_button, menu_button, ranking_page_button;
+    TextInput name_input;
+    bool cursor_visible;      // Name input cursor blink phase
+    RankingEntry rankings[RANKING_DISPLAY_COUNT];
+    int ranking_count;
+    Head_Up_Display_Data hud;
+
+    // World
+    int stage;
+    double score;
+    Tank tank;
+    Bullet* bullets;          // max_bullets entries, owned by the snapshot
+    int max_bullets;
+    Enemy enemies[MAX_ENEMIES];
+    FlyingEnemy flying_enemies[MAX_FLY_ENEMIES];
+    Map map;                  // Own copy, refreshed when the stage changes
+    int map_stage;            // Stage the map copy was taken from (0 = none yet)
+    ParticleBurstLog particle_bursts;
+
+    // Replay status line
+    bool replay_playing;
+    unsigned long long replay_ticks;
+    int replay_speed;
+
+    // Interpolation: alpha when published, advanced by the render thread's clock
+    double alpha;
+    double publish_time;
+    double tick_speed;        // Playback speed; 0 = uncapped (no extrapolation)
+} RenderSnapshot;
+
 // ================= Core Functions =================
 void load_game_config(GameConfig* config, const char* config_file);                    // Load game configuration from INI file
 void init_game_system(ALLEGRO_DISPLAY* display, ALLEGRO_EVENT_QUEUE* queue, GameSystem* game_system); // Initialize game system
 void cleanup_game_system(GameSystem* game_system, ALLEGRO_EVENT_QUEUE* queue, ALLEGRO_DISPLAY* display); // Cleanup game system
-void update_game_state(ALLEGRO_EVENT* event, GameSystem* game_system);                // Update game state based on events
-void render_game(GameSystem* game_system);                                            // Render current game state
+void update_game_state(ALLEGRO_EVENT* event, GameSystem* game_system);                // Handle input and UI events
+void game_system_step(GameSystem* game_system, double dt);                            // Advance the simulation by one fixed tick
+void game_system_fill_snapshot(GameSystem* game_system, RenderSnapshot* snapshot);    // Copy what the next frame draws (main thread)
+void render_game(const GameSystem* game_system, const RenderSnapshot* snapshot, double alpha); // Draw a snapshot, alpha = 0..1 between its last two ticks
+double game_system_playback_speed(const GameSystem* game_system);                     // Sim speed multiplier (1 live, REPLAY_SPEED_UNCAPPED = as fast as possible)
+bool game_system_is_idle(const GameSystem* game_system);                              // Still screen (menu, ranking, name input...): no ticks, redraw on change only
+bool game_system_view_changed(const GameSystem* game_system);                         // Idle screen looks different since the last call (hover, text, state, blink)
 
 // ================= Buffer Handling =================
-void disp_pre_draw(GameSystem* game_system);                                          // Set up off-screen buffer for rendering
-void disp_post_draw(GameSystem* game_system);                                         // Display rendered buffer and flip screen
-
-// ================= Score System =================
-void set_global_game_system(GameSystem* gs);                                         // Set global game system reference for scoring
-void add_score_for_enemy_kill(int difficulty);                                       // Add score when enemy is killed
+void disp_pre_draw(const GameSystem* game_system);                                    // Set up off-screen buffer for rendering
+void disp_post_draw(const GameSystem* game_system);                                   // Display rendered buffer and flip screen
 
 // ================= Audio Management =================
 void switch_audio_for_state(GameState new_state);                                    // Switch audio based on game state
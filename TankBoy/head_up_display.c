@@ -1,7 +1,7 @@
 #include "head_up_display.h"
 #include "ini_parser.h"
 #include "enemy.h"
-#include "tank.h"
+#include "number_font.h"
 #include <allegro5/allegro_font.h>
 #include <allegro5/allegro_ttf.h>
 #include <allegro5/allegro_primitives.h>
@@ -9,6 +9,8 @@
 
 // HUD font
 static ALLEGRO_FONT* hud_font = NULL;
+static NumberFont hud_numbers; // Digit atlas of hud_font, built on first draw
+static bool hud_numbers_built = false;
 
 // Internal state
 static int current_hp = 100;
@@ -119,32 +121,57 @@ Head_Up_Display_Data head_up_display_update(int score, int weapon, int stage) {
     return hud;
 }
 
-// HUD draw
-void head_up_display_draw(const Head_Up_Display_Data* hud) {
-    if (!hud) {
-        return;
-    }
-    
-    if (!hud_font) {
-        return;
-    }
-
-    // Weapon name
-    const char* weapon_name = "Unknown";
-    switch (hud->weapon) {
-    case 0: weapon_name = "Machine Gun"; break;
-    case 1: weapon_name = "Cannon"; break;
-    }
+// ===== Cached HUD Layer =====
+
+// The HUD is drawn into its own bitmap, each element only when its values change,
+// and composited with one blit. A changed element is cleared by the rectangle it
+// last covered, so elements must not overlap (they don't at the config positions).
+
+typedef enum {
+    HUD_SCORE,
+    HUD_STAGE,
+    HUD_HP,
+    HUD_ENEMIES,
+    HUD_ROUND,
+    HUD_WEAPON,
+    HUD_ELEMENT_COUNT
+} HudElement;
+
+typedef struct {
+    int x, y, w, h;
+} HudRect;
+
+typedef struct {
+    bool drawn;
+    int values[2];   // What the element shows (HP uses both: hp, max)
+    HudRect rect;    // Area it covers in the layer
+} HudElementCache;
+
+static ALLEGRO_BITMAP* hud_layer = NULL;
+static HudElementCache hud_cache[HUD_ELEMENT_COUNT];
+
+static HudRect rect_union(HudRect a, HudRect b) {
+    int x0 = a.x < b.x ? a.x : b.x;
+    int y0 = a.y < b.y ? a.y : b.y;
+    int x1 = a.x + a.w > b.x + b.w ? a.x + a.w : b.x + b.w;
+    int y1 = a.y + a.h > b.y + b.h ? a.y + a.h : b.y + b.h;
+    HudRect r = { x0, y0, x1 - x0, y1 - y0 };
+    return r;
+}
 
-    // HUD text using config positions
-    al_draw_textf(hud_font, hud_text_color, hud_settings.hud_score_x, hud_settings.hud_score_y, 0,
-        "Score  : %d", hud->score);
-    al_draw_textf(hud_font, hud_text_color, hud_settings.hud_stage_x, hud_settings.hud_stage_y, 0,
-        "Stage: %d", hud->stage);
+// Fixed label through the font, the number from the digit atlas
+static HudRect draw_hud_number(int x, int y, const char* label, int value) {
+    al_draw_text(hud_font, hud_text_color, x, y, 0, label);
+    int label_width = al_get_text_width(hud_font, label);
+    int number_width = draw_number(&hud_numbers, hud_text_color, x + label_width, y, value);
+    HudRect r = { x, y, label_width + number_width, al_get_font_line_height(hud_font) };
+    return r;
+}
 
+static HudRect draw_hp_bar(int hp, int max_hp) {
     // Health bar using config positions
     int bar_x = hud_settings.hud_hp_x, bar_y = hud_settings.hud_hp_y, bar_w = 200, bar_h = 20;
-    double ratio = hud->player_hp / 100.0;
+    double ratio = hp / 100.0;
     if (ratio < 0) ratio = 0;
     if (ratio > 1) ratio = 1;
 
@@ -153,7 +180,7 @@ void head_up_display_draw(const Head_Up_Display_Data* hud) {
         hud_border_color, 2);
 
     // Fill
-    if (hud->player_hp > 0) {
+    if (hp > 0) {
         al_draw_filled_rectangle(bar_x + 1, bar_y + 1,
             bar_x + (int)(bar_w * ratio) - 1,
             bar_y + bar_h - 1,
@@ -162,38 +189,42 @@ void head_up_display_draw(const Head_Up_Display_Data* hud) {
 
     // Health text in the center of the bar
     char hp_text[32];
-    snprintf(hp_text, sizeof(hp_text), "%d / %d", hud->player_hp, hud->player_max_hp);
-    int text_width = al_get_text_width(hud_font, hp_text);
+    snprintf(hp_text, sizeof(hp_text), "%d / %d", hp, max_hp);
+    int text_width = number_font_text_width(&hud_numbers, hp_text);
+    int line_height = al_get_font_line_height(hud_font);
     int text_x = bar_x + (bar_w - text_width) / 2;
-    int text_y = bar_y + (bar_h - al_get_font_line_height(hud_font)) / 2;
+    int text_y = bar_y + (bar_h - line_height) / 2;
     
-    // Draw text with black outline for better visibility
-    al_draw_text(hud_font, al_map_rgb(0, 0, 0), text_x - 1, text_y, 0, hp_text);
-    al_draw_text(hud_font, al_map_rgb(0, 0, 0), text_x + 1, text_y, 0, hp_text);
-    al_draw_text(hud_font, al_map_rgb(0, 0, 0), text_x, text_y - 1, 0, hp_text);
-    al_draw_text(hud_font, al_map_rgb(0, 0, 0), text_x, text_y + 1, 0, hp_text);
+    // Draw text with black outline for better visibility (all five passes in one batch)
+    al_hold_bitmap_drawing(true);
+    number_font_draw_text(&hud_numbers, al_map_rgb(0, 0, 0), text_x - 1, text_y, hp_text);
+    number_font_draw_text(&hud_numbers, al_map_rgb(0, 0, 0), text_x + 1, text_y, hp_text);
+    number_font_draw_text(&hud_numbers, al_map_rgb(0, 0, 0), text_x, text_y - 1, hp_text);
+    number_font_draw_text(&hud_numbers, al_map_rgb(0, 0, 0), text_x, text_y + 1, hp_text);
     
     // Draw the main text
-    al_draw_text(hud_font, hud_text_color, text_x, text_y, 0, hp_text);
-        
-    // Enemy count display - total enemies using config positions
-    int total_enemies = hud->enemies_alive + hud->flying_enemies_alive;
-    al_draw_textf(hud_font, hud_text_color, hud_settings.hud_enemies_x, hud_settings.hud_enemies_y, 0,
-        "Enemies: %d", total_enemies);
-    
-    // Round display using config positions
-    al_draw_textf(hud_font, hud_text_color, hud_settings.hud_round_x, hud_settings.hud_round_y, 0,
-        "Round  : %d", hud->round);
-    
-    // draw sprites    
-    if (weapon_name == "Machine Gun") {
+    number_font_draw_text(&hud_numbers, hud_text_color, text_x, text_y, hp_text);
+    al_hold_bitmap_drawing(false);
+
+    HudRect bar = { bar_x - 1, bar_y - 1, bar_w + 3, bar_h + 3 };
+    HudRect text = { text_x - 1, text_y - 1, text_width + 2, line_height + 2 };
+    return rect_union(bar, text);
+}
+
+static HudRect draw_weapon_icon(int weapon) {
+    HudRect r = { 0, 0, 0, 0 };
+    if (weapon == 0 && hud_sprites.tank_bullet_sheet) {
         int width = al_get_bitmap_width(hud_sprites.tank_bullet_sheet);
         int height = al_get_bitmap_height(hud_sprites.tank_bullet_sheet);
         al_draw_scaled_bitmap(hud_sprites.tank_bullet_sheet, 0, 0, width, height,  
                             hud_settings.hud_weapon_x, hud_settings.hud_weapon_y,  // draw position 
                             hud_settings.hud_weapon_width, hud_settings.hud_weapon_height, 
                             0);
-    } else if (weapon_name == "Cannon") {
+        r.x = hud_settings.hud_weapon_x;
+        r.y = hud_settings.hud_weapon_y;
+        r.w = hud_settings.hud_weapon_width;
+        r.h = hud_settings.hud_weapon_height;
+    } else if (weapon == 1 && hud_sprites.cannon_bullet_sheet) {
         int width = al_get_bitmap_width(hud_sprites.cannon_bullet_sheet);
         int height = al_get_bitmap_height(hud_sprites.cannon_bullet_sheet);
         al_draw_scaled_bitmap(hud_sprites.cannon_bullet_sheet, 0, 0,      // draw start position
@@ -201,55 +232,156 @@ void head_up_display_draw(const Head_Up_Display_Data* hud) {
                             hud_settings.hud_weapon_x + (hud_settings.hud_weapon_width/2), hud_settings.hud_weapon_y,  // draw position
                             hud_settings.hud_weapon_height*1.5, hud_settings.hud_weapon_height*1.5,  // draw size   
                             0);
-    }   
+        r.x = hud_settings.hud_weapon_x + (hud_settings.hud_weapon_width/2);
+        r.y = hud_settings.hud_weapon_y;
+        r.w = r.h = (int)(hud_settings.hud_weapon_height*1.5) + 1;
+    }
+    return r;
 }
 
-// ===== Enemy HP Display Functions =====
+// Redraw one element if what it shows changed; false if it was already current
+static bool hud_refresh_element(HudElement element, int value, int value2) {
+    HudElementCache* cache = &hud_cache[element];
+    if (cache->drawn && cache->values[0] == value && cache->values[1] == value2) return false;
+
+    // Clear what the old value covered
+    if (cache->drawn && cache->rect.w > 0 && cache->rect.h > 0) {
+        al_set_clipping_rectangle(cache->rect.x, cache->rect.y, cache->rect.w, cache->rect.h);
+        al_clear_to_color(al_map_rgba(0, 0, 0, 0));
+        al_reset_clipping_rectangle();
+    }
+
+    switch (element) {
+    case HUD_SCORE:
+        cache->rect = draw_hud_number(hud_settings.hud_score_x, hud_settings.hud_score_y, "Score  : ", value);
+        break;
+    case HUD_STAGE:
+        cache->rect = draw_hud_number(hud_settings.hud_stage_x, hud_settings.hud_stage_y, "Stage: ", value);
+        break;
+    case HUD_HP:
+        cache->rect = draw_hp_bar(value, value2);
+        break;
+    case HUD_ENEMIES:
+        cache->rect = draw_hud_number(hud_settings.hud_enemies_x, hud_settings.hud_enemies_y, "Enemies: ", value);
+        break;
+    case HUD_ROUND:
+        cache->rect = draw_hud_number(hud_settings.hud_round_x, hud_settings.hud_round_y, "Round  : ", value);
+        break;
+    case HUD_WEAPON:
+        cache->rect = draw_weapon_icon(value);
+        break;
+    default:
+        break;
+    }
+
+    cache->drawn = true;
+    cache->values[0] = value;
+    cache->values[1] = value2;
+    return true;
+}
 
-void draw_enemy_hp_bars(void) {
-    Enemy* enemies = get_enemies();
+static void hud_layer_release(void) {
+    if (hud_layer) al_destroy_bitmap(hud_layer);
+    hud_layer = NULL;
+    for (int i = 0; i < HUD_ELEMENT_COUNT; i++) hud_cache[i].drawn = false;
+}
+
+// Layer the size of the target (the game buffer); rebuilt from scratch if that changes
+static bool hud_layer_ready(int width, int height) {
+    if (hud_layer && al_get_bitmap_width(hud_layer) == width && al_get_bitmap_height(hud_layer) == height) return true;
+
+    hud_layer_release();
+    hud_layer = al_create_bitmap(width, height);
+    if (!hud_layer) return false;
+
+    ALLEGRO_BITMAP* target = al_get_target_bitmap();
+    al_set_target_bitmap(hud_layer);
+    al_clear_to_color(al_map_rgba(0, 0, 0, 0));
+    al_set_target_bitmap(target);
+    return true;
+}
+
+// HUD draw
+void head_up_display_draw(const Head_Up_Display_Data* hud) {
+    if (!hud) {
+        return;
+    }
     
+    if (!hud_font) {
+        return;
+    }
+
+    // Atlas is a video bitmap: made here, on the thread that owns the display.
+    // If it fails the number calls fall back to the font.
+    if (!hud_numbers_built) {
+        number_font_build(&hud_numbers, hud_font);
+        hud_numbers_built = true;
+    }
+
+    ALLEGRO_BITMAP* target = al_get_target_bitmap();
+    if (!hud_layer_ready(al_get_bitmap_width(target), al_get_bitmap_height(target))) return;
+
+    // Bring the layer up to date (usually nothing to do)
+    al_set_target_bitmap(hud_layer);
+    hud_refresh_element(HUD_SCORE, hud->score, 0);
+    hud_refresh_element(HUD_STAGE, hud->stage, 0);
+    hud_refresh_element(HUD_HP, hud->player_hp, hud->player_max_hp);
+    hud_refresh_element(HUD_ENEMIES, hud->enemies_alive + hud->flying_enemies_alive, 0);
+    hud_refresh_element(HUD_ROUND, hud->round, 0);
+    hud_refresh_element(HUD_WEAPON, hud->weapon, 0);
+    al_set_target_bitmap(target);
+
+    al_draw_bitmap(hud_layer, 0, 0, 0);
+}
+
+void head_up_display_deinit(void) {
+    hud_layer_release();
+    number_font_destroy(&hud_numbers);
+    hud_numbers_built = false;
+}
+
+// ===== Enemy HP Display Functions =====
+
+void draw_enemy_hp_bars(const Enemy* enemies, double camera_x, double camera_y, double alpha) {
     for (int i = 0; i < MAX_ENEMIES; i++) {
-        Enemy* e = &enemies[i];
+        const Enemy* e = &enemies[i];
         if (!e->alive) continue;
         
         // Draw HP bar above enemy (using dynamic size)
         double hp_bar_width = e->width * 1.2; // HP bar width scales with enemy width
         if (hp_bar_width < 30.0) hp_bar_width = 30.0; // Minimum width
         if (hp_bar_width > 60.0) hp_bar_width = 60.0; // Maximum width
-        double hp_bar_x = e->x + (e->width - hp_bar_width) / 2; // Center HP bar above enemy
-        draw_hp_bar_world(hp_bar_x, e->y + e->height + 4, e->hp, e->max_hp, hp_bar_width);
+        double ex = e->prev_x + (e->x - e->prev_x) * alpha;
+        double ey = e->prev_y + (e->y - e->prev_y) * alpha;
+        double hp_bar_x = ex + (e->width - hp_bar_width) / 2; // Center HP bar above enemy
+        draw_hp_bar_world(hp_bar_x, ey + e->height + 4, e->hp, e->max_hp, hp_bar_width, camera_x, camera_y);
     }
 }
 
-void draw_flying_enemy_hp_bars(void) {
-    FlyingEnemy* f_enemies = get_flying_enemies();
-    
+void draw_flying_enemy_hp_bars(const FlyingEnemy* f_enemies, double camera_x, double camera_y, double alpha) {
     for (int i = 0; i < MAX_FLY_ENEMIES; i++) {
-        FlyingEnemy* fe = &f_enemies[i];
+        const FlyingEnemy* fe = &f_enemies[i];
         if (!fe->alive) continue;
         
         // Draw HP bar above flying enemy (using dynamic size)
         double hp_bar_width = fe->width * 1.2; // HP bar width scales with enemy width
         if (hp_bar_width < 30.0) hp_bar_width = 30.0; // Minimum width
         if (hp_bar_width > 60.0) hp_bar_width = 60.0; // Maximum width
-        double hp_bar_x = fe->x + (fe->width - hp_bar_width) / 2; // Center HP bar above enemy
-        draw_hp_bar_world(hp_bar_x, fe->y + fe->height + 4, fe->hp, fe->max_hp, hp_bar_width);
+        double fx = fe->prev_x + (fe->x - fe->prev_x) * alpha;
+        double fy = fe->prev_y + (fe->y - fe->prev_y) * alpha;
+        double hp_bar_x = fx + (fe->width - hp_bar_width) / 2; // Center HP bar above enemy
+        draw_hp_bar_world(hp_bar_x, fy + fe->height + 4, fe->hp, fe->max_hp, hp_bar_width, camera_x, camera_y);
     }
 }
 
 // ===== World-space HP Bar Drawing =====
 
-void draw_hp_bar_world(double wx, double wy, int hp, int hp_max, double bar_w) {
+void draw_hp_bar_world(double wx, double wy, int hp, int hp_max, double bar_w, double camera_x, double camera_y) {
     if (hp_max <= 0) return;
     if (hp < 0) hp = 0;
     if (hp > hp_max) hp = hp_max;
     double ratio = (double)hp / (double)hp_max;
 
-    // Get camera position for screen coordinates
-    double camera_x = get_camera_x();
-    double camera_y = get_camera_y();
-
     double sx = wx - camera_x;
     double sy = wy - camera_y;
 
@@ -4,6 +4,7 @@
 
 #include <allegro5/allegro5.h>
 #include <stdbool.h>
+#include "enemy.h"
 
 // HUD data structure
 typedef struct {
@@ -45,15 +46,16 @@ void head_up_display_init(const char* config_file);
 // HUD update
 Head_Up_Display_Data head_up_display_update(int score, int weapon, int stage);
 
-// HUD draw
+// HUD draw: one blit of a cached layer, redrawn per element when its values change
 void head_up_display_draw(const Head_Up_Display_Data* hud);
+void head_up_display_deinit(void); // Frees the layer and digit atlas (display current on the calling thread)
 
 // Enemy HP display functions
-void draw_enemy_hp_bars(void);
-void draw_flying_enemy_hp_bars(void);
+void draw_enemy_hp_bars(const Enemy* enemies, double camera_x, double camera_y, double alpha);
+void draw_flying_enemy_hp_bars(const FlyingEnemy* f_enemies, double camera_x, double camera_y, double alpha);
 
-// World-space HP bar drawing
-void draw_hp_bar_world(double wx, double wy, int hp, int hp_max, double bar_w);
+// World-space HP bar drawing (camera is the interpolated render camera)
+void draw_hp_bar_world(double wx, double wy, int hp, int hp_max, double bar_w, double camera_x, double camera_y);
 
 // HUD update functions
 void update_tank_hp_display(int new_hp);
@@ -0,0 +1,224 @@
+// Micro-benchmarks behind tankboy_headless --bench-* (see headless_bench.h).
+// Built by build_headless.sh only.
+
+// standard c library
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+// local library
+#include "headless_bench.h"
+#include "enemy.h"
+#include "world.h"
+#include "spatial_hash.h"
+#include "map_generation.h"
+
+#define BENCH_DT (1.0 / 60.0)  // Same fixed tick as the game
+
+// CPU time of this process (same clock as the replay runs)
+static double bench_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// ===== Helicopter Flight =====
+
+// The update as it was before the recurrence: two sin() calls per enemy per
+// tick and vx from a finite difference
+static void flight_libm_step(FlyingEnemy* fe, double* angle, double* x_angle, double dt) {
+    *angle += dt * FLY_BOB_RATE;
+    fe->y = fe->base_y + sin(*angle) * FLY_BOB_AMPLITUDE;
+
+    *x_angle += dt * FLY_PATROL_RATE;
+    double old_x = fe->x;
+    fe->x = fe->spawn_x + sin(*x_angle) * FLY_PATROL_AMPLITUDE;
+    fe->vx = (fe->x - old_x) / dt;
+
+    if (fe->vx > 0) fe->facing_right = true;
+    else if (fe->vx < 0) fe->facing_right = false;
+}
+
+int bench_flight(int count, long long ticks) {
+    if (count < 1) count = 1;
+    FlyingEnemy* libm_fleet = calloc((size_t)count, sizeof(FlyingEnemy));
+    FlyingEnemy* recurrence_fleet = calloc((size_t)count, sizeof(FlyingEnemy));
+    double* angles = calloc((size_t)count * 2, sizeof(double));
+    if (!libm_fleet || !recurrence_fleet || !angles) {
+        printf("Error: out of memory for %d helicopters\n", count);
+        free(libm_fleet); free(recurrence_fleet); free(angles);
+        return 1;
+    }
+
+    // Same fleet for both: spread over a wide strip, all in phase from spawn
+    for (int i = 0; i < count; i++) {
+        FlyingEnemy* fe = &libm_fleet[i];
+        fe->alive = true;
+        fe->spawn_x = fe->x = 200.0 + (i % 1000) * 40.0;
+        fe->base_y = fe->y = 100.0 + (i / 1000) * 60.0;
+        flying_enemy_reset_oscillators(fe);
+        recurrence_fleet[i] = *fe;
+    }
+
+    double start = bench_seconds();
+    for (long long t = 0; t < ticks; t++) {
+        for (int i = 0; i < count; i++) {
+            flight_libm_step(&libm_fleet[i], &angles[2 * i], &angles[2 * i + 1], BENCH_DT);
+        }
+    }
+    double libm_time = bench_seconds() - start;
+
+    start = bench_seconds();
+    for (long long t = 0; t < ticks; t++) {
+        // One step per pass, as in flying_enemies_update*
+        FlyOscillatorStep step = flying_enemy_oscillator_step(BENCH_DT);
+        for (int i = 0; i < count; i++) {
+            flying_enemy_fly(&recurrence_fleet[i], &step);
+        }
+    }
+    double recurrence_time = bench_seconds() - start;
+
+    // Both fleets flew the same path; how far apart did they end up?
+    double max_error = 0.0;
+    for (int i = 0; i < count; i++) {
+        double ex = fabs(libm_fleet[i].x - recurrence_fleet[i].x);
+        double ey = fabs(libm_fleet[i].y - recurrence_fleet[i].y);
+        if (ex > max_error) max_error = ex;
+        if (ey > max_error) max_error = ey;
+    }
+
+    double libm_us = ticks > 0 ? libm_time * 1e6 / ticks : 0.0;
+    double recurrence_us = ticks > 0 ? recurrence_time * 1e6 / ticks : 0.0;
+    printf("flight: %d helicopters, %lld ticks (CPU time)\n", count, ticks);
+    printf("  libm sin()          %8.1f us/tick\n", libm_us);
+    printf("  rotation recurrence %8.1f us/tick\n", recurrence_us);
+    printf("  max position difference %.3g px\n", max_error);
+    printf("RESULT bench=flight count=%d ticks=%lld libm_us=%.1f recurrence_us=%.1f max_error=%.3g\n",
+        count, ticks, libm_us, recurrence_us, max_error);
+
+    free(libm_fleet);
+    free(recurrence_fleet);
+    free(angles);
+    return 0;
+}
+
+// ===== Crowd Separation =====
+
+// Reference for spatial_hash_separation: every other ground enemy, no index
+static void separation_pairwise(const World* world, int self, double radius, double* out_x, double* out_y) {
+    const Enemy* me = &world->enemies[self];
+    double cx = me->x + me->width * 0.5, cy = me->y + me->height * 0.5;
+    double radius_sq = radius * radius;
+    double push_x = 0.0, push_y = 0.0;
+
+    for (int j = 0; j < MAX_ENEMIES; j++) {
+        const Enemy* e = &world->enemies[j];
+        if (j == self || !e->alive) continue;
+        double dx = cx - (e->x + e->width * 0.5), dy = cy - (e->y + e->height * 0.5);
+        double dist_sq = dx * dx + dy * dy;
+        if (dist_sq >= radius_sq) continue;
+        if (dist_sq < 1e-6) {
+            push_x += (self < j) ? -1.0 : 1.0;
+            continue;
+        }
+        double dist = sqrt(dist_sq);
+        double weight = 1.0 - dist / radius;
+        push_x += dx / dist * weight;
+        push_y += dy / dist * weight;
+    }
+
+    double len_sq = push_x * push_x + push_y * push_y;
+    if (len_sq > 1.0) {
+        double inv_len = 1.0 / sqrt(len_sq);
+        push_x *= inv_len;
+        push_y *= inv_len;
+    }
+    *out_x = push_x;
+    *out_y = push_y;
+}
+
+int bench_stress(World* world, int count, long long ticks) {
+    if (count > MAX_ENEMIES) {
+        printf("Warning: --stress %d capped at MAX_ENEMIES=%d, rebuild with STRESS=1\n", count, MAX_ENEMIES);
+        count = MAX_ENEMIES;
+    }
+    if (count < 1) count = 1;
+
+    world_load_stage(world, 1);
+    int map_width = map_get_map_width();
+    int map_height = map_get_map_height();
+
+    // Only the crowd: no helicopters, no waves, the whole map inside the update ROI
+    for (int i = 0; i < MAX_ENEMIES; i++) world->enemies[i].alive = false;
+    for (int i = 0; i < MAX_FLY_ENEMIES; i++) world->flying_enemies[i].alive = false;
+    world->camera_x = 0.0;
+    world->camera_y = 0.0;
+    world->view_width = map_width;
+    world->view_height = map_height;
+    world->tank.x = map_width * 0.5;
+
+    double strip = map_width - 200.0;
+    for (int i = 0; i < count; i++) {
+        Enemy* e = &world->enemies[i];
+        *e = world->tuning->ground_templates[1];
+        e->alive = true;
+        e->id = world->next_enemy_id++;
+        e->rng = rng_substream(&world->rng, e->id);
+        e->x = e->last_x = e->prev_x = 100.0 + strip * i / count;
+        e->y = e->prev_y = map_get_ground_level(&world->map, (int)e->x, e->width) - e->height;
+    }
+
+    double update_time = 0.0, hash_time = 0.0, pairwise_time = 0.0;
+    double max_push = 0.0, max_diff = 0.0, checksum = 0.0;
+    for (long long t = 0; t < ticks; t++) {
+        // Same order as world_step: build, then move
+        double start = bench_seconds();
+        spatial_hash_build_enemies(&world->spatial, world->enemies, world->flying_enemies);
+        enemies_update_roi(world, BENCH_DT);
+        update_time += bench_seconds() - start;
+
+        // Separation alone, both ways, over the positions just reached
+        spatial_hash_build_enemies(&world->spatial, world->enemies, world->flying_enemies);
+        double hash_x[MAX_ENEMIES], hash_y[MAX_ENEMIES];
+        start = bench_seconds();
+        for (int i = 0; i < count; i++) {
+            const Enemy* e = &world->enemies[i];
+            spatial_hash_separation(&world->spatial, SPATIAL_GROUND_ENEMY, i, e->x + e->width * 0.5, e->y + e->height * 0.5,
+                                    ENEMY_SEPARATION_RADIUS, &hash_x[i], &hash_y[i]);
+        }
+        hash_time += bench_seconds() - start;
+
+        start = bench_seconds();
+        for (int i = 0; i < count; i++) {
+            double px, py;
+            separation_pairwise(world, i, ENEMY_SEPARATION_RADIUS, &px, &py);
+            double diff = fabs(px - hash_x[i]) + fabs(py - hash_y[i]);
+            if (diff > max_diff) max_diff = diff;
+            double push = fabs(hash_x[i]) * ENEMY_SEPARATION_STRENGTH;
+            if (push > max_push) max_push = push;
+            checksum += px;
+        }
+        pairwise_time += bench_seconds() - start;
+    }
+
+    double min_x = map_width, max_x = 0.0;
+    for (int i = 0; i < count; i++) {
+        if (world->enemies[i].x < min_x) min_x = world->enemies[i].x;
+        if (world->enemies[i].x > max_x) max_x = world->enemies[i].x;
+    }
+
+    double update_us = ticks > 0 ? update_time * 1e6 / ticks : 0.0;
+    double hash_us = ticks > 0 ? hash_time * 1e6 / ticks : 0.0;
+    double pairwise_us = ticks > 0 ? pairwise_time * 1e6 / ticks : 0.0;
+    printf("stress: %d ground chasers on a %d px map, %lld ticks (CPU time)\n", count, map_width, ticks);
+    printf("  enemies_update_roi + build %8.1f us/tick\n", update_us);
+    printf("  separation via hash        %8.1f us/tick\n", hash_us);
+    printf("  separation pairwise        %8.1f us/tick\n", pairwise_us);
+    printf("  largest push %.2f px/tick (cap %.2f), hash vs pairwise max difference %.3g\n",
+        max_push, ENEMY_SEPARATION_STRENGTH, max_diff);
+    printf("  crowd spans %.0f px at the end (checksum %.3f)\n", max_x - min_x, checksum);
+    printf("RESULT bench=stress count=%d ticks=%lld update_us=%.1f hash_us=%.1f pairwise_us=%.1f max_push=%.2f\n",
+        count, ticks, update_us, hash_us, pairwise_us, max_push);
+    return 0;
+}
@@ -0,0 +1,22 @@
+#ifndef HEADLESS_BENCH_H
+#define HEADLESS_BENCH_H
+
+// Micro-benchmarks for tankboy_headless (Linux, CPU time).
+// Each prints its timings and ends with a "RESULT bench=..." line like the
+// replay runs, so numbers quoted in commits can be reproduced.
+
+struct World;
+
+// ===== Function Declarations =====
+
+// Helicopter flight: libm sin() per enemy (the original update) against the
+// rotation recurrence flying_enemy_fly uses, over the same fleet
+int bench_flight(int count, long long ticks);
+
+// Crowd separation: COUNT ground chasers on a long strip, all chasing the tank
+// parked mid-map, moved by the real enemies_update_roi. Also times the
+// separation queries alone through the spatial hash and pairwise over the
+// same positions. COUNT is capped at MAX_ENEMIES (STRESS=1 build for 2000)
+int bench_stress(struct World* world, int count, long long ticks);
+
+#endif // HEADLESS_BENCH_H
@@ -0,0 +1,237 @@
+// Headless simulation runner: no display, audio or fonts.
+// Built by build_headless.sh (Linux); not part of the Visual Studio project.
+// Run from the repository root, like the game (resource paths are relative to it).
+//
+// Scripted play (soak / throughput, optionally recorded to a replay):
+//   tankboy_headless [--stage N] [--ticks N] [--seed N] [--bot walk|mg|cannon|tour] [--record FILE]
+// Replay playback (perf regression suite, see run_perf_suite.sh):
+//   tankboy_headless --replay FILE [--runs N]
+// Both: [--trace FILE] (needs a PROFILE=1 build)
+// Micro-benchmarks (headless_bench.c), run for --ticks N ticks:
+//   tankboy_headless --bench-flight COUNT [--ticks N]
+//   tankboy_headless --stress COUNT [--ticks N]   (COUNT > 20 needs a STRESS=1 build)
+//
+// The last line is always "RESULT name=... ticks=... ticks_per_s=... hash=...",
+// best ticks/s over the runs and the final world_state_hash.
+
+// standard c library
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+// local library
+#include "world.h"
+#include "ini_parser.h"
+#include "enemy.h"
+#include "map_generation.h"
+#include "profiler.h"
+#include "replay.h"
+#include "bot.h"
+#include "headless_bench.h"
+
+#define HEADLESS_DEFAULT_TICKS 36000 // 10 minutes of game time
+#define HEADLESS_TICK_RATE 60        // Same fixed tick as the game (SIM_TICK_RATE)
+#define HEADLESS_DT (1.0 / HEADLESS_TICK_RATE)
+
+// CPU time of this process: steadier than wall time on a shared machine
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// ===== Commands =====
+
+static void apply_command(World* world, ReplayCommand command) {
+    if (command == REPLAY_CMD_NEW_GAME) world_new_game(world);
+    else if (command == REPLAY_CMD_NEXT_STAGE) world_load_stage(world, world->stage + 1);
+}
+
+// Same path as the menu buttons: recorded (if recording), then applied
+static void issue_command(World* world, ReplayCommand command) {
+    replay_record_command(command);
+    apply_command(world, command);
+}
+
+static void start_at_stage(World* world, int stage) {
+    issue_command(world, REPLAY_CMD_NEW_GAME);
+    while (world->stage < stage) issue_command(world, REPLAY_CMD_NEXT_STAGE);
+}
+
+// ===== Runs =====
+
+// Soak mode: restart the stage on clear or death and keep going
+static void run_bot(World* world, BotType bot, int stage, long long ticks, int* clears, int* deaths) {
+    InputState input;
+
+    start_at_stage(world, stage);
+    for (long long i = 0; i < ticks; i++) {
+        bot_input(bot, i, world, &input, &world->tank.cannon_angle);
+        replay_record_tick(&input, world->tank.cannon_angle);
+        world_step(world, &input, HEADLESS_DT);
+        PROFILE_FRAME_END(PROFILE_FRAME_SIM);
+
+        if (world->stage_cleared) (*clears)++;
+        else if (world->tank_destroyed) (*deaths)++;
+
+        if (bot == BOT_TOUR && !world->tank_destroyed && (world->stage_cleared || (i + 1) % BOT_TOUR_STAGE_TICKS == 0)) {
+            if (world->stage < 3) issue_command(world, REPLAY_CMD_NEXT_STAGE);
+            else start_at_stage(world, 1);
+        }
+        else if (world->stage_cleared || world->tank_destroyed) {
+            start_at_stage(world, bot == BOT_TOUR ? 1 : stage);
+        }
+    }
+}
+
+// Replay mode: the file decides every tick and command; returns ticks played (-1 on error)
+static long long run_replay(World* world, const char* path) {
+    if (!replay_play_begin(path)) return -1;
+
+    rng_seed(&world->rng, replay_seed());
+    world->tick = 0;
+
+    InputState input;
+    ReplayCommand command;
+    bool ended = false;
+    while (!ended) {
+        while (replay_next_command(&command)) {
+            if (command == REPLAY_CMD_END) { ended = true; break; }
+            apply_command(world, command);
+        }
+        if (ended || !replay_read_tick(&input, &world->tank.cannon_angle)) break;
+
+        world_step(world, &input, HEADLESS_DT);
+        PROFILE_FRAME_END(PROFILE_FRAME_SIM);
+    }
+
+    long long played = (long long)replay_ticks_played();
+    replay_play_end();
+    return played;
+}
+
+static const char* base_name(const char* path) {
+    const char* slash = strrchr(path, '/');
+    return slash ? slash + 1 : path;
+}
+
+int main(int argc, char** argv) {
+    int stage = 1;
+    long long ticks = HEADLESS_DEFAULT_TICKS;
+    unsigned long long seed = 1;
+    BotType bot = BOT_WALK;
+    int runs = 1;
+    const char* trace_file = NULL;
+    const char* record_file = NULL;
+    const char* replay_file = NULL;
+    int bench_flight_count = 0;
+    int stress_count = 0;
+
+    // Command line: see the top of this file
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--stage") == 0 && i + 1 < argc) stage = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--ticks") == 0 && i + 1 < argc) ticks = atoll(argv[++i]);
+        else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) seed = strtoull(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "--runs") == 0 && i + 1 < argc) runs = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) trace_file = argv[++i];
+        else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) record_file = argv[++i];
+        else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) replay_file = argv[++i];
+        else if (strcmp(argv[i], "--bot") == 0 && i + 1 < argc) bot = bot_type_from_string(argv[++i]);
+        else if (strcmp(argv[i], "--bench-flight") == 0 && i + 1 < argc) bench_flight_count = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--stress") == 0 && i + 1 < argc) stress_count = atoi(argv[++i]);
+        else {
+            printf("usage: %s [--stage N] [--ticks N] [--seed N] [--bot walk|mg|cannon|tour] [--record FILE] [--trace FILE]\n"
+                   "       %s --replay FILE [--runs N] [--trace FILE]\n"
+                   "       %s --bench-flight COUNT [--ticks N]\n"
+                   "       %s --stress COUNT [--ticks N]\n", argv[0], argv[0], argv[0], argv[0]);
+            return 1;
+        }
+    }
+    if (stage < 1) stage = 1;
+    if (stage > 3) stage = 3;
+    if (runs < 1) runs = 1;
+    if (record_file) runs = 1;
+
+    if (bench_flight_count > 0) return bench_flight(bench_flight_count, ticks);
+
+    // Same config values the game uses for the bullet pool and the update ROI
+    IniParser* parser = ini_parser_create();
+    if (!parser) { printf("Error: INI parser create failed\n"); return 1; }
+    if (!ini_parser_load_file(parser, "TankBoy/config.ini"))
+        printf("Warning: TankBoy/config.ini not loaded. Using defaults.\n");
+    int view_width = ini_parser_get_int(parser, "Buffer", "buffer_width", 320);
+    int view_height = ini_parser_get_int(parser, "Buffer", "buffer_height", 240);
+    int max_bullets = ini_parser_get_int(parser, "Game", "max_bullets", 100);
+    ini_parser_destroy(parser);
+
+    map_config_init();
+    enemy_archetypes_init();
+
+#ifdef TANKBOY_PROFILE
+    if (trace_file) profiler_trace_start();
+#else
+    if (trace_file) printf("Warning: --trace ignored, rebuild with PROFILE=1\n");
+#endif
+
+    World world;
+    if (!world_init(&world, max_bullets, view_width, view_height, seed)) {
+        printf("Error: world init failed\n");
+        return 1;
+    }
+
+    if (stress_count > 0) {
+        int result = bench_stress(&world, stress_count, ticks);
+        world_free(&world);
+        map_config_cleanup();
+        return result;
+    }
+
+    const char* name = replay_file ? base_name(replay_file) : "scripted";
+    long long played = 0;
+    double best_rate = 0.0;
+    uint64_t hash = 0;
+    int clears = 0, deaths = 0;
+
+    for (int run = 0; run < runs; run++) {
+        double start = now_seconds();
+        if (replay_file) {
+            played = run_replay(&world, replay_file);
+            if (played < 0) return 1;
+        }
+        else {
+            if (record_file && !replay_record_begin(record_file, seed, HEADLESS_TICK_RATE)) return 1;
+            run_bot(&world, bot, stage, ticks, &clears, &deaths);
+            replay_record_end();
+            played = ticks;
+        }
+        double elapsed = now_seconds() - start;
+        double rate = elapsed > 0.0 ? played / elapsed : 0.0;
+
+        // Same input must land on the same state every time
+        uint64_t run_hash = world_state_hash(&world);
+        if (run > 0 && run_hash != hash) {
+            printf("Error: run %d ended with hash %016llx, run 1 with %016llx\n",
+                run + 1, (unsigned long long)run_hash, (unsigned long long)hash);
+            return 2;
+        }
+        hash = run_hash;
+        if (rate > best_rate) best_rate = rate;
+
+        printf("%s run %d: %lld ticks in %.3f s = %.0f ticks/s (%.1fx real time, CPU time)\n",
+            name, run + 1, played, elapsed, rate, rate / HEADLESS_TICK_RATE);
+    }
+
+    printf("stage %d, score %.0f, clears %d, deaths %d\n", world.stage, world.score, clears, deaths);
+#ifdef TANKBOY_PROFILE
+    profiler_print_report(stdout);
+    if (trace_file) profiler_trace_write(trace_file);
+#endif
+    printf("RESULT name=%s ticks=%lld ticks_per_s=%.0f hash=%016llx\n",
+        name, played, best_rate, (unsigned long long)hash);
+
+    world_free(&world);
+    map_config_cleanup();
+    return 0;
+}
@@ -1,5 +1,9 @@
 #include "ini_parser.h"
 
+#ifndef _WIN32
+#define _strdup strdup
+#define strcpy_s(dest, size, src) snprintf((dest), (size), "%s", (src))
+#endif
 
 #define INITIAL_CAPACITY 32
 #define MAX_LINE_LENGTH 256
@@ -0,0 +1,16 @@
+#ifndef INPUT_STATE_H
+#define INPUT_STATE_H
+
+#include <stdbool.h>
+
+// Key states structure (plain data, shared by the simulation and the Allegro input system)
+typedef struct {
+    bool left;        // A / Left arrow
+    bool right;       // D / Right arrow
+    bool jump;        // W / Up arrow
+    bool change_weapon; // R
+    bool esc;         // ESC
+    bool fire;        // Mouse click
+} InputState;
+
+#endif // INPUT_STATE_H
@@ -4,16 +4,7 @@
 #include <allegro5/allegro5.h>
 #include <allegro5/allegro_font.h>
 #include <stdbool.h>
-
-// Key states structure
-typedef struct {
-    bool left;        // A / Left arrow
-    bool right;       // D / Right arrow
-    bool jump;        // W / Up arrow
-    bool change_weapon; // R
-    bool esc;         // ESC
-    bool fire;        // Mouse click
-} InputState;
+#include "input_state.h"
 
 // Text input structure
 typedef struct {
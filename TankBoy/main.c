@@ -2,6 +2,7 @@
 #include <time.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 // allegro5 library
 #include <allegro5/allegro5.h>
@@ -17,8 +18,17 @@
 #include "enemy.h"
 #include "collision.h"
 #include "head_up_display.h"
+#include "profiler.h"
+#include "frame_stats.h"
+#include "replay.h"
+#include "render_thread.h"
 
 
+// Labels for the frame stats report, in GameState order
+static const char* const state_names[] = {
+    "menu", "ranking", "game", "game_over", "name_input", "stage_complete", "exit"
+};
+
 void* must_init(void* test, const char* description) {
     if (test) return test;
 
@@ -28,20 +38,45 @@ void* must_init(void* test, const char* description) {
 }
 
 
-int main(void) {
-    srand((unsigned int)time(NULL));
+int main(int argc, char** argv) {
 	al_init();
     
     // Load configuration first
     GameSystem game_system;
     load_game_config(&game_system.config, "config.ini");
+
+    // Command line overrides: --seed <n>, --replay <file>, --trace
+    const char* replay_file = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            game_system.config.rng_seed = strtoull(argv[++i], NULL, 10);
+        }
+        else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replay_file = argv[++i];
+        }
+#ifdef TANKBOY_PROFILE
+        else if (strcmp(argv[i], "--trace") == 0) {
+            // Capture every profiled scope; F4 dumps, exit dumps the last stretch
+            profiler_trace_start();
+        }
+#endif
+    }
     
+    // A replay brings its own seed and replaces live input
+    if (replay_file) {
+        if (!replay_play_begin(replay_file)) return 1;
+        if (replay_tick_rate() != SIM_TICK_RATE) {
+            printf("Warning: replay recorded at %d ticks/s, playing at %d\n", replay_tick_rate(), SIM_TICK_RATE);
+        }
+        game_system.config.rng_seed = replay_seed();
+        printf("Playing replay: %s\n", replay_file);
+    }
+
     // Initialize map configuration
     map_config_init();
     
-    // Initialize enemy system
-    enemies_init();
-    flying_enemies_init();
+    // Initialize enemy system (archetypes read config.ini once, here)
+    enemy_archetypes_init();
     
     // Initialize HUD
     head_up_display_init("config.ini");
@@ -52,15 +87,36 @@ int main(void) {
     ALLEGRO_DISPLAY* display = must_init(al_create_display(disp_w, disp_h), "display");
     ALLEGRO_EVENT_QUEUE* queue = must_init(al_create_event_queue(), "event queue");
     
-    // Create timer for 60 FPS
-    ALLEGRO_TIMER* timer = must_init(al_create_timer(1.0 / 60.0), "timer");
+    // Sim timer at the display refresh rate (simulation runs at SIM_TICK_RATE regardless;
+    // the render thread keeps its own timer)
+    int refresh_rate = al_get_display_refresh_rate(display);
+    if (refresh_rate <= 0) refresh_rate = SIM_TICK_RATE;
+    ALLEGRO_TIMER* timer = must_init(al_create_timer(1.0 / refresh_rate), "timer");
     al_register_event_source(queue, al_get_timer_event_source(timer));
+
+    // Still screens stop the sim timer; this one only runs for the name input cursor
+    ALLEGRO_TIMER* blink_timer = must_init(al_create_timer(NAME_CURSOR_BLINK_PERIOD), "blink timer");
+    al_register_event_source(queue, al_get_timer_event_source(blink_timer));
     
     // Initialize game system
     init_game_system(display, queue, &game_system);
+
+    // Every live session is recorded (seed is final once the game system is up)
+    if (!replay_file) {
+        replay_record_begin(REPLAY_LAST_SESSION_FILE, game_system.config.rng_seed, SIM_TICK_RATE);
+    }
     
+    // Drawing moves to its own thread; this one keeps input, audio and the simulation
+    if (!render_thread_start(&game_system, display, refresh_rate)) {
+        printf("couldn't initialize render thread\n");
+        exit(1);
+    }
+
     ALLEGRO_EVENT event;
-    bool redraw = true;
+    bool publish = true;
+    double accumulator = 0.0;
+    double previous_time = al_get_time();
+    double speed = 1.0;
     
     al_start_timer(timer);
     
@@ -70,21 +126,83 @@ int main(void) {
         if (event.type == ALLEGRO_EVENT_DISPLAY_CLOSE) {
             game_system.running = false;
         }
-        // only update display on timer event
-        else if (event.type == ALLEGRO_EVENT_TIMER) {
-            redraw = true;
-        }
         
-        // Handle all events (input, timer, etc.)
+        // Handle input and UI events
         update_game_state(&event, &game_system);
 
-        if (redraw && al_is_event_queue_empty(queue)) {
-            redraw = false;
-            render_game(&game_system);
+        // Fixed-timestep simulation: consume real elapsed time in SIM_DT steps
+        // (scaled by the replay playback speed; only the last tick of a frame is drawn)
+        if (event.type == ALLEGRO_EVENT_TIMER && event.timer.source == timer) {
+            double now = al_get_time();
+            speed = game_system_playback_speed(&game_system);
+            int steps = 0;
+            GameState step_state = game_system.current_state;
+
+            if (speed != REPLAY_SPEED_UNCAPPED) {
+                accumulator += (now - previous_time) * speed;
+                int max_steps = speed > 1.0 ? (int)(SIM_MAX_STEPS_PER_FRAME * speed) : SIM_MAX_STEPS_PER_FRAME;
+                while (accumulator >= SIM_DT && steps < max_steps) {
+                    game_system_step(&game_system, SIM_DT);
+                    accumulator -= SIM_DT;
+                    steps++;
+                }
+                // After a long stall, drop the backlog instead of fast-forwarding
+                if (accumulator >= SIM_DT) accumulator = 0.0;
+            }
+            else {
+                // Uncapped replay: simulate for most of a refresh period, then draw once
+                double deadline = now + 0.8 / refresh_rate;
+                do {
+                    game_system_step(&game_system, SIM_DT);
+                    steps++;
+                } while (game_system.running && al_get_time() < deadline);
+                accumulator = 0.0;
+            }
+            previous_time = now;
+            frame_stats_record_ticks(step_state, steps);
+
+            publish = true;
+        }
+
+        // Still screens: no ticks, and a new frame only for a hover change, a key or the blink
+        bool view_changed = game_system_view_changed(&game_system);
+        if (game_system_is_idle(&game_system)) {
+            if (al_get_timer_started(timer)) al_stop_timer(timer);
+            if (view_changed || event.type == ALLEGRO_EVENT_KEY_DOWN || event.type == ALLEGRO_EVENT_KEY_CHAR) {
+                publish = true;
+            }
+        }
+        else if (!al_get_timer_started(timer)) {
+            // Back in play: time from now, not from when the menu came up
+            accumulator = 0.0;
+            previous_time = al_get_time();
+            al_start_timer(timer);
+            publish = true;
+        }
+        bool blinking = game_system.current_state == STATE_NAME_INPUT;
+        if (blinking && !al_get_timer_started(blink_timer)) al_start_timer(blink_timer);
+        else if (!blinking && al_get_timer_started(blink_timer)) al_stop_timer(blink_timer);
+
+        // Hand the newest state to the render thread (it never waits on us, nor we on it)
+        if (publish && al_is_event_queue_empty(queue)) {
+            publish = false;
+            render_thread_publish(&game_system, accumulator / SIM_DT, speed);
         }
     }
     
+    render_thread_stop(display);
+    al_destroy_timer(blink_timer);
     al_destroy_timer(timer);
+    replay_record_end();
+
+#ifdef TANKBOY_PROFILE
+    if (profiler_trace_active()) profiler_trace_write(PROFILE_TRACE_FILE);
+#endif
+
+    // Session frame-time report, next to rankings.csv
+    int state_count = (int)(sizeof(state_names) / sizeof(state_names[0]));
+    frame_stats_write_json(FRAME_STATS_JSON_FILE, state_names, state_count);
+    frame_stats_write_csv(FRAME_STATS_CSV_FILE, state_names, state_count);
     
 
     cleanup_game_system(&game_system, queue, display);
@@ -4,7 +4,6 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <allegro5/allegro5.h>
 
 #define INITIAL_BLOCK_CAPACITY 1000
 #define INITIAL_SPAWN_CAPACITY 10
@@ -12,8 +11,6 @@
 // Global configuration cache
 static MapConfig g_map_config = {0};
 
-map_sprites_t map_sprites;
-
 // Initialize configuration (load once)
 void map_config_init(void) {
     IniParser* parser = ini_parser_create();
@@ -96,6 +93,37 @@ void map_free(Map* map) {
     }
 }
 
+// Copy a map (render snapshots keep their own copy of the stage)
+bool map_copy(Map* dst, const Map* src) {
+    if (dst->block_capacity < src->block_count) {
+        Block* new_blocks = realloc(dst->blocks, src->block_count * sizeof(Block));
+        if (!new_blocks) return false;
+
+        dst->blocks = new_blocks;
+        dst->block_capacity = src->block_count;
+    }
+
+    if (src->block_count > 0) memcpy(dst->blocks, src->blocks, src->block_count * sizeof(Block));
+    dst->block_count = src->block_count;
+    dst->map_width = src->map_width;
+    dst->map_height = src->map_height;
+    dst->stage = src->stage;
+    return true;
+}
+
+int csv_split_fields(char* line, char** fields, int max_fields) {
+    int count = 0;
+    char* p = line;
+    while (count < max_fields) {
+        fields[count++] = p;
+        char* comma = strchr(p, ',');
+        if (!comma) break;
+        *comma = 0;
+        p = comma + 1;
+    }
+    return count;
+}
+
 // Convert string to block type
 BlockType map_string_to_block_type(const char* type_str) {
     if (strcmp(type_str, "grass") == 0) {
@@ -107,17 +135,6 @@ BlockType map_string_to_block_type(const char* type_str) {
     return BLOCK_GROUND; // Default to ground
 }
 
-// Get color for block type
-ALLEGRO_COLOR map_get_block_color(BlockType type) {
-    switch (type) {
-        case BLOCK_GRASS:
-            return al_map_rgb(34, 139, 34);  // Forest green
-        case BLOCK_GROUND:
-        default:
-            return al_map_rgb(139, 69, 19);  // Saddle brown
-    }
-}
-
 // Add block to map (resize array if needed)
 static bool map_add_block(Map* map, const Block* block) {
     if (map->block_count >= map->block_capacity) {
@@ -175,28 +192,18 @@ bool map_load(Map* map, const char* csv_path) {
         }
 
         // Parse CSV line: type,start_x,start_y,end_x,end_y
-        char* token = strtok(line, ",");
-        if (!token) continue;
+        line[strcspn(line, "\r\n")] = '\0';
+        char* fields[6];  // one spare, so extra columns stay out of end_y
+        if (csv_split_fields(line, fields, 6) < 5) continue;
 
         char type_str[32];
-        strncpy(type_str, token, sizeof(type_str) - 1);
+        strncpy(type_str, fields[0], sizeof(type_str) - 1);
         type_str[sizeof(type_str) - 1] = '\0';
 
-        token = strtok(NULL, ",");
-        if (!token) continue;
-        int start_x = atoi(token);
-
-        token = strtok(NULL, ",");
-        if (!token) continue;
-        int start_y = atoi(token);
-
-        token = strtok(NULL, ",");
-        if (!token) continue;
-        int end_x = atoi(token);
-
-        token = strtok(NULL, ",");
-        if (!token) continue;
-        int end_y = atoi(token);
+        int start_x = atoi(fields[1]);
+        int start_y = atoi(fields[2]);
+        int end_x = atoi(fields[3]);
+        int end_y = atoi(fields[4]);
 
         // Create block
         Block block;
@@ -276,56 +283,6 @@ int map_get_ground_level(const Map* map, int x, int tank_width) {
     return ground_level;
 }
 
-// Render map within camera view
-void map_draw(const Map* map, double camera_x, double camera_y, int buffer_width, int buffer_height) {
-    if (!map) return;
-
-    // Calculate visible area
-    int left = (int)camera_x;
-    int right = (int)camera_x + buffer_width;
-    int top = (int)camera_y;
-    int bottom = (int)camera_y + buffer_height;
-
-    // Draw blocks that are visible
-    for (size_t i = 0; i < map->block_count; i++) {
-        const Block* block = &map->blocks[i];
-
-        // Check if block is visible
-        if (block->x + block->width >= left && block->x <= right &&
-            block->y + block->height >= top && block->y <= bottom) {
-
-            // Calculate screen position
-            float screen_x = block->x - camera_x;
-            float screen_y = block->y - camera_y;
-
-            // Draw block based on stage and block type
-            int sprite_index = map->stage - 1; // Convert stage 1,2,3 to index 0,1,2
-            
-            if (sprite_index < 0 || sprite_index > 2) {
-                sprite_index = 0; // Default to stage 1 sprites if out of range
-            }
-            
-            if (block->type == BLOCK_GROUND) {
-                int bitmap_width = al_get_bitmap_width(map_sprites.ground_sprites[sprite_index]);
-                int bitmap_height = al_get_bitmap_height(map_sprites.ground_sprites[sprite_index]);
-                // al_draw_bitmap(map_sprites.ground_sprites[sprite_index], screen_x, screen_y, 0);
-                al_draw_scaled_bitmap(map_sprites.ground_sprites[sprite_index],
-                                    0, 0,
-                                    bitmap_width, bitmap_height,
-                                    screen_x, screen_y, block->width, block->height, 0);
-
-            } else if (block->type == BLOCK_GRASS) {
-                int bitmap_width = al_get_bitmap_width(map_sprites.grass_sprites[sprite_index]);
-                int bitmap_height = al_get_bitmap_height(map_sprites.grass_sprites[sprite_index]);
-                al_draw_scaled_bitmap(map_sprites.grass_sprites[sprite_index],
-                                    0, 0,
-                                    bitmap_width, bitmap_height,
-                                    screen_x, screen_y, block->width, block->height, 0);
-            }
-        }
-    }
-}
-
 // Configuration functions, used in other files
 int map_get_block_size(void) {
     const MapConfig* config = map_get_config();
@@ -373,6 +330,20 @@ void spawn_points_free(SpawnPoints* spawns) {
     }
 }
 
+bool spawn_points_copy(SpawnPoints* dst, const SpawnPoints* src) {
+    if (dst->capacity < src->count) {
+        SpawnPoint* new_points = realloc(dst->points, src->count * sizeof(SpawnPoint));
+        if (!new_points) return false;
+
+        dst->points = new_points;
+        dst->capacity = src->count;
+    }
+
+    if (src->count > 0) memcpy(dst->points, src->points, src->count * sizeof(SpawnPoint));
+    dst->count = src->count;
+    return true;
+}
+
 // Add spawn point to collection (resize array if needed)
 static bool spawn_points_add(SpawnPoints* spawns, const SpawnPoint* point) {
     if (spawns->count >= spawns->capacity) {
@@ -416,16 +387,13 @@ bool spawn_points_load(SpawnPoints* spawns, const char* csv_path) {
         }
 
         // Parse CSV line: x,y,spawn_type
-        char* token = strtok(line, ",");
-        if (!token) continue;
-        int x = atoi(token);
-
-        token = strtok(NULL, ",");
-        if (!token) continue;
-        int y = atoi(token);
-
-        token = strtok(NULL, ",\n\r");
-        if (!token) continue;
+        line[strcspn(line, "\r\n")] = '\0';
+        char* fields[4];  // one spare, so extra columns stay out of spawn_type
+        if (csv_split_fields(line, fields, 4) < 3) continue;
+        int x = atoi(fields[0]);
+        int y = atoi(fields[1]);
+        char* token = fields[2];
+        if (!token[0]) continue;
 
         // Remove trailing whitespace
         char* end = token + strlen(token) - 1;
@@ -464,69 +432,3 @@ SpawnPoint* spawn_points_get_tank_spawn(const SpawnPoints* spawns) {
     }
     return NULL;
 }
-
-//sprite
-
-
-
-
-
-void map_sprites_init(const char* sprite_path)
-{
-    map_sprites._sheet = al_load_bitmap(sprite_path);
-    if (map_sprites._sheet == NULL) {
-        printf("wrong location of map sprite!!\n");
-    }
-    
-    map_sprites.ground_sprites = malloc(3 * sizeof(ALLEGRO_BITMAP*));
-    map_sprites.grass_sprites = malloc(3 * sizeof(ALLEGRO_BITMAP*));
-
-    int sheet_width = 1912;
-    int block_width = 1912 / 4;
-    int sheet_height = 957;
-    int block_height = 957 / 2;
-    
-    // sprites idx 0 == stage 1
-    map_sprites.ground_sprites[0] = al_create_sub_bitmap(map_sprites._sheet, 0, 0, block_width, block_height);
-    map_sprites.grass_sprites[0] = al_create_sub_bitmap(map_sprites._sheet, block_width, 0, block_width, block_height);
-    map_sprites.grass_sprites[1] = al_create_sub_bitmap(map_sprites._sheet, block_width * 2, 0, block_width, block_height);
-    map_sprites.ground_sprites[1] = al_create_sub_bitmap(map_sprites._sheet, block_width * 3, 0, block_width, block_height);
-    map_sprites.ground_sprites[2] = al_create_sub_bitmap(map_sprites._sheet, 0, block_height, block_width, block_height);
-    map_sprites.grass_sprites[2] = al_create_sub_bitmap(map_sprites._sheet, block_width, block_height, block_width, block_height);
-}
-
-
-//void must_init(bool test, const char* description)
-//{
-//    if (test) return;
-//
-//    printf("couldn't initialize %s\n", description);
-//    exit(1);
-//}
-
-
-void map_sprites_deinit()
-{
-    // Free individual sprites
-    for (int i = 0; i < 3; i++) {
-        if (map_sprites.ground_sprites[i]) {
-            al_destroy_bitmap(map_sprites.ground_sprites[i]);
-        }
-        if (map_sprites.grass_sprites[i]) {
-            al_destroy_bitmap(map_sprites.grass_sprites[i]);
-        }
-    }
-    
-    // Free sprite arrays
-    if (map_sprites.ground_sprites) {
-        free(map_sprites.ground_sprites);
-    }
-    if (map_sprites.grass_sprites) {
-        free(map_sprites.grass_sprites);
-    }
-
-    // Free sprite sheet
-    if (map_sprites._sheet) {
-        al_destroy_bitmap(map_sprites._sheet);
-    }
-}
\ No newline at end of file
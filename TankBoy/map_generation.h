@@ -2,8 +2,7 @@
 #define MAP_GENERATION_H
 
 #include <stdbool.h>
-#include <allegro5/allegro5.h>
-#include <allegro5/allegro_primitives.h>
+#include <stddef.h>
 
 // Block types
 typedef enum {
@@ -46,24 +45,17 @@ typedef struct {
     int stage;  // 현재 스테이지 번호 (1, 2, 3)
 } Map;
 
-// sprite structure
-typedef struct _map_sprites
-{
-    ALLEGRO_BITMAP* _sheet;
-    ALLEGRO_BITMAP** grass_sprites;
-    ALLEGRO_BITMAP** ground_sprites;
-    
-} map_sprites_t;
-
 // Map management
 bool map_load(Map* map, const char* csv_path);
 bool map_init(Map* map);
 void map_free(Map* map);
+bool map_copy(Map* dst, const Map* src);  // dst must be initialized; its block array is reused
 
 // Spawn point management
 bool spawn_points_init(SpawnPoints* spawns);
 void spawn_points_free(SpawnPoints* spawns);
 bool spawn_points_load(SpawnPoints* spawns, const char* csv_path);
+bool spawn_points_copy(SpawnPoints* dst, const SpawnPoints* src);  // dst's array is reused
 SpawnPoint* spawn_points_get_tank_spawn(const SpawnPoints* spawns);
 
 // Collision detection ROI
@@ -77,12 +69,12 @@ bool map_rect_collision(const Map* map, int x, int y, int width, int height);
 // Get ground level at specific x coordinate (for tank landing)
 int map_get_ground_level(const Map* map, int x, int tank_width);
 
-// Rendering
-void map_draw(const Map* map, double camera_x, double camera_y, int buffer_width, int buffer_height);
-
 // Utilities
 BlockType map_string_to_block_type(const char* type_str);
-ALLEGRO_COLOR map_get_block_color(BlockType type);
+
+// Split a CSV line in place and return the field count; unlike strtok, empty
+// fields are kept and no hidden state is shared, so loaders may run on any thread
+int csv_split_fields(char* line, char** fields, int max_fields);
 
 // Configuration structure
 typedef struct {
@@ -111,9 +103,4 @@ int map_get_block_size(void);
 int map_get_map_width(void);
 int map_get_map_height(void);
 
-//sprite
-void map_sprites_init(const char* sprite_path);
-//void must_init(bool test, const char* description);
-void map_sprites_deinit();
-
 #endif // MAP_GENERATION_H
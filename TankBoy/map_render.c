@@ -0,0 +1,127 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include "map_render.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+map_sprites_t map_sprites;
+
+// Get color for block type
+ALLEGRO_COLOR map_get_block_color(BlockType type) {
+    switch (type) {
+        case BLOCK_GRASS:
+            return al_map_rgb(34, 139, 34);  // Forest green
+        case BLOCK_GROUND:
+        default:
+            return al_map_rgb(139, 69, 19);  // Saddle brown
+    }
+}
+
+// Render map within camera view
+void map_draw(const Map* map, double camera_x, double camera_y, int buffer_width, int buffer_height) {
+    if (!map) return;
+
+    // Calculate visible area
+    int left = (int)camera_x;
+    int right = (int)camera_x + buffer_width;
+    int top = (int)camera_y;
+    int bottom = (int)camera_y + buffer_height;
+
+    // Draw blocks that are visible
+    for (size_t i = 0; i < map->block_count; i++) {
+        const Block* block = &map->blocks[i];
+
+        // Check if block is visible
+        if (block->x + block->width >= left && block->x <= right &&
+            block->y + block->height >= top && block->y <= bottom) {
+
+            // Calculate screen position
+            float screen_x = block->x - camera_x;
+            float screen_y = block->y - camera_y;
+
+            // Draw block based on stage and block type
+            int sprite_index = map->stage - 1; // Convert stage 1,2,3 to index 0,1,2
+            
+            if (sprite_index < 0 || sprite_index > 2) {
+                sprite_index = 0; // Default to stage 1 sprites if out of range
+            }
+            
+            if (block->type == BLOCK_GROUND) {
+                int bitmap_width = al_get_bitmap_width(map_sprites.ground_sprites[sprite_index]);
+                int bitmap_height = al_get_bitmap_height(map_sprites.ground_sprites[sprite_index]);
+                // al_draw_bitmap(map_sprites.ground_sprites[sprite_index], screen_x, screen_y, 0);
+                al_draw_scaled_bitmap(map_sprites.ground_sprites[sprite_index],
+                                    0, 0,
+                                    bitmap_width, bitmap_height,
+                                    screen_x, screen_y, block->width, block->height, 0);
+
+            } else if (block->type == BLOCK_GRASS) {
+                int bitmap_width = al_get_bitmap_width(map_sprites.grass_sprites[sprite_index]);
+                int bitmap_height = al_get_bitmap_height(map_sprites.grass_sprites[sprite_index]);
+                al_draw_scaled_bitmap(map_sprites.grass_sprites[sprite_index],
+                                    0, 0,
+                                    bitmap_width, bitmap_height,
+                                    screen_x, screen_y, block->width, block->height, 0);
+            }
+        }
+    }
+}
+
+void map_sprites_init(const char* sprite_path)
+{
+    map_sprites._sheet = al_load_bitmap(sprite_path);
+    if (map_sprites._sheet == NULL) {
+        printf("wrong location of map sprite!!\n");
+    }
+    
+    map_sprites.ground_sprites = malloc(3 * sizeof(ALLEGRO_BITMAP*));
+    map_sprites.grass_sprites = malloc(3 * sizeof(ALLEGRO_BITMAP*));
+
+    int sheet_width = 1912;
+    int block_width = 1912 / 4;
+    int sheet_height = 957;
+    int block_height = 957 / 2;
+    
+    // sprites idx 0 == stage 1
+    map_sprites.ground_sprites[0] = al_create_sub_bitmap(map_sprites._sheet, 0, 0, block_width, block_height);
+    map_sprites.grass_sprites[0] = al_create_sub_bitmap(map_sprites._sheet, block_width, 0, block_width, block_height);
+    map_sprites.grass_sprites[1] = al_create_sub_bitmap(map_sprites._sheet, block_width * 2, 0, block_width, block_height);
+    map_sprites.ground_sprites[1] = al_create_sub_bitmap(map_sprites._sheet, block_width * 3, 0, block_width, block_height);
+    map_sprites.ground_sprites[2] = al_create_sub_bitmap(map_sprites._sheet, 0, block_height, block_width, block_height);
+    map_sprites.grass_sprites[2] = al_create_sub_bitmap(map_sprites._sheet, block_width, block_height, block_width, block_height);
+}
+
+
+//void must_init(bool test, const char* description)
+//{
+//    if (test) return;
+//
+//    printf("couldn't initialize %s\n", description);
+//    exit(1);
+//}
+
+
+void map_sprites_deinit()
+{
+    // Free individual sprites
+    for (int i = 0; i < 3; i++) {
+        if (map_sprites.ground_sprites[i]) {
+            al_destroy_bitmap(map_sprites.ground_sprites[i]);
+        }
+        if (map_sprites.grass_sprites[i]) {
+            al_destroy_bitmap(map_sprites.grass_sprites[i]);
+        }
+    }
+    
+    // Free sprite arrays
+    if (map_sprites.ground_sprites) {
+        free(map_sprites.ground_sprites);
+    }
+    if (map_sprites.grass_sprites) {
+        free(map_sprites.grass_sprites);
+    }
+
+    // Free sprite sheet
+    if (map_sprites._sheet) {
+        al_destroy_bitmap(map_sprites._sheet);
+    }
+}
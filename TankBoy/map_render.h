@@ -0,0 +1,25 @@
+#ifndef MAP_RENDER_H
+#define MAP_RENDER_H
+
+#include <allegro5/allegro5.h>
+#include <allegro5/allegro_primitives.h>
+#include "map_generation.h"
+
+// sprite structure
+typedef struct _map_sprites
+{
+    ALLEGRO_BITMAP* _sheet;
+    ALLEGRO_BITMAP** grass_sprites;
+    ALLEGRO_BITMAP** ground_sprites;
+    
+} map_sprites_t;
+
+// Rendering (kept apart from map_generation.c so the simulation builds without Allegro)
+void map_draw(const Map* map, double camera_x, double camera_y, int buffer_width, int buffer_height);
+ALLEGRO_COLOR map_get_block_color(BlockType type);
+
+//sprite
+void map_sprites_init(const char* sprite_path);
+void map_sprites_deinit();
+
+#endif // MAP_RENDER_H
@@ -0,0 +1,117 @@
+#include "number_font.h"
+#include <stdio.h>
+#include <string.h>
+
+#define NUMBER_FONT_PADDING 1 // Gap between glyphs so filtering never picks up a neighbour
+
+static const char number_font_chars[] = NUMBER_FONT_CHARS;
+
+// Atlas slot of a character, -1 if it is not in the set
+static int glyph_index(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    const char* found = c ? strchr(number_font_chars, c) : NULL;
+    return found ? (int)(found - number_font_chars) : -1;
+}
+
+// ===== Atlas =====
+
+bool number_font_build(NumberFont* number_font, ALLEGRO_FONT* font) {
+    memset(number_font, 0, sizeof(*number_font));
+    number_font->font = font;
+    if (!font) return false;
+
+    number_font->height = al_get_font_line_height(font);
+
+    int atlas_width = 0;
+    for (int i = 0; i < (int)NUMBER_FONT_CHAR_COUNT; i++) {
+        char glyph[2] = { number_font_chars[i], '\0' };
+        number_font->glyph_x[i] = atlas_width;
+        number_font->glyph_width[i] = al_get_text_width(font, glyph);
+        atlas_width += number_font->glyph_width[i] + NUMBER_FONT_PADDING;
+    }
+
+    number_font->atlas = al_create_bitmap(atlas_width, number_font->height);
+    if (!number_font->atlas) {
+        printf("Warning: number glyph atlas not created, numbers draw through the font\n");
+        return false;
+    }
+
+    ALLEGRO_BITMAP* target = al_get_target_bitmap();
+    al_set_target_bitmap(number_font->atlas);
+    al_clear_to_color(al_map_rgba(0, 0, 0, 0));
+    for (int i = 0; i < (int)NUMBER_FONT_CHAR_COUNT; i++) {
+        char glyph[2] = { number_font_chars[i], '\0' };
+        al_draw_text(font, al_map_rgb(255, 255, 255), number_font->glyph_x[i], 0, 0, glyph);
+    }
+    al_set_target_bitmap(target);
+    return true;
+}
+
+void number_font_destroy(NumberFont* number_font) {
+    if (number_font->atlas) al_destroy_bitmap(number_font->atlas);
+    number_font->atlas = NULL;
+}
+
+// ===== Drawing =====
+
+int number_font_text_width(const NumberFont* number_font, const char* text) {
+    if (!number_font->atlas) return number_font->font ? al_get_text_width(number_font->font, text) : 0;
+
+    int width = 0;
+    for (const char* c = text; *c; c++) {
+        int index = glyph_index(*c);
+        if (index >= 0) {
+            width += number_font->glyph_width[index];
+        }
+        else {
+            char glyph[2] = { *c, '\0' };
+            width += al_get_text_width(number_font->font, glyph);
+        }
+    }
+    return width;
+}
+
+int number_font_draw_text(const NumberFont* number_font, ALLEGRO_COLOR color, float x, float y, const char* text) {
+    if (!number_font->atlas) {
+        if (!number_font->font) return 0;
+        al_draw_text(number_font->font, color, x, y, 0, text);
+        return al_get_text_width(number_font->font, text);
+    }
+
+    // One batch for the whole run (unless the caller is already holding)
+    bool held = al_is_bitmap_drawing_held();
+    if (!held) al_hold_bitmap_drawing(true);
+
+    float pen = x;
+    for (const char* c = text; *c; c++) {
+        int index = glyph_index(*c);
+        if (index >= 0) {
+            al_draw_tinted_bitmap_region(number_font->atlas, color,
+                number_font->glyph_x[index], 0, number_font->glyph_width[index], number_font->height, pen, y, 0);
+            pen += number_font->glyph_width[index];
+        }
+        else {
+            char glyph[2] = { *c, '\0' };
+            al_draw_text(number_font->font, color, pen, y, 0, glyph);
+            pen += al_get_text_width(number_font->font, glyph);
+        }
+    }
+
+    if (!held) al_hold_bitmap_drawing(false);
+    return (int)(pen - x);
+}
+
+int draw_number(const NumberFont* number_font, ALLEGRO_COLOR color, float x, float y, long long value) {
+    // Digits back to front, no printf
+    char text[24];
+    char* p = text + sizeof(text) - 1;
+    *p = '\0';
+    unsigned long long magnitude = value < 0 ? 0ULL - (unsigned long long)value : (unsigned long long)value;
+    do {
+        *--p = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude > 0);
+    if (value < 0) *--p = '-';
+
+    return number_font_draw_text(number_font, color, x, y, p);
+}
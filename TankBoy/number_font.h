@@ -0,0 +1,40 @@
+#ifndef NUMBER_FONT_H
+#define NUMBER_FONT_H
+
+#include <stdbool.h>
+#include <allegro5/allegro5.h>
+#include <allegro5/allegro_font.h>
+
+// Digits and the few symbols HUD numbers use, pre-rendered once from a TTF font
+// into a one-row glyph atlas. Drawing a number is then a run of atlas quads under
+// held bitmap drawing (one batch) instead of a text layout per call. Any other
+// character falls back to the source font.
+
+#define NUMBER_FONT_CHARS "0123456789 /:-+.,%"
+#define NUMBER_FONT_CHAR_COUNT (sizeof(NUMBER_FONT_CHARS) - 1)
+
+// ===== Data Types =====
+
+typedef struct {
+    ALLEGRO_FONT* font;       // Source font (not owned)
+    ALLEGRO_BITMAP* atlas;    // White glyphs, tinted when drawn; NULL = not built
+    int glyph_x[NUMBER_FONT_CHAR_COUNT];
+    int glyph_width[NUMBER_FONT_CHAR_COUNT]; // Advance, monospaced for pressstart
+    int height;
+} NumberFont;
+
+// ===== Function Declarations =====
+
+// Render the atlas (display current on the calling thread); false leaves it unbuilt,
+// and every draw then goes through the font
+bool number_font_build(NumberFont* number_font, ALLEGRO_FONT* font);
+void number_font_destroy(NumberFont* number_font);
+
+// Width in pixels, same as al_get_text_width on the source font
+int number_font_text_width(const NumberFont* number_font, const char* text);
+
+// Top-left aligned; returns the width drawn
+int number_font_draw_text(const NumberFont* number_font, ALLEGRO_COLOR color, float x, float y, const char* text);
+int draw_number(const NumberFont* number_font, ALLEGRO_COLOR color, float x, float y, long long value);
+
+#endif // NUMBER_FONT_H
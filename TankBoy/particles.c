@@ -0,0 +1,251 @@
+#include "particles.h"
+#include "rng.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <math.h>
+#include <allegro5/allegro5.h>
+#include <allegro5/allegro_primitives.h>
+
+#define PARTICLE_MASK (PARTICLE_CAPACITY - 1)
+#define PARTICLE_VERTICES 6         // Two triangles per particle
+#define PARTICLE_DRAG 0.3           // Velocity kept after one second
+#define PARTICLE_RNG_SEED 0x5041525449434C45ULL
+
+// ===== Pool (render thread only) =====
+
+// Structure of arrays, so the update is straight float loops the compiler vectorizes
+static float particle_x[PARTICLE_CAPACITY];
+static float particle_y[PARTICLE_CAPACITY];
+static float particle_vx[PARTICLE_CAPACITY];
+static float particle_vy[PARTICLE_CAPACITY];
+static float particle_gravity[PARTICLE_CAPACITY];
+static float particle_life[PARTICLE_CAPACITY];     // Seconds left; <= 0 = dead
+static float particle_inv_life[PARTICLE_CAPACITY]; // 1 / starting life (fade)
+static float particle_size[PARTICLE_CAPACITY];
+static float particle_r[PARTICLE_CAPACITY];
+static float particle_g[PARTICLE_CAPACITY];
+static float particle_b[PARTICLE_CAPACITY];
+
+static unsigned int next_particle = 0;        // Ring write position (masked on use)
+static double particle_clock = 0.0;           // Particle time, advanced by particles_update
+static double active_until = 0.0;             // Latest death time; past it the pool is empty
+static double last_update_time = 0.0;
+static unsigned long long bursts_spawned = 0; // Burst log entries already handled
+static Rng particle_rng;
+static bool rng_ready = false;
+
+// Draw buffers, made on first draw
+typedef struct {
+    float x, y;
+    ALLEGRO_COLOR color;
+} ParticleVertex;
+
+static ParticleVertex* vertices = NULL;
+static ALLEGRO_VERTEX_DECL* vertex_decl = NULL;
+static bool draw_failed = false;
+
+// ===== Bursts (main thread) =====
+
+void particle_burst_push(ParticleBurstLog* log, ParticleBurstType type, double x, double y, double size) {
+    ParticleBurst* burst = &log->bursts[log->count % PARTICLE_BURST_LOG_SIZE];
+    burst->type = type;
+    burst->x = (float)x;
+    burst->y = (float)y;
+    burst->size = (float)size;
+    burst->time = al_get_time();
+    log->count++;
+}
+
+// ===== Spawning =====
+
+static void spawn(float x, float y, float angle, float speed, float gravity, float life, float size,
+                  float r, float g, float b) {
+    unsigned int i = next_particle++ & PARTICLE_MASK;
+    particle_x[i] = x;
+    particle_y[i] = y;
+    particle_vx[i] = cosf(angle) * speed;
+    particle_vy[i] = sinf(angle) * speed;
+    particle_gravity[i] = gravity;
+    particle_life[i] = life;
+    particle_inv_life[i] = 1.0f / life;
+    particle_size[i] = size;
+    particle_r[i] = r;
+    particle_g[i] = g;
+    particle_b[i] = b;
+    if (particle_clock + life > active_until) active_until = particle_clock + life;
+}
+
+static float random_range(float min, float max) {
+    return (float)rng_range(&particle_rng, min, max);
+}
+
+static float random_angle(void) {
+    return random_range(0.0f, 6.2831853f);
+}
+
+// Fire ball and a little smoke, sized by the splash radius
+static void spawn_explosion(float x, float y, float radius) {
+    int count = (int)(radius * 1.5f);
+    if (count < 40) count = 40;
+    if (count > 400) count = 400;
+
+    for (int i = 0; i < count; i++) {
+        if (i % 4 != 3) {
+            spawn(x, y, random_angle(), radius * random_range(1.5f, 3.0f), 150.0f,
+                random_range(0.3f, 0.7f), random_range(3.0f, 6.0f),
+                1.0f, random_range(0.3f, 0.9f), random_range(0.0f, 0.2f));
+        }
+        else {
+            float grey = random_range(0.35f, 0.5f);
+            spawn(x, y, random_angle(), radius * random_range(0.2f, 0.8f), -60.0f,
+                random_range(0.8f, 1.4f), random_range(6.0f, 10.0f), grey, grey, grey);
+        }
+    }
+}
+
+// Dirt kicked up and back from the impact
+static void spawn_dirt(float x, float y, float scale) {
+    int count = (int)(8 * scale);
+    for (int i = 0; i < count; i++) {
+        float shade = random_range(0.8f, 1.2f);
+        spawn(x, y, -1.5707963f + random_range(-1.0f, 1.0f), random_range(80.0f, 220.0f) * sqrtf(scale), 700.0f,
+            random_range(0.3f, 0.6f), random_range(2.0f, 3.0f) + scale,
+            0.45f * shade, 0.32f * shade, 0.18f * shade);
+    }
+}
+
+static void spawn_sparks(float x, float y, float damage) {
+    int count = 4 + (int)(damage / 5);
+    if (count > 24) count = 24;
+    for (int i = 0; i < count; i++) {
+        spawn(x, y, random_angle(), random_range(150.0f, 350.0f), 400.0f,
+            random_range(0.12f, 0.3f), 2.0f, 1.0f, 1.0f, random_range(0.5f, 1.0f));
+    }
+}
+
+// Burning wreck pieces, more for tougher enemies
+static void spawn_debris(float x, float y, float difficulty) {
+    int count = 40 + (int)(20 * difficulty);
+    for (int i = 0; i < count; i++) {
+        if (i % 3 == 0) {
+            spawn(x, y, random_angle(), random_range(60.0f, 300.0f), 500.0f,
+                random_range(0.4f, 0.8f), random_range(2.0f, 4.0f), 1.0f, random_range(0.4f, 0.7f), 0.1f);
+        }
+        else {
+            float grey = random_range(0.15f, 0.35f);
+            spawn(x, y, random_angle(), random_range(60.0f, 300.0f), 500.0f,
+                random_range(0.6f, 1.2f), random_range(3.0f, 6.0f), grey, grey, grey);
+        }
+    }
+}
+
+void particles_spawn_new(const ParticleBurstLog* log, double now) {
+    if (!rng_ready) {
+        rng_seed(&particle_rng, PARTICLE_RNG_SEED);
+        rng_ready = true;
+    }
+
+    // The log only holds the newest entries
+    if (log->count - bursts_spawned > PARTICLE_BURST_LOG_SIZE) bursts_spawned = log->count - PARTICLE_BURST_LOG_SIZE;
+
+    for (; bursts_spawned < log->count; bursts_spawned++) {
+        const ParticleBurst* burst = &log->bursts[bursts_spawned % PARTICLE_BURST_LOG_SIZE];
+        if (now - burst->time > PARTICLE_BURST_MAX_AGE) continue;
+
+        switch (burst->type) {
+        case PARTICLE_BURST_EXPLOSION: spawn_explosion(burst->x, burst->y, burst->size); break;
+        case PARTICLE_BURST_DIRT:      spawn_dirt(burst->x, burst->y, burst->size); break;
+        case PARTICLE_BURST_SPARKS:    spawn_sparks(burst->x, burst->y, burst->size); break;
+        case PARTICLE_BURST_DEBRIS:    spawn_debris(burst->x, burst->y, burst->size); break;
+        }
+    }
+}
+
+// ===== Update =====
+
+void particles_update(double now, double speed) {
+    double dt = last_update_time > 0.0 ? now - last_update_time : 0.0;
+    last_update_time = now;
+    if (dt > PARTICLE_MAX_DT) dt = PARTICLE_MAX_DT;
+    if (speed > 0.0) dt *= speed;
+    if (dt <= 0.0 || particle_clock >= active_until) return;
+    particle_clock += dt;
+
+    // Whole pool, no branches: dead particles drift harmlessly until reused
+    const float step = (float)dt;
+    const float drag = (float)pow(PARTICLE_DRAG, dt);
+    for (int i = 0; i < PARTICLE_CAPACITY; i++) {
+        particle_vx[i] *= drag;
+        particle_vy[i] = particle_vy[i] * drag + particle_gravity[i] * step;
+        particle_x[i] += particle_vx[i] * step;
+        particle_y[i] += particle_vy[i] * step;
+        particle_life[i] -= step;
+    }
+}
+
+// ===== Drawing =====
+
+static bool create_draw_buffers(void) {
+    ALLEGRO_VERTEX_ELEMENT elements[] = {
+        { ALLEGRO_PRIM_POSITION, ALLEGRO_PRIM_FLOAT_2, offsetof(ParticleVertex, x) },
+        { ALLEGRO_PRIM_COLOR_ATTR, 0, offsetof(ParticleVertex, color) },
+        { 0, 0, 0 }
+    };
+    vertex_decl = al_create_vertex_decl(elements, sizeof(ParticleVertex));
+    vertices = malloc(sizeof(ParticleVertex) * PARTICLE_CAPACITY * PARTICLE_VERTICES);
+    if (!vertex_decl || !vertices) {
+        printf("Warning: particle buffers not created, particles disabled\n");
+        particles_free();
+        draw_failed = true;
+        return false;
+    }
+    return true;
+}
+
+static void put_vertex(ParticleVertex* v, float x, float y, ALLEGRO_COLOR color) {
+    v->x = x;
+    v->y = y;
+    v->color = color;
+}
+
+void particles_draw(double camera_x, double camera_y, int view_width, int view_height) {
+    if (particle_clock >= active_until || draw_failed) return;
+    if (!vertices && !create_draw_buffers()) return;
+
+    const float cam_x = (float)camera_x;
+    const float cam_y = (float)camera_y;
+    ParticleVertex* v = vertices;
+
+    for (int i = 0; i < PARTICLE_CAPACITY; i++) {
+        if (particle_life[i] <= 0.0f) continue;
+
+        float half = particle_size[i] * 0.5f;
+        float x0 = particle_x[i] - cam_x - half;
+        float y0 = particle_y[i] - cam_y - half;
+        float x1 = x0 + particle_size[i];
+        float y1 = y0 + particle_size[i];
+        if (x1 < 0.0f || y1 < 0.0f || x0 > view_width || y0 > view_height) continue;
+
+        // Fade out over the lifetime (premultiplied alpha)
+        float a = particle_life[i] * particle_inv_life[i];
+        ALLEGRO_COLOR color = { particle_r[i] * a, particle_g[i] * a, particle_b[i] * a, a };
+
+        put_vertex(v++, x0, y0, color);
+        put_vertex(v++, x1, y0, color);
+        put_vertex(v++, x1, y1, color);
+        put_vertex(v++, x0, y0, color);
+        put_vertex(v++, x1, y1, color);
+        put_vertex(v++, x0, y1, color);
+    }
+
+    int count = (int)(v - vertices);
+    if (count > 0) al_draw_prim(vertices, vertex_decl, NULL, 0, count, ALLEGRO_PRIM_TRIANGLE_LIST);
+}
+
+void particles_free(void) {
+    if (vertex_decl) al_destroy_vertex_decl(vertex_decl);
+    vertex_decl = NULL;
+    free(vertices);
+    vertices = NULL;
+}
@@ -0,0 +1,57 @@
+#ifndef PARTICLES_H
+#define PARTICLES_H
+
+#include <stdbool.h>
+
+// Explosions, impact dirt, hit sparks and wreck debris. Purely visual: the
+// simulation never sees them.
+//
+// The main thread turns game events into bursts (particle_burst_push) and the
+// burst log travels in the RenderSnapshot; the render thread spawns every burst
+// it has not seen yet, moves the particles on frame time and draws them all
+// with one al_draw_prim call. Particles live in fixed structure-of-arrays
+// storage used as a ring: no allocation per particle, and when it is full the
+// oldest particles are overwritten.
+
+#define PARTICLE_CAPACITY 65536     // Power of two (the ring index is masked)
+#define PARTICLE_BURST_LOG_SIZE 256 // Bursts kept for a render thread that skipped frames
+#define PARTICLE_MAX_DT 0.1         // Longest step after a stall (s)
+#define PARTICLE_BURST_MAX_AGE 0.25 // Older bursts are dropped, not spawned late (s)
+
+// ===== Data Types =====
+
+typedef enum {
+    PARTICLE_BURST_EXPLOSION, // Cannon splash; size = splash radius
+    PARTICLE_BURST_DIRT,      // Bullet into terrain; size = 1 (MG) .. 3 (Cannon)
+    PARTICLE_BURST_SPARKS,    // Enemy hit; size = damage
+    PARTICLE_BURST_DEBRIS     // Enemy destroyed; size = difficulty
+} ParticleBurstType;
+
+typedef struct {
+    ParticleBurstType type;
+    float x, y;               // World position
+    float size;
+    double time;              // al_get_time() when pushed
+} ParticleBurst;
+
+// Every burst ever pushed, newest PARTICLE_BURST_LOG_SIZE kept; count is the running
+// total, so a reader knows which ones it has already spawned
+typedef struct {
+    ParticleBurst bursts[PARTICLE_BURST_LOG_SIZE];
+    unsigned long long count;
+} ParticleBurstLog;
+
+// ===== Function Declarations =====
+
+// Main thread
+void particle_burst_push(ParticleBurstLog* log, ParticleBurstType type, double x, double y, double size);
+
+// Render thread: spawn the recent bursts not seen yet, then step and draw
+void particles_spawn_new(const ParticleBurstLog* log, double now);
+void particles_update(double now, double speed);  // speed scales frame time (replay playback)
+void particles_draw(double camera_x, double camera_y, int view_width, int view_height);
+
+// Vertex buffer and declaration (display current on the calling thread)
+void particles_free(void);
+
+#endif // PARTICLES_H
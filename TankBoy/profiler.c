@@ -0,0 +1,340 @@
+#include "profiler.h"
+
+#ifdef TANKBOY_PROFILE
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#define PROFILE_THREAD_LOCAL __declspec(thread)
+#else
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/syscall.h>
+#define PROFILE_THREAD_LOCAL __thread
+#endif
+
+// ===== Globals =====
+static const char* scope_names[PROF_SCOPE_COUNT] = {
+    "tank_update",
+    "bullets_update",
+    "enemies_update",
+    "flying_update",
+    "hit_enemies",
+    "hit_tank",
+    "touch_ground",
+    "touch_flying",
+    "enemy_waves",
+    "stage_load",
+    "map_draw",
+    "entity_draw",
+    "particles",
+    "hud_draw",
+    "post_draw"
+};
+
+// Per thread: each thread only ever sums and clears its own scopes
+static PROFILE_THREAD_LOCAL uint64_t scope_start[PROF_SCOPE_COUNT];
+static PROFILE_THREAD_LOCAL uint64_t scope_accum[PROF_SCOPE_COUNT]; // Counter ticks in the current frame
+
+// Rolling history per frame kind (ring buffers, pos = next slot to write), guarded by profiler_lock
+typedef struct {
+    float scope_history[PROF_SCOPE_COUNT][PROFILE_HISTORY];
+    float frame_history[PROFILE_HISTORY];
+    int pos;
+    int count;
+    uint64_t last_end;
+} FrameHistory;
+
+static FrameHistory histories[PROFILE_FRAME_COUNT];
+static volatile long overlay_visible = 0;
+
+// Trace capture ring (allocated once by profiler_trace_start, never grown)
+typedef struct {
+    uint64_t begin;
+    uint64_t end;
+    uint32_t thread_id;
+    uint16_t scope;
+} TraceEvent;
+
+static TraceEvent* trace_events = NULL;
+static int64_t trace_next = 0;                 // Total events ever recorded, guarded by profiler_lock
+static volatile long trace_active = 0;
+static PROFILE_THREAD_LOCAL uint32_t cached_thread_id = 0;
+
+#ifdef _WIN32
+static SRWLOCK profiler_lock = SRWLOCK_INIT;
+#else
+static pthread_mutex_t profiler_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+// ===== Clock =====
+
+static uint64_t profiler_now(void) {
+#ifdef _WIN32
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    return (uint64_t)counter.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+static uint32_t profiler_thread_id(void) {
+    if (cached_thread_id == 0) {
+#ifdef _WIN32
+        cached_thread_id = (uint32_t)GetCurrentThreadId();
+#else
+        cached_thread_id = (uint32_t)syscall(SYS_gettid);
+#endif
+    }
+    return cached_thread_id;
+}
+
+static double profiler_ms_per_tick(void) {
+#ifdef _WIN32
+    LARGE_INTEGER frequency;
+    QueryPerformanceFrequency(&frequency);
+    return 1000.0 / (double)frequency.QuadPart;
+#else
+    return 1e-6;
+#endif
+}
+
+// ===== Locking =====
+
+// Everything shared between threads (histories, trace ring) is touched under this lock
+static void profiler_lock_acquire(void) {
+#ifdef _WIN32
+    AcquireSRWLockExclusive(&profiler_lock);
+#else
+    pthread_mutex_lock(&profiler_lock);
+#endif
+}
+
+static void profiler_lock_release(void) {
+#ifdef _WIN32
+    ReleaseSRWLockExclusive(&profiler_lock);
+#else
+    pthread_mutex_unlock(&profiler_lock);
+#endif
+}
+
+// Flags flipped from the main thread and polled from any thread
+static void flag_store(volatile long* flag, long value) {
+#ifdef _WIN32
+    InterlockedExchange(flag, value);
+#else
+    __atomic_store_n(flag, value, __ATOMIC_SEQ_CST);
+#endif
+}
+
+static long flag_load(volatile long* flag) {
+#ifdef _WIN32
+    return InterlockedCompareExchange(flag, 0, 0);
+#else
+    return __atomic_load_n(flag, __ATOMIC_SEQ_CST);
+#endif
+}
+
+// Simulation scopes come first in ProfileScope, rendering from PROF_MAP_DRAW on
+static ProfileFrame scope_frame(int scope) {
+    return scope < PROF_MAP_DRAW ? PROFILE_FRAME_SIM : PROFILE_FRAME_RENDER;
+}
+
+// ===== Scope Timing =====
+
+void profiler_begin(ProfileScope scope) {
+    scope_start[scope] = profiler_now();
+}
+
+void profiler_end(ProfileScope scope) {
+    uint64_t now = profiler_now();
+    scope_accum[scope] += now - scope_start[scope];
+
+    if (flag_load(&trace_active)) {
+        uint32_t thread_id = profiler_thread_id();
+        profiler_lock_acquire();
+        TraceEvent* event = &trace_events[trace_next++ % PROFILE_TRACE_CAPACITY];
+        event->begin = scope_start[scope];
+        event->end = now;
+        event->thread_id = thread_id;
+        event->scope = (uint16_t)scope;
+        profiler_lock_release();
+    }
+}
+
+void profiler_frame_end(ProfileFrame frame) {
+    double to_ms = profiler_ms_per_tick();
+    uint64_t now = profiler_now();
+    FrameHistory* history = &histories[frame];
+
+    profiler_lock_acquire();
+    // The first call only starts the frame clock
+    if (history->last_end != 0) {
+        history->frame_history[history->pos] = (float)((now - history->last_end) * to_ms);
+        for (int i = 0; i < PROF_SCOPE_COUNT; i++) {
+            if (scope_frame(i) != frame) continue;
+            history->scope_history[i][history->pos] = (float)(scope_accum[i] * to_ms);
+        }
+        history->pos = (history->pos + 1) % PROFILE_HISTORY;
+        if (history->count < PROFILE_HISTORY) history->count++;
+    }
+    history->last_end = now;
+    profiler_lock_release();
+
+    // Only this kind's scopes: the other kind may still be accumulating on this thread
+    for (int i = 0; i < PROF_SCOPE_COUNT; i++) {
+        if (scope_frame(i) == frame) scope_accum[i] = 0;
+    }
+}
+
+// ===== Statistics =====
+
+static int compare_float(const void* a, const void* b) {
+    float fa = *(const float*)a;
+    float fb = *(const float*)b;
+    return (fa > fb) - (fa < fb);
+}
+
+const char* profiler_scope_name(ProfileScope scope) {
+    return scope_names[scope];
+}
+
+double profiler_scope_average_ms(ProfileScope scope) {
+    const FrameHistory* history = &histories[scope_frame(scope)];
+
+    profiler_lock_acquire();
+    int count = history->count;
+    double sum = 0.0;
+    for (int i = 0; i < count; i++) sum += history->scope_history[scope][i];
+    profiler_lock_release();
+
+    return count > 0 ? sum / count : 0.0;
+}
+
+// Sorted on demand: only the overlay and reports ask, never the timed paths
+double profiler_frame_percentile_ms(ProfileFrame frame, double percentile) {
+    float sorted[PROFILE_HISTORY];
+
+    profiler_lock_acquire();
+    int count = histories[frame].count;
+    memcpy(sorted, histories[frame].frame_history, sizeof(float) * count);
+    profiler_lock_release();
+
+    if (count == 0) return 0.0;
+    qsort(sorted, count, sizeof(float), compare_float);
+
+    int index = (int)(percentile / 100.0 * (count - 1) + 0.5);
+    if (index < 0) index = 0;
+    if (index >= count) index = count - 1;
+    return sorted[index];
+}
+
+int profiler_frame_count(ProfileFrame frame) {
+    profiler_lock_acquire();
+    int count = histories[frame].count;
+    profiler_lock_release();
+    return count;
+}
+
+// ===== Overlay & Report =====
+
+void profiler_toggle_overlay(void) {
+    flag_store(&overlay_visible, !flag_load(&overlay_visible));
+}
+
+bool profiler_overlay_visible(void) {
+    return flag_load(&overlay_visible) != 0;
+}
+
+void profiler_print_report(FILE* out) {
+    static const char* frame_labels[PROFILE_FRAME_COUNT] = { "sim ticks", "render frames" };
+
+    for (ProfileFrame frame = PROFILE_FRAME_SIM; frame < PROFILE_FRAME_COUNT; frame++) {
+        int count = profiler_frame_count(frame);
+        if (count == 0) continue;   // e.g. no render frames in the headless runner
+
+        fprintf(out, "Profile over last %d %s: p50 %.3f ms, p99 %.3f ms\n", count, frame_labels[frame],
+            profiler_frame_percentile_ms(frame, 50.0), profiler_frame_percentile_ms(frame, 99.0));
+        for (int i = 0; i < PROF_SCOPE_COUNT; i++) {
+            if (scope_frame(i) != frame) continue;
+            fprintf(out, "  %-16s %8.4f ms\n", scope_names[i], profiler_scope_average_ms((ProfileScope)i));
+        }
+    }
+}
+
+// ===== Trace Capture =====
+
+void profiler_trace_start(void) {
+    if (!trace_events) {
+        trace_events = malloc(sizeof(TraceEvent) * PROFILE_TRACE_CAPACITY);
+        if (!trace_events) {
+            printf("Warning: Could not allocate trace buffer\n");
+            return;
+        }
+    }
+    profiler_lock_acquire();
+    trace_next = 0;
+    profiler_lock_release();
+    flag_store(&trace_active, 1);
+}
+
+void profiler_trace_stop(void) {
+    flag_store(&trace_active, 0);
+}
+
+bool profiler_trace_active(void) {
+    return flag_load(&trace_active) != 0;
+}
+
+bool profiler_trace_write(const char* path) {
+    if (!trace_events) return false;
+
+    // Snapshot the ring first: other threads keep recording while the file is formatted
+    TraceEvent* snapshot = malloc(sizeof(TraceEvent) * PROFILE_TRACE_CAPACITY);
+    if (!snapshot) {
+        printf("Warning: Could not allocate trace snapshot\n");
+        return false;
+    }
+    profiler_lock_acquire();
+    int64_t total = trace_next;
+    memcpy(snapshot, trace_events, sizeof(TraceEvent) * PROFILE_TRACE_CAPACITY);
+    profiler_lock_release();
+
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        printf("Warning: Could not write trace file: %s\n", path);
+        free(snapshot);
+        return false;
+    }
+
+    // Oldest surviving event first; timestamps relative to it, in microseconds
+    int64_t first = total > PROFILE_TRACE_CAPACITY ? total - PROFILE_TRACE_CAPACITY : 0;
+    double to_us = profiler_ms_per_tick() * 1000.0;
+    uint64_t origin = total > first ? snapshot[first % PROFILE_TRACE_CAPACITY].begin : 0;
+
+    fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    for (int64_t i = first; i < total; i++) {
+        const TraceEvent* event = &snapshot[i % PROFILE_TRACE_CAPACITY];
+        double ts = event->begin >= origin ? (event->begin - origin) * to_us : 0.0;
+        fprintf(file, "%s{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}\n",
+            i > first ? "," : "", scope_names[event->scope], ts, (event->end - event->begin) * to_us,
+            (unsigned)event->thread_id);
+    }
+    fprintf(file, "]}\n");
+    fclose(file);
+    free(snapshot);
+
+    printf("Trace written: %s (%d events)\n", path, (int)(total - first));
+    return true;
+}
+
+#endif // TANKBOY_PROFILE
@@ -0,0 +1,101 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdbool.h>
+#include <stdio.h>
+
+// Per-subsystem frame profiler.
+// Scopes are timed with PROFILE_BEGIN/PROFILE_END and summed per frame;
+// PROFILE_FRAME_END closes a frame and pushes the sums into a rolling history.
+// Build with TANKBOY_PROFILE defined to enable it (Debug configuration);
+// without it every macro below expands to nothing.
+//
+// Threads: scope sums are thread-local, so PROFILE_BEGIN/PROFILE_END are safe
+// from any thread. Simulation and rendering keep separate histories:
+// PROFILE_FRAME_END(PROFILE_FRAME_SIM) belongs on the thread that steps the
+// world (main thread), PROFILE_FRAME_END(PROFILE_FRAME_RENDER) on the render
+// thread, each closing only the scopes that thread timed. One history per kind,
+// so only one thread per kind may end frames (the batch runner's workers can't).
+// The statistics, report, overlay and trace functions lock or copy and are safe
+// from any thread.
+//
+// Trace capture (profiler_trace_start) additionally records every scope with
+// begin/end timestamps and thread id into a preallocated ring buffer, dumped
+// as Chrome trace_event JSON for chrome://tracing or Perfetto. Writing copies
+// the ring first, so the render thread may keep recording during an F4 dump.
+
+#define PROFILE_HISTORY 240 // Frames kept per scope (4 s at 60 fps)
+#define PROFILE_TRACE_CAPACITY 65536 // Trace events kept (about 1.5 MB, over a minute of play)
+#define PROFILE_TRACE_FILE "TankBoy/trace.json"
+
+// ===== Data Types =====
+
+typedef enum {
+    // Simulation
+    PROF_TANK_UPDATE,
+    PROF_BULLETS_UPDATE,
+    PROF_ENEMIES_UPDATE,
+    PROF_FLYING_ENEMIES_UPDATE,
+    PROF_BULLETS_HIT_ENEMIES,
+    PROF_BULLETS_HIT_TANK,
+    PROF_TANK_TOUCH_GROUND,
+    PROF_TANK_TOUCH_FLYING,
+    PROF_ENEMY_WAVES,
+    PROF_STAGE_LOAD,
+
+    // Rendering
+    PROF_MAP_DRAW,
+    PROF_ENTITY_DRAW,
+    PROF_PARTICLES,
+    PROF_HUD_DRAW,
+    PROF_DISP_POST_DRAW,
+
+    PROF_SCOPE_COUNT
+} ProfileScope;
+
+// Which history a frame end closes; the scopes above split the same way
+typedef enum {
+    PROFILE_FRAME_SIM,      // One world step (main thread, headless runner)
+    PROFILE_FRAME_RENDER,   // One drawn frame (render thread)
+    PROFILE_FRAME_COUNT
+} ProfileFrame;
+
+// ===== Function Declarations =====
+
+#ifdef TANKBOY_PROFILE
+
+// Scope timing (sums repeated scopes within a frame, per calling thread)
+void profiler_begin(ProfileScope scope);
+void profiler_end(ProfileScope scope);
+void profiler_frame_end(ProfileFrame frame);
+
+// Rolling statistics over the history window (scopes report from their own kind)
+const char* profiler_scope_name(ProfileScope scope);
+double profiler_scope_average_ms(ProfileScope scope);
+double profiler_frame_percentile_ms(ProfileFrame frame, double percentile); // 0..100
+int profiler_frame_count(ProfileFrame frame);
+
+// Overlay toggle and text report
+void profiler_toggle_overlay(void);
+bool profiler_overlay_visible(void);
+void profiler_print_report(FILE* out);
+
+// Trace capture: the ring keeps the newest PROFILE_TRACE_CAPACITY events
+void profiler_trace_start(void);
+void profiler_trace_stop(void);
+bool profiler_trace_active(void);
+bool profiler_trace_write(const char* path);   // Chrome trace_event JSON
+
+#define PROFILE_BEGIN(scope) profiler_begin(scope)
+#define PROFILE_END(scope) profiler_end(scope)
+#define PROFILE_FRAME_END(frame) profiler_frame_end(frame)
+
+#else
+
+#define PROFILE_BEGIN(scope) ((void)0)
+#define PROFILE_END(scope) ((void)0)
+#define PROFILE_FRAME_END(frame) ((void)0)
+
+#endif // TANKBOY_PROFILE
+
+#endif // PROFILER_H
@@ -0,0 +1,61 @@
+#include "profiler_render.h"
+
+#ifdef TANKBOY_PROFILE
+
+#include <stdio.h>
+#include <allegro5/allegro5.h>
+#include <allegro5/allegro_font.h>
+#include <allegro5/allegro_primitives.h>
+
+#define OVERLAY_LINE_HEIGHT 10
+#define OVERLAY_WIDTH 230
+
+// ===== Globals =====
+static ALLEGRO_FONT* overlay_font = NULL; // 8x8 builtin font, created on first draw
+
+// ===== Overlay =====
+
+void profiler_overlay_draw(int x, int y) {
+    if (!profiler_overlay_visible()) return;
+
+    if (!overlay_font) {
+        overlay_font = al_create_builtin_font();
+        if (!overlay_font) return;
+    }
+
+    int lines = PROF_SCOPE_COUNT + 2;
+    al_draw_filled_rectangle(x, y, x + OVERLAY_WIDTH, y + lines * OVERLAY_LINE_HEIGHT + 8,
+        al_map_rgba(0, 0, 0, 180));
+
+    ALLEGRO_COLOR header = al_map_rgb(255, 255, 0);
+    ALLEGRO_COLOR text = al_map_rgb(255, 255, 255);
+    char line[64];
+    int ty = y + 4;
+
+    snprintf(line, sizeof(line), "frame p50 %6.2f  p99 %6.2f ms",
+        profiler_frame_percentile_ms(PROFILE_FRAME_RENDER, 50.0),
+        profiler_frame_percentile_ms(PROFILE_FRAME_RENDER, 99.0));
+    al_draw_text(overlay_font, header, x + 4, ty, 0, line);
+    ty += OVERLAY_LINE_HEIGHT;
+
+    snprintf(line, sizeof(line), "avg %d frames, %d ticks",
+        profiler_frame_count(PROFILE_FRAME_RENDER), profiler_frame_count(PROFILE_FRAME_SIM));
+    al_draw_text(overlay_font, header, x + 4, ty, 0, line);
+    ty += OVERLAY_LINE_HEIGHT;
+
+    for (int i = 0; i < PROF_SCOPE_COUNT; i++) {
+        snprintf(line, sizeof(line), "%-15s %7.3f ms",
+            profiler_scope_name((ProfileScope)i), profiler_scope_average_ms((ProfileScope)i));
+        al_draw_text(overlay_font, text, x + 4, ty, 0, line);
+        ty += OVERLAY_LINE_HEIGHT;
+    }
+}
+
+void profiler_overlay_deinit(void) {
+    if (overlay_font) {
+        al_destroy_font(overlay_font);
+        overlay_font = NULL;
+    }
+}
+
+#endif // TANKBOY_PROFILE
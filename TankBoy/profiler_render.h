@@ -0,0 +1,14 @@
+#ifndef PROFILER_RENDER_H
+#define PROFILER_RENDER_H
+
+#include "profiler.h"
+
+#ifdef TANKBOY_PROFILE
+
+// On-screen profiler overlay (toggled with F3), drawn last into the game buffer
+void profiler_overlay_draw(int x, int y);
+void profiler_overlay_deinit(void);
+
+#endif // TANKBOY_PROFILE
+
+#endif // PROFILER_RENDER_H
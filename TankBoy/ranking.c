@@ -267,6 +267,12 @@ int ranking_get_count(void) {
     return g_ranking_system.count;
 }
 
+int ranking_copy_top(RankingEntry* out, int max_entries) {
+    int count = (g_ranking_system.count < max_entries) ? g_ranking_system.count : max_entries;
+    if (count > 0) memcpy(out, g_ranking_system.entries, count * sizeof(RankingEntry));
+    return count;
+}
+
 int ranking_get_player_rank(int score) {
     for (int i = 0; i < g_ranking_system.count; i++) {
         if (score >= g_ranking_system.entries[i].score) {
@@ -278,7 +284,7 @@ int ranking_get_player_rank(int score) {
 
 // ===== Display Functions =====
 
-void ranking_draw(double camera_x, double camera_y) {
+void ranking_draw(const RankingEntry* entries, int count) {
     if (!g_ranking_font) return;
     
     // Draw title
@@ -287,10 +293,10 @@ void ranking_draw(double camera_x, double camera_y) {
     // Draw header
     al_draw_text(g_ranking_font, al_map_rgb(200, 200, 200), 50, 100, 0, "Rank  Name             Score   Stage   Date");
     
-    // Draw rankings (top 10 only)
-    int max_display = (g_ranking_system.count < 10) ? g_ranking_system.count : 10;
+    // Draw rankings (top RANKING_DISPLAY_COUNT only)
+    int max_display = (count < RANKING_DISPLAY_COUNT) ? count : RANKING_DISPLAY_COUNT;
     for (int i = 0; i < max_display; i++) {
-        RankingEntry* entry = &g_ranking_system.entries[i];
+        const RankingEntry* entry = &entries[i];
         char line[256];
         
         // Format: "1.    aaaaa    15000   3      2024-01-01 12:00"
@@ -7,6 +7,7 @@
 #define MAX_RANKINGS 100
 #define MAX_NAME_LENGTH 7
 #define DEFAULT_PLAYER_NAME "aaaaa"
+#define RANKING_DISPLAY_COUNT 10  // Entries shown on the ranking screen
 
 // ===== Data Types =====
 typedef struct {
@@ -40,9 +41,10 @@ bool ranking_save_to_csv(const char* filename);
 RankingEntry* ranking_get_entry(int index);
 int ranking_get_count(void);
 int ranking_get_player_rank(int score);
+int ranking_copy_top(RankingEntry* out, int max_entries);  // Copy of the best entries, returns how many
 
-// Display rankings
-void ranking_draw(double camera_x, double camera_y);
+// Display rankings (entries from ranking_copy_top, so drawing never reads the live table)
+void ranking_draw(const RankingEntry* entries, int count);
 
 // Check if score qualifies for ranking
 bool ranking_is_high_score(int score);
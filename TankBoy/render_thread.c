@@ -0,0 +1,189 @@
+#include "render_thread.h"
+#include "triple_buffer.h"
+#include "frame_stats.h"
+#include "profiler.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RENDER_SNAPSHOT_SLOTS 3
+#define RENDER_EVENT_WAKE ALLEGRO_GET_EVENT_TYPE('T', 'B', 'R', 'W')
+
+// Set up by render_thread_start before the thread runs, read-only afterwards
+static ALLEGRO_THREAD* render_thread = NULL;
+static ALLEGRO_DISPLAY* render_display = NULL;
+static const GameSystem* render_game_system = NULL;
+static int render_refresh_rate = SIM_TICK_RATE;
+
+static RenderSnapshot* snapshot_slots[RENDER_SNAPSHOT_SLOTS];
+static TripleBuffer snapshot_buffer;
+
+// Wakes the render thread when its timer is stopped (still screens, shutdown)
+static ALLEGRO_EVENT_SOURCE wake_source;
+static bool last_published_idle = false; // Main thread only
+
+// ===== Snapshot Slots =====
+
+static RenderSnapshot* snapshot_create(int max_bullets) {
+    RenderSnapshot* snapshot = calloc(1, sizeof(RenderSnapshot));
+    if (!snapshot) return NULL;
+
+    snapshot->bullets = calloc(max_bullets, sizeof(Bullet));
+    if (!snapshot->bullets || !map_init(&snapshot->map)) {
+        free(snapshot->bullets);
+        free(snapshot);
+        return NULL;
+    }
+    return snapshot;
+}
+
+static void snapshot_destroy(RenderSnapshot* snapshot) {
+    if (!snapshot) return;
+    map_free(&snapshot->map);
+    free(snapshot->bullets);
+    free(snapshot);
+}
+
+static void free_snapshot_slots(void) {
+    for (int i = 0; i < RENDER_SNAPSHOT_SLOTS; i++) {
+        snapshot_destroy(snapshot_slots[i]);
+        snapshot_slots[i] = NULL;
+    }
+}
+
+// ===== Render Loop =====
+
+// The snapshot's alpha, moved on by the time since it was published (never past the newest tick)
+static double interpolation_alpha(const RenderSnapshot* snapshot, double now) {
+    double alpha = snapshot->alpha;
+    if (snapshot->tick_speed > 0.0) alpha += (now - snapshot->publish_time) * snapshot->tick_speed / SIM_DT;
+    if (alpha > 1.0) alpha = 1.0;
+    return alpha;
+}
+
+static void wake_render_thread(void) {
+    ALLEGRO_EVENT event;
+    event.user.type = RENDER_EVENT_WAKE;
+    al_emit_user_event(&wake_source, &event, NULL);
+}
+
+static void* render_thread_main(ALLEGRO_THREAD* thread, void* arg) {
+    (void)arg;
+    al_set_target_backbuffer(render_display);
+
+    // Own refresh timer: frames are paced here, not by the simulation loop
+    ALLEGRO_EVENT_QUEUE* queue = al_create_event_queue();
+    ALLEGRO_TIMER* timer = al_create_timer(1.0 / render_refresh_rate);
+    if (!queue || !timer) {
+        printf("Error: render thread timer init failed\n");
+        if (queue) al_destroy_event_queue(queue);
+        if (timer) al_destroy_timer(timer);
+        al_set_target_bitmap(NULL);
+        return NULL;
+    }
+    al_register_event_source(queue, al_get_timer_event_source(timer));
+    al_register_event_source(queue, &wake_source);
+    al_start_timer(timer);
+
+    ALLEGRO_EVENT event;
+    double last_frame_time = 0.0;
+
+    while (!al_get_thread_should_stop(thread)) {
+        al_wait_for_event(queue, &event);
+        // Fell behind (slow frame): skip the missed refreshes, draw once
+        if (!al_is_event_queue_empty(queue)) continue;
+
+        bool fresh;
+        const RenderSnapshot* snapshot = triple_buffer_read_slot(&snapshot_buffer, &fresh);
+        if (!snapshot->valid) continue;
+
+        // Still screens: timer off, one frame per published change.
+        // Gameplay: every refresh, and a wake-up restarts the timer.
+        if (snapshot->idle) {
+            if (al_get_timer_started(timer)) al_stop_timer(timer);
+            if (!fresh) continue;
+        }
+        else if (!al_get_timer_started(timer)) {
+            al_start_timer(timer);
+        }
+
+        render_game(render_game_system, snapshot, interpolation_alpha(snapshot, al_get_time()));
+        PROFILE_FRAME_END(PROFILE_FRAME_RENDER);
+
+        // Frame time = render-to-render interval, bucketed under the state just drawn
+        // (on-demand frames have no interval worth recording)
+        double frame_time = snapshot->idle ? 0.0 : al_get_time();
+        if (last_frame_time > 0.0 && frame_time > 0.0) {
+            frame_stats_record_frame((frame_time - last_frame_time) * 1000.0, snapshot->state);
+        }
+        last_frame_time = frame_time;
+    }
+
+    al_destroy_timer(timer);
+    al_destroy_event_queue(queue);
+    al_set_target_bitmap(NULL);
+    return NULL;
+}
+
+// ===== Control =====
+
+bool render_thread_start(const GameSystem* game_system, ALLEGRO_DISPLAY* display, int refresh_rate) {
+    for (int i = 0; i < RENDER_SNAPSHOT_SLOTS; i++) {
+        snapshot_slots[i] = snapshot_create(game_system->world.max_bullets);
+        if (!snapshot_slots[i]) {
+            printf("Error: render snapshot allocation failed\n");
+            free_snapshot_slots();
+            return false;
+        }
+    }
+    triple_buffer_init(&snapshot_buffer, snapshot_slots[0], snapshot_slots[1], snapshot_slots[2]);
+
+    render_game_system = game_system;
+    render_display = display;
+    render_refresh_rate = refresh_rate > 0 ? refresh_rate : SIM_TICK_RATE;
+    al_init_user_event_source(&wake_source);
+
+    render_thread = al_create_thread(render_thread_main, NULL);
+    if (!render_thread) {
+        printf("Error: render thread create failed\n");
+        al_destroy_user_event_source(&wake_source);
+        free_snapshot_slots();
+        return false;
+    }
+
+    // A display can only be current on one thread
+    al_set_target_bitmap(NULL);
+    al_start_thread(render_thread);
+    return true;
+}
+
+void render_thread_publish(GameSystem* game_system, double alpha, double tick_speed) {
+    RenderSnapshot* snapshot = triple_buffer_write_slot(&snapshot_buffer);
+    game_system_fill_snapshot(game_system, snapshot);
+    snapshot->alpha = alpha;
+    snapshot->publish_time = al_get_time();
+    snapshot->tick_speed = tick_speed;
+    snapshot->valid = true;
+    bool idle = snapshot->idle;
+    triple_buffer_publish(&snapshot_buffer);
+
+    // Its timer is off on still screens, including the one being left
+    if (idle || last_published_idle) wake_render_thread();
+    last_published_idle = idle;
+}
+
+void render_thread_stop(ALLEGRO_DISPLAY* display) {
+    if (!render_thread) return;
+
+    // It may be blocked with its timer off: flag, then wake it
+    al_set_thread_should_stop(render_thread);
+    wake_render_thread();
+    al_join_thread(render_thread, NULL);
+    al_destroy_thread(render_thread);
+    al_destroy_user_event_source(&wake_source);
+    render_thread = NULL;
+    free_snapshot_slots();
+
+    // Cleanup destroys video bitmaps, which needs the display current again
+    al_set_target_backbuffer(display);
+}
@@ -0,0 +1,31 @@
+#ifndef RENDER_THREAD_H
+#define RENDER_THREAD_H
+
+#include <stdbool.h>
+#include <allegro5/allegro5.h>
+#include "game_system.h"
+
+// Drawing runs on its own thread so a slow frame (big window, driver stall,
+// vsync wait) never holds up a simulation tick. The main thread keeps input,
+// audio and the fixed-tick simulation, and publishes a RenderSnapshot after
+// each batch of ticks; the render thread draws the newest one at the display
+// refresh rate. Snapshots go through a lock-free triple buffer (triple_buffer.h).
+// Still screens (game_system_is_idle) are the exception: the thread stops its
+// timer and draws once per published snapshot, so both threads sit blocked in
+// al_wait_for_event until something changes.
+//
+// The display belongs to the render thread between start and stop: the main
+// thread must not draw or create video bitmaps in that window.
+
+// Call once everything is loaded; releases the display from the calling thread
+bool render_thread_start(const GameSystem* game_system, ALLEGRO_DISPLAY* display, int refresh_rate);
+
+// Main thread: copy the game into the next snapshot and hand it over.
+// alpha: interpolation at this moment; tick_speed: sim ticks per real tick
+// (0 when uncapped), used to keep interpolating until the next snapshot.
+void render_thread_publish(GameSystem* game_system, double alpha, double tick_speed);
+
+// Stops and joins the thread, then makes the display current here again
+void render_thread_stop(ALLEGRO_DISPLAY* display);
+
+#endif // RENDER_THREAD_H
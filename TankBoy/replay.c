@@ -0,0 +1,277 @@
+#include "replay.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define REPLAY_HEADER_SIZE 16
+#define REPLAY_OP_AIM 0x20
+#define REPLAY_OP_COMMAND 0x40
+#define REPLAY_OP_REPEAT 0x80
+#define REPLAY_MAX_REPEAT 128
+
+// ===== Globals =====
+
+// Recorder: repeated ticks are held back and written as one run
+static FILE* record_file = NULL;
+static uint8_t record_bits = 0;
+static double record_aim = 0.0;
+static bool record_has_tick = false;
+static int record_pending_repeats = 0;
+
+// Shared player for replay_play_begin and friends
+static ReplayPlayer playback = { 0 };
+
+// ===== Helpers =====
+
+static uint8_t pack_input(const InputState* input) {
+    return (uint8_t)((input->left ? 0x01 : 0) | (input->right ? 0x02 : 0) | (input->jump ? 0x04 : 0)
+        | (input->change_weapon ? 0x08 : 0) | (input->fire ? 0x10 : 0));
+}
+
+static void unpack_input(uint8_t bits, InputState* input) {
+    memset(input, 0, sizeof(*input));
+    input->left = (bits & 0x01) != 0;
+    input->right = (bits & 0x02) != 0;
+    input->jump = (bits & 0x04) != 0;
+    input->change_weapon = (bits & 0x08) != 0;
+    input->fire = (bits & 0x10) != 0;
+}
+
+static void write_u64(uint8_t* out, uint64_t value) {
+    for (int i = 0; i < 8; i++) out[i] = (uint8_t)(value >> (8 * i));
+}
+
+static uint64_t read_u64(const uint8_t* in) {
+    uint64_t value = 0;
+    for (int i = 0; i < 8; i++) value |= (uint64_t)in[i] << (8 * i);
+    return value;
+}
+
+static void flush_repeats(void) {
+    if (record_pending_repeats > 0) {
+        fputc(REPLAY_OP_REPEAT | (record_pending_repeats - 1), record_file);
+        record_pending_repeats = 0;
+    }
+}
+
+// ===== Recording =====
+
+bool replay_record_begin(const char* path, uint64_t seed, int tick_rate) {
+    replay_record_end();
+
+    record_file = fopen(path, "wb");
+    if (!record_file) {
+        printf("Warning: Could not open replay file for writing: %s\n", path);
+        return false;
+    }
+
+    uint8_t header[REPLAY_HEADER_SIZE] = { 'T', 'B', 'R', 'P' };
+    header[4] = (uint8_t)(REPLAY_VERSION & 0xFF);
+    header[5] = (uint8_t)(REPLAY_VERSION >> 8);
+    header[6] = (uint8_t)(tick_rate & 0xFF);
+    header[7] = (uint8_t)(tick_rate >> 8);
+    write_u64(&header[8], seed);
+    fwrite(header, 1, sizeof(header), record_file);
+
+    record_has_tick = false;
+    record_pending_repeats = 0;
+    return true;
+}
+
+void replay_record_tick(const InputState* input, double aim_angle) {
+    if (!record_file) return;
+
+    uint8_t bits = pack_input(input);
+    if (record_has_tick && bits == record_bits && aim_angle == record_aim) {
+        if (++record_pending_repeats == REPLAY_MAX_REPEAT) flush_repeats();
+        return;
+    }
+
+    flush_repeats();
+    bool aim_changed = !record_has_tick || aim_angle != record_aim;
+    fputc(bits | (aim_changed ? REPLAY_OP_AIM : 0), record_file);
+    if (aim_changed) {
+        uint64_t raw;
+        uint8_t bytes[8];
+        memcpy(&raw, &aim_angle, sizeof(raw));
+        write_u64(bytes, raw);
+        fwrite(bytes, 1, sizeof(bytes), record_file);
+    }
+
+    record_bits = bits;
+    record_aim = aim_angle;
+    record_has_tick = true;
+}
+
+void replay_record_command(ReplayCommand command) {
+    if (!record_file) return;
+
+    flush_repeats();
+    fputc(REPLAY_OP_COMMAND | command, record_file);
+}
+
+void replay_record_end(void) {
+    if (!record_file) return;
+
+    replay_record_command(REPLAY_CMD_END);
+    fclose(record_file);
+    record_file = NULL;
+}
+
+bool replay_is_recording(void) {
+    return record_file != NULL;
+}
+
+// ===== Playback =====
+
+bool replay_player_open(ReplayPlayer* player, const char* path) {
+    memset(player, 0, sizeof(*player));
+
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        printf("Warning: Could not open replay file: %s\n", path);
+        return false;
+    }
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (size < REPLAY_HEADER_SIZE) {
+        printf("Warning: Replay file too short: %s\n", path);
+        fclose(file);
+        return false;
+    }
+
+    uint8_t* data = malloc((size_t)size);
+    if (!data || fread(data, 1, (size_t)size, file) != (size_t)size) {
+        printf("Warning: Could not read replay file: %s\n", path);
+        free(data);
+        fclose(file);
+        return false;
+    }
+    fclose(file);
+
+    int version = data[4] | (data[5] << 8);
+    if (memcmp(data, "TBRP", 4) != 0 || version != REPLAY_VERSION) {
+        printf("Warning: Not a version %d replay file: %s\n", REPLAY_VERSION, path);
+        free(data);
+        return false;
+    }
+
+    player->data = data;
+    player->size = (size_t)size;
+    player->pos = REPLAY_HEADER_SIZE;
+    player->tick_rate = data[6] | (data[7] << 8);
+    player->seed = read_u64(&data[8]);
+    return true;
+}
+
+bool replay_player_next_command(ReplayPlayer* player, ReplayCommand* command) {
+    if (!player->data || player->repeats_left > 0) return false;
+
+    // Running off the end (e.g. a session that crashed) reads as END
+    if (player->pos >= player->size) {
+        *command = REPLAY_CMD_END;
+        return true;
+    }
+
+    uint8_t op = player->data[player->pos];
+    if ((op & (REPLAY_OP_REPEAT | REPLAY_OP_COMMAND)) != REPLAY_OP_COMMAND) return false;
+
+    player->pos++;
+    *command = (ReplayCommand)(op & 0x3F);
+    return true;
+}
+
+bool replay_player_read_tick(ReplayPlayer* player, InputState* input, double* aim_angle) {
+    if (!player->data) return false;
+
+    if (player->repeats_left > 0) {
+        player->repeats_left--;
+    }
+    else {
+        if (player->pos >= player->size) return false;
+
+        uint8_t op = player->data[player->pos];
+        if (op & REPLAY_OP_REPEAT) {
+            player->repeats_left = op & 0x7F; // This tick is the first of n + 1
+            player->pos++;
+        }
+        else if (op & REPLAY_OP_COMMAND) {
+            return false;
+        }
+        else {
+            player->pos++;
+            player->bits = op & 0x1F;
+            if (op & REPLAY_OP_AIM) {
+                if (player->pos + 8 > player->size) return false;
+                uint64_t raw = read_u64(&player->data[player->pos]);
+                memcpy(&player->aim, &raw, sizeof(player->aim));
+                player->pos += 8;
+            }
+        }
+    }
+
+    unpack_input(player->bits, input);
+    *aim_angle = player->aim;
+    player->ticks++;
+    return true;
+}
+
+void replay_player_close(ReplayPlayer* player) {
+    free(player->data);
+    player->data = NULL;
+    player->size = 0;
+    player->pos = 0;
+}
+
+bool replay_play_begin(const char* path) {
+    replay_play_end();
+    return replay_player_open(&playback, path);
+}
+
+uint64_t replay_seed(void) {
+    return playback.seed;
+}
+
+int replay_tick_rate(void) {
+    return playback.tick_rate;
+}
+
+bool replay_next_command(ReplayCommand* command) {
+    return replay_player_next_command(&playback, command);
+}
+
+bool replay_read_tick(InputState* input, double* aim_angle) {
+    return replay_player_read_tick(&playback, input, aim_angle);
+}
+
+void replay_play_end(void) {
+    replay_player_close(&playback);
+}
+
+bool replay_is_playing(void) {
+    return playback.data != NULL;
+}
+
+unsigned long long replay_ticks_played(void) {
+    return playback.ticks;
+}
+
+void replay_get_cursor(ReplayCursor* cursor) {
+    cursor->pos = playback.pos;
+    cursor->bits = playback.bits;
+    cursor->aim = playback.aim;
+    cursor->repeats_left = playback.repeats_left;
+    cursor->ticks = playback.ticks;
+}
+
+void replay_set_cursor(const ReplayCursor* cursor) {
+    if (!playback.data || cursor->pos < REPLAY_HEADER_SIZE || cursor->pos > playback.size) return;
+
+    playback.pos = cursor->pos;
+    playback.bits = cursor->bits;
+    playback.aim = cursor->aim;
+    playback.repeats_left = cursor->repeats_left;
+    playback.ticks = cursor->ticks;
+}
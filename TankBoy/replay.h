@@ -0,0 +1,86 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "input_state.h"
+
+// Deterministic input recording and replay.
+// A replay is the RNG seed plus, for every simulation tick, the InputState and
+// aim angle fed to world_step, with the UI commands (new game, next stage)
+// interleaved at the exact tick they happened. Same seed + same ticks ->
+// same positions, score and ranking.
+//
+// File layout (little endian):
+//   header  "TBRP", u16 version, u16 tick rate, u64 seed
+//   stream  0x00-0x3F  tick: bits 0-4 = left, right, jump, change_weapon, fire;
+//                      bit 5 = a 64-bit aim angle follows
+//           0x40 | cmd UI command (ReplayCommand)
+//           0x80 | n   previous tick repeated n + 1 times
+
+#define REPLAY_VERSION 1
+#define REPLAY_LAST_SESSION_FILE "TankBoy/last_session.tbr"
+
+// ===== Data Types =====
+
+typedef enum {
+    REPLAY_CMD_NONE = 0,
+    REPLAY_CMD_NEW_GAME = 1,   // Start button: reseed and load stage 1
+    REPLAY_CMD_NEXT_STAGE = 2, // Next button on the stage clear screen
+    REPLAY_CMD_END = 3         // End of session (also reported at end of file)
+} ReplayCommand;
+
+// Read position inside the playback stream (for seeking to a keyframe)
+typedef struct {
+    size_t pos;
+    uint8_t bits;
+    double aim;
+    int repeats_left;
+    unsigned long long ticks;
+} ReplayCursor;
+
+// One playback stream. The game and the headless runner use the shared one
+// behind replay_play_begin; batch runs open one per game
+typedef struct {
+    uint8_t* data;            // Whole file, read at open
+    size_t size;
+    size_t pos;
+    uint64_t seed;
+    int tick_rate;
+    uint8_t bits;             // Input of the last tick read
+    double aim;
+    int repeats_left;
+    unsigned long long ticks;
+} ReplayPlayer;
+
+// ===== Function Declarations =====
+
+// Recording (every call is a no-op while not recording)
+bool replay_record_begin(const char* path, uint64_t seed, int tick_rate);
+void replay_record_tick(const InputState* input, double aim_angle);
+void replay_record_command(ReplayCommand command);
+void replay_record_end(void);
+bool replay_is_recording(void);
+
+// Playback
+bool replay_play_begin(const char* path);
+uint64_t replay_seed(void);
+int replay_tick_rate(void);
+bool replay_next_command(ReplayCommand* command); // true if a command is due before the next tick
+bool replay_read_tick(InputState* input, double* aim_angle); // false when no tick is due
+void replay_play_end(void);
+bool replay_is_playing(void);
+unsigned long long replay_ticks_played(void);
+
+// Seeking: save the read position and jump back to it later
+void replay_get_cursor(ReplayCursor* cursor);
+void replay_set_cursor(const ReplayCursor* cursor);
+
+// Standalone players (same semantics as the shared playback functions above)
+bool replay_player_open(ReplayPlayer* player, const char* path);
+bool replay_player_next_command(ReplayPlayer* player, ReplayCommand* command);
+bool replay_player_read_tick(ReplayPlayer* player, InputState* input, double* aim_angle);
+void replay_player_close(ReplayPlayer* player);
+
+#endif // REPLAY_H
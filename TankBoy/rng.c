@@ -0,0 +1,71 @@
+#include "rng.h"
+#include <time.h>
+
+// ===== Helpers =====
+
+static uint64_t splitmix64(uint64_t* state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+static uint64_t rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+// ===== Seeding =====
+
+void rng_seed(Rng* rng, uint64_t seed) {
+    uint64_t state = seed;
+    rng->seed = seed;
+    for (int i = 0; i < 4; i++) rng->s[i] = splitmix64(&state);
+}
+
+uint64_t rng_seed_from_time(void) {
+    uint64_t state = (uint64_t)time(NULL) ^ ((uint64_t)clock() << 32);
+    return splitmix64(&state);
+}
+
+Rng rng_substream(const Rng* parent, uint64_t stream_id) {
+    uint64_t mix = stream_id;
+    Rng stream;
+    rng_seed(&stream, parent->seed ^ splitmix64(&mix));
+    return stream;
+}
+
+// ===== Draws =====
+
+uint64_t rng_next(Rng* rng) {
+    uint64_t* s = rng->s;
+    uint64_t result = rotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45);
+
+    return result;
+}
+
+double rng_double(Rng* rng) {
+    // Top 53 bits -> exactly representable double in [0, 1)
+    return (double)(rng_next(rng) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+int rng_int(Rng* rng, int min, int max) {
+    if (max <= min) return min;
+    uint64_t span = (uint64_t)((int64_t)max - (int64_t)min) + 1;
+    return min + (int)(rng_next(rng) % span);
+}
+
+double rng_range(Rng* rng, double min, double max) {
+    return min + (max - min) * rng_double(rng);
+}
+
+bool rng_bool(Rng* rng) {
+    return (rng_next(rng) >> 63) != 0;
+}
@@ -0,0 +1,32 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// ===== Data Types =====
+
+// xoshiro256** generator; seed is kept so substreams can be derived from it
+typedef struct {
+    uint64_t s[4];
+    uint64_t seed;
+} Rng;
+
+// ===== Function Declarations =====
+
+// Seeding (state expanded with splitmix64, any seed value is valid)
+void rng_seed(Rng* rng, uint64_t seed);
+uint64_t rng_seed_from_time(void);
+
+// Independent stream for one entity, derived from the parent seed and an id;
+// the same (seed, id) pair always yields the same sequence
+Rng rng_substream(const Rng* parent, uint64_t stream_id);
+
+// Draws
+uint64_t rng_next(Rng* rng);
+double rng_double(Rng* rng);                       // [0, 1)
+int rng_int(Rng* rng, int min, int max);           // [min, max], inclusive
+double rng_range(Rng* rng, double min, double max); // [min, max)
+bool rng_bool(Rng* rng);
+
+#endif // RNG_H
@@ -0,0 +1,475 @@
+#include "snapshot.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Record sizes in bytes (see the layout in snapshot.h)
+#define SNAPSHOT_HEADER_SIZE 14
+#define SNAPSHOT_WORLD_SIZE 77
+#define SNAPSHOT_TANK_SIZE 106
+#define SNAPSHOT_WAVES_SIZE 29
+#define SNAPSHOT_BULLET_SIZE 64
+#define SNAPSHOT_GROUND_SIZE 138
+#define SNAPSHOT_FLYING_SIZE 176
+#define SNAPSHOT_FIXED_SIZE (SNAPSHOT_HEADER_SIZE + SNAPSHOT_WORLD_SIZE + SNAPSHOT_TANK_SIZE + SNAPSHOT_WAVES_SIZE)
+
+// ===== Helpers =====
+// Sizes are checked once up front, so the put/get helpers do no bounds checks
+
+static void put_u8(uint8_t** p, uint8_t value) {
+    *(*p)++ = value;
+}
+
+static void put_u16(uint8_t** p, uint16_t value) {
+    put_u8(p, (uint8_t)value);
+    put_u8(p, (uint8_t)(value >> 8));
+}
+
+static void put_u32(uint8_t** p, uint32_t value) {
+    for (int i = 0; i < 4; i++) put_u8(p, (uint8_t)(value >> (8 * i)));
+}
+
+static void put_u64(uint8_t** p, uint64_t value) {
+    for (int i = 0; i < 8; i++) put_u8(p, (uint8_t)(value >> (8 * i)));
+}
+
+static void put_i16(uint8_t** p, int value) {
+    put_u16(p, (uint16_t)(int16_t)value);
+}
+
+static void put_f64(uint8_t** p, double value) {
+    uint64_t raw;
+    memcpy(&raw, &value, sizeof(raw));
+    put_u64(p, raw);
+}
+
+static void put_rng(uint8_t** p, const Rng* rng) {
+    for (int i = 0; i < 4; i++) put_u64(p, rng->s[i]);
+    put_u64(p, rng->seed);
+}
+
+static uint8_t get_u8(const uint8_t** p) {
+    return *(*p)++;
+}
+
+static uint16_t get_u16(const uint8_t** p) {
+    uint16_t value = get_u8(p);
+    return (uint16_t)(value | (get_u8(p) << 8));
+}
+
+static uint32_t get_u32(const uint8_t** p) {
+    uint32_t value = 0;
+    for (int i = 0; i < 4; i++) value |= (uint32_t)get_u8(p) << (8 * i);
+    return value;
+}
+
+static uint64_t get_u64(const uint8_t** p) {
+    uint64_t value = 0;
+    for (int i = 0; i < 8; i++) value |= (uint64_t)get_u8(p) << (8 * i);
+    return value;
+}
+
+static int get_i16(const uint8_t** p) {
+    return (int16_t)get_u16(p);
+}
+
+static double get_f64(const uint8_t** p) {
+    uint64_t raw = get_u64(p);
+    double value;
+    memcpy(&value, &raw, sizeof(value));
+    return value;
+}
+
+static void get_rng(const uint8_t** p, Rng* rng) {
+    for (int i = 0; i < 4; i++) rng->s[i] = get_u64(p);
+    rng->seed = get_u64(p);
+}
+
+static size_t payload_size(int bullets, int ground, int flying) {
+    return SNAPSHOT_FIXED_SIZE + (size_t)bullets * SNAPSHOT_BULLET_SIZE
+        + (size_t)ground * SNAPSHOT_GROUND_SIZE + (size_t)flying * SNAPSHOT_FLYING_SIZE;
+}
+
+// ===== Save =====
+
+size_t snapshot_max_size(const World* world) {
+    return payload_size(world->max_bullets, MAX_ENEMIES, MAX_FLY_ENEMIES);
+}
+
+size_t snapshot_save(const World* world, uint8_t* out, size_t capacity) {
+    const Enemy* enemies = world->enemies;
+    const FlyingEnemy* flying = world->flying_enemies;
+
+    int bullet_count = 0, ground_count = 0, flying_count = 0;
+    for (int i = 0; i < world->max_bullets; i++) if (world->bullets[i].alive) bullet_count++;
+    for (int i = 0; i < MAX_ENEMIES; i++) if (enemies[i].alive) ground_count++;
+    for (int i = 0; i < MAX_FLY_ENEMIES; i++) if (flying[i].alive) flying_count++;
+
+    size_t size = payload_size(bullet_count, ground_count, flying_count);
+    if (size > capacity) return 0;
+
+    uint8_t* p = out;
+
+    // Header
+    memcpy(p, "TBSN", 4);
+    p += 4;
+    put_u16(&p, SNAPSHOT_VERSION);
+    put_u16(&p, (uint16_t)world->stage);
+    put_u16(&p, (uint16_t)world->max_bullets);
+    put_u16(&p, (uint16_t)bullet_count);
+    put_u8(&p, (uint8_t)ground_count);
+    put_u8(&p, (uint8_t)flying_count);
+
+    // World
+    put_u64(&p, world->tick);
+    put_f64(&p, world->score);
+    put_f64(&p, world->camera_x);
+    put_f64(&p, world->camera_y);
+    put_u32(&p, (uint32_t)world->round_number);
+    put_u8(&p, (uint8_t)((world->enemies_spawned ? 0x01 : 0) | (world->stage_cleared ? 0x02 : 0)
+        | (world->tank_destroyed ? 0x04 : 0)));
+    put_rng(&p, &world->rng);
+
+    // Tank
+    const Tank* tank = &world->tank;
+    put_f64(&p, tank->x);
+    put_f64(&p, tank->y);
+    put_f64(&p, tank->prev_x);
+    put_f64(&p, tank->prev_y);
+    put_f64(&p, tank->vx);
+    put_f64(&p, tank->vy);
+    put_f64(&p, tank->cannon_angle);
+    put_f64(&p, tank->invincible);
+    put_f64(&p, tank->cannon_power);
+    put_f64(&p, tank->mg_fire_time);
+    put_f64(&p, tank->mg_shot_cooldown);
+    put_f64(&p, tank->mg_reload_time);
+    put_i16(&p, tank->width);
+    put_i16(&p, tank->height);
+    put_i16(&p, tank->hp);
+    put_i16(&p, tank->max_hp);
+    put_u8(&p, (uint8_t)tank->weapon);
+    put_u8(&p, (uint8_t)((tank->on_ground ? 0x01 : 0) | (tank->facing_right ? 0x02 : 0) | (tank->charging ? 0x04 : 0)
+        | (tank->mg_firing ? 0x08 : 0) | (tank->mg_reloading ? 0x10 : 0)));
+
+    // Waves
+    EnemyWavesCursor waves;
+    enemy_waves_get_cursor(&world->waves, &waves);
+    put_f64(&p, waves.stage_clock);
+    put_u32(&p, (uint32_t)waves.timed_head);
+    put_u32(&p, (uint32_t)waves.trigger_head);
+    put_u32(&p, (uint32_t)waves.wake_lo);
+    put_u32(&p, (uint32_t)waves.wake_hi);
+    put_u8(&p, waves.wake_started ? 1 : 0);
+    put_u32(&p, world->next_enemy_id);
+
+    // Live bullets
+    for (int i = 0; i < world->max_bullets; i++) {
+        const Bullet* b = &world->bullets[i];
+        if (!b->alive) continue;
+        put_u16(&p, (uint16_t)i);
+        put_f64(&p, b->x);
+        put_f64(&p, b->y);
+        put_f64(&p, b->prev_x);
+        put_f64(&p, b->prev_y);
+        put_f64(&p, b->vx);
+        put_f64(&p, b->vy);
+        put_f64(&p, b->angle);
+        put_i16(&p, b->width);
+        put_i16(&p, b->height);
+        put_u8(&p, (uint8_t)b->weapon);
+        put_u8(&p, b->from_enemy ? 1 : 0);
+    }
+
+    // Live ground enemies
+    for (int i = 0; i < MAX_ENEMIES; i++) {
+        const Enemy* e = &enemies[i];
+        if (!e->alive) continue;
+        put_u8(&p, (uint8_t)i);
+        put_f64(&p, e->x);
+        put_f64(&p, e->y);
+        put_f64(&p, e->vx);
+        put_f64(&p, e->vy);
+        put_f64(&p, e->prev_x);
+        put_f64(&p, e->prev_y);
+        put_f64(&p, e->last_x);
+        put_f64(&p, e->stuck_time);
+        put_f64(&p, e->speed);
+        put_f64(&p, e->jump_timer);
+        put_i16(&p, e->hp);
+        put_i16(&p, e->max_hp);
+        put_i16(&p, e->width);
+        put_i16(&p, e->height);
+        put_i16(&p, e->difficulty);
+        put_i16(&p, e->sprite_index);
+        put_u8(&p, (uint8_t)((e->on_ground ? 0x01 : 0) | (e->facing_right ? 0x02 : 0)));
+        put_u32(&p, e->id);
+        put_rng(&p, &e->rng);
+    }
+
+    // Live flying enemies
+    for (int i = 0; i < MAX_FLY_ENEMIES; i++) {
+        const FlyingEnemy* fe = &flying[i];
+        if (!fe->alive) continue;
+        put_u8(&p, (uint8_t)i);
+        put_f64(&p, fe->x);
+        put_f64(&p, fe->y);
+        put_f64(&p, fe->vx);
+        put_f64(&p, fe->prev_x);
+        put_f64(&p, fe->prev_y);
+        put_f64(&p, fe->base_y);
+        put_f64(&p, fe->spawn_x);
+        put_f64(&p, fe->y_sin);
+        put_f64(&p, fe->y_cos);
+        put_f64(&p, fe->x_sin);
+        put_f64(&p, fe->x_cos);
+        put_f64(&p, fe->shot_interval);
+        put_f64(&p, fe->shot_timer);
+        put_f64(&p, fe->rest_timer);
+        put_u32(&p, (uint32_t)fe->osc_steps);
+        put_i16(&p, fe->burst_shots_left);
+        put_i16(&p, fe->hp);
+        put_i16(&p, fe->max_hp);
+        put_i16(&p, fe->width);
+        put_i16(&p, fe->height);
+        put_i16(&p, fe->difficulty);
+        put_i16(&p, fe->sprite_index);
+        put_u8(&p, (uint8_t)((fe->in_burst ? 0x01 : 0) | (fe->facing_right ? 0x02 : 0)));
+        put_u32(&p, fe->id);
+        put_rng(&p, &fe->rng);
+    }
+
+    return (size_t)(p - out);
+}
+
+// ===== Load =====
+
+// Every slot index must be inside its pool before anything is touched
+static bool slots_valid(const uint8_t* data, int bullet_count, int ground_count, int flying_count, int pool) {
+    const uint8_t* p = data + SNAPSHOT_FIXED_SIZE;
+    for (int i = 0; i < bullet_count; i++, p += SNAPSHOT_BULLET_SIZE) {
+        if ((p[0] | (p[1] << 8)) >= pool) return false;
+    }
+    for (int i = 0; i < ground_count; i++, p += SNAPSHOT_GROUND_SIZE) {
+        if (p[0] >= MAX_ENEMIES) return false;
+    }
+    for (int i = 0; i < flying_count; i++, p += SNAPSHOT_FLYING_SIZE) {
+        if (p[0] >= MAX_FLY_ENEMIES) return false;
+    }
+    return true;
+}
+
+bool snapshot_load(World* world, const uint8_t* data, size_t size) {
+    if (size < SNAPSHOT_FIXED_SIZE || memcmp(data, "TBSN", 4) != 0) {
+        printf("Warning: Not a snapshot\n");
+        return false;
+    }
+
+    const uint8_t* p = data + 4;
+    int version = get_u16(&p);
+    int stage = get_u16(&p);
+    int pool = get_u16(&p);
+    int bullet_count = get_u16(&p);
+    int ground_count = get_u8(&p);
+    int flying_count = get_u8(&p);
+
+    if (version != SNAPSHOT_VERSION) {
+        printf("Warning: Snapshot version %d, expected %d\n", version, SNAPSHOT_VERSION);
+        return false;
+    }
+    if (pool != world->max_bullets || bullet_count > pool || ground_count > MAX_ENEMIES || flying_count > MAX_FLY_ENEMIES
+        || size != payload_size(bullet_count, ground_count, flying_count)
+        || !slots_valid(data, bullet_count, ground_count, flying_count, pool)) {
+        printf("Warning: Snapshot does not match this world (bullet pool %d, size %u)\n", pool, (unsigned)size);
+        return false;
+    }
+
+    // Stage files (map, spawns, wave table) are only reloaded when the stage changes
+    if (stage != world->stage) world_load_stage(world, stage);
+
+    // World
+    world->tick = get_u64(&p);
+    world->score = get_f64(&p);
+    world->camera_x = get_f64(&p);
+    world->camera_y = get_f64(&p);
+    world->round_number = (int)get_u32(&p);
+    uint8_t flags = get_u8(&p);
+    world->enemies_spawned = (flags & 0x01) != 0;
+    world->stage_cleared = (flags & 0x02) != 0;
+    world->tank_destroyed = (flags & 0x04) != 0;
+    get_rng(&p, &world->rng);
+
+    // Tank
+    Tank* tank = &world->tank;
+    tank->x = get_f64(&p);
+    tank->y = get_f64(&p);
+    tank->prev_x = get_f64(&p);
+    tank->prev_y = get_f64(&p);
+    tank->vx = get_f64(&p);
+    tank->vy = get_f64(&p);
+    tank->cannon_angle = get_f64(&p);
+    tank->invincible = get_f64(&p);
+    tank->cannon_power = get_f64(&p);
+    tank->mg_fire_time = get_f64(&p);
+    tank->mg_shot_cooldown = get_f64(&p);
+    tank->mg_reload_time = get_f64(&p);
+    tank->width = get_i16(&p);
+    tank->height = get_i16(&p);
+    tank->hp = get_i16(&p);
+    tank->max_hp = get_i16(&p);
+    tank->weapon = get_u8(&p);
+    flags = get_u8(&p);
+    tank->on_ground = (flags & 0x01) != 0;
+    tank->facing_right = (flags & 0x02) != 0;
+    tank->charging = (flags & 0x04) != 0;
+    tank->mg_firing = (flags & 0x08) != 0;
+    tank->mg_reloading = (flags & 0x10) != 0;
+
+    // Waves
+    EnemyWavesCursor waves;
+    waves.stage_clock = get_f64(&p);
+    waves.timed_head = get_u32(&p);
+    waves.trigger_head = get_u32(&p);
+    waves.wake_lo = get_u32(&p);
+    waves.wake_hi = get_u32(&p);
+    waves.wake_started = get_u8(&p) != 0;
+    enemy_waves_set_cursor(&world->waves, &waves);
+    unsigned int next_enemy_id = get_u32(&p);
+
+    // Pools: every slot back to its empty state, then the live ones on top.
+    // Bullet slots are fully rewritten when fired, so clearing alive is enough
+    // (bullets_init would re-read config.ini)
+    for (int i = 0; i < world->max_bullets; i++) {
+        world->bullets[i].alive = false;
+        world->bullets[i].from_enemy = false;
+    }
+    enemies_init(world);
+    flying_enemies_init(world);
+    world->next_enemy_id = next_enemy_id;
+
+    for (int i = 0; i < bullet_count; i++) {
+        Bullet* b = &world->bullets[get_u16(&p)];
+        b->alive = true;
+        b->x = get_f64(&p);
+        b->y = get_f64(&p);
+        b->prev_x = get_f64(&p);
+        b->prev_y = get_f64(&p);
+        b->vx = get_f64(&p);
+        b->vy = get_f64(&p);
+        b->angle = get_f64(&p);
+        b->width = get_i16(&p);
+        b->height = get_i16(&p);
+        b->weapon = get_u8(&p);
+        b->from_enemy = get_u8(&p) != 0;
+    }
+
+    Enemy* enemies = world->enemies;
+    for (int i = 0; i < ground_count; i++) {
+        Enemy* e = &enemies[get_u8(&p)];
+        e->alive = true;
+        e->x = get_f64(&p);
+        e->y = get_f64(&p);
+        e->vx = get_f64(&p);
+        e->vy = get_f64(&p);
+        e->prev_x = get_f64(&p);
+        e->prev_y = get_f64(&p);
+        e->last_x = get_f64(&p);
+        e->stuck_time = get_f64(&p);
+        e->speed = get_f64(&p);
+        e->jump_timer = get_f64(&p);
+        e->hp = get_i16(&p);
+        e->max_hp = get_i16(&p);
+        e->width = get_i16(&p);
+        e->height = get_i16(&p);
+        e->difficulty = get_i16(&p);
+        e->sprite_index = get_i16(&p);
+        flags = get_u8(&p);
+        e->on_ground = (flags & 0x01) != 0;
+        e->facing_right = (flags & 0x02) != 0;
+        e->id = get_u32(&p);
+        get_rng(&p, &e->rng);
+    }
+
+    FlyingEnemy* flying = world->flying_enemies;
+    for (int i = 0; i < flying_count; i++) {
+        FlyingEnemy* fe = &flying[get_u8(&p)];
+        fe->alive = true;
+        fe->x = get_f64(&p);
+        fe->y = get_f64(&p);
+        fe->vx = get_f64(&p);
+        fe->prev_x = get_f64(&p);
+        fe->prev_y = get_f64(&p);
+        fe->base_y = get_f64(&p);
+        fe->spawn_x = get_f64(&p);
+        fe->y_sin = get_f64(&p);
+        fe->y_cos = get_f64(&p);
+        fe->x_sin = get_f64(&p);
+        fe->x_cos = get_f64(&p);
+        fe->shot_interval = get_f64(&p);
+        fe->shot_timer = get_f64(&p);
+        fe->rest_timer = get_f64(&p);
+        fe->osc_steps = (int)get_u32(&p);
+        fe->burst_shots_left = get_i16(&p);
+        fe->hp = get_i16(&p);
+        fe->max_hp = get_i16(&p);
+        fe->width = get_i16(&p);
+        fe->height = get_i16(&p);
+        fe->difficulty = get_i16(&p);
+        fe->sprite_index = get_i16(&p);
+        flags = get_u8(&p);
+        fe->in_burst = (flags & 0x01) != 0;
+        fe->facing_right = (flags & 0x02) != 0;
+        fe->id = get_u32(&p);
+        get_rng(&p, &fe->rng);
+    }
+
+    return true;
+}
+
+// ===== Files =====
+
+bool snapshot_write_file(const World* world, const char* path) {
+    size_t capacity = snapshot_max_size(world);
+    uint8_t* data = malloc(capacity);
+    if (!data) return false;
+
+    size_t size = snapshot_save(world, data, capacity);
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        printf("Warning: Could not open snapshot file for writing: %s\n", path);
+        free(data);
+        return false;
+    }
+    bool ok = fwrite(data, 1, size, file) == size;
+    fclose(file);
+    free(data);
+
+    if (ok) printf("Snapshot saved: %s (%u bytes, stage %d, tick %llu)\n", path, (unsigned)size, world->stage, world->tick);
+    return ok;
+}
+
+bool snapshot_read_file(World* world, const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        printf("Warning: Could not open snapshot file: %s\n", path);
+        return false;
+    }
+
+    // Anything bigger than the worst case for this world cannot be a valid snapshot
+    size_t capacity = snapshot_max_size(world);
+    uint8_t* data = malloc(capacity + 1);
+    if (!data) {
+        fclose(file);
+        return false;
+    }
+    size_t size = fread(data, 1, capacity + 1, file);
+    fclose(file);
+
+    bool ok = false;
+    if (size > capacity) printf("Warning: Snapshot file too large for this world: %s\n", path);
+    else ok = snapshot_load(world, data, size);
+    free(data);
+
+    if (ok) printf("Snapshot loaded: %s (stage %d, tick %llu)\n", path, world->stage, world->tick);
+    return ok;
+}
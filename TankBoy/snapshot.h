@@ -0,0 +1,42 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "world.h"
+
+// Compact binary save state of all mutable simulation state: the World
+// scalars, tank, live bullets, live enemies, spawn serial and wave progress.
+// No pointers and no padding; fields are written one by one, little endian,
+// and only live pool slots are stored, so a busy field is a few KB.
+// Map, spawns and the wave table are not stored: they come from the stage files.
+//
+// Layout:
+//   header   "TBSN", u16 version, u16 stage, u16 bullet pool size,
+//            u16 live bullets, u8 live ground enemies, u8 live flying enemies
+//   world    tick, score, camera, round, flags, rng
+//   tank     all fields
+//   waves    stage clock and queue heads, next enemy id
+//   pools    per live slot: slot index, then its fields
+
+#define SNAPSHOT_VERSION 1
+#define SNAPSHOT_QUICKSAVE_FILE "TankBoy/quicksave.tbs"
+
+// ===== Function Declarations =====
+
+// Worst case size for this world (every pool slot live)
+size_t snapshot_max_size(const World* world);
+
+// Serialize into out; returns the bytes written, 0 if capacity is too small
+size_t snapshot_save(const World* world, uint8_t* out, size_t capacity);
+
+// Restore; reloads the stage files only when the snapshot is on another stage.
+// Returns false and leaves the world untouched on a bad or mismatched snapshot
+bool snapshot_load(World* world, const uint8_t* data, size_t size);
+
+// Quick save / load
+bool snapshot_write_file(const World* world, const char* path);
+bool snapshot_read_file(World* world, const char* path);
+
+#endif // SNAPSHOT_H
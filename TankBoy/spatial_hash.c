@@ -0,0 +1,134 @@
+#include "spatial_hash.h"
+#include <math.h>
+
+// ===== Helpers =====
+
+static int cell_coord(double v) {
+    return (int)floor(v / SPATIAL_HASH_CELL_SIZE);
+}
+
+static unsigned int cell_bucket(int cell_x, int cell_y) {
+    unsigned int h = (unsigned int)cell_x * 73856093u ^ (unsigned int)cell_y * 19349663u;
+    return h & (SPATIAL_HASH_BUCKETS - 1);
+}
+
+static void fill_entry(SpatialEntry* out, SpatialEntityType type, int index, double cx, double cy) {
+    out->type = type;
+    out->index = index;
+    out->cx = cx;
+    out->cy = cy;
+    out->cell_x = cell_coord(cx);
+    out->cell_y = cell_coord(cy);
+}
+
+// ===== Build =====
+
+void spatial_hash_build_enemies(SpatialHash* hash, const Enemy* enemies, const FlyingEnemy* f_enemies) {
+    SpatialEntry* unsorted = hash->unsorted;
+    unsigned int* unsorted_bucket = hash->unsorted_bucket;
+    int* bucket_start = hash->bucket_start;
+    int count = 0;
+
+    for (int i = 0; i < MAX_ENEMIES; i++) {
+        const Enemy* e = &enemies[i];
+        if (!e->alive) continue;
+        fill_entry(&unsorted[count], SPATIAL_GROUND_ENEMY, i, e->x + e->width * 0.5, e->y + e->height * 0.5);
+        count++;
+    }
+
+    for (int i = 0; i < MAX_FLY_ENEMIES; i++) {
+        const FlyingEnemy* fe = &f_enemies[i];
+        if (!fe->alive) continue;
+        fill_entry(&unsorted[count], SPATIAL_FLYING_ENEMY, i, fe->x + fe->width * 0.5, fe->y + fe->height * 0.5);
+        count++;
+    }
+
+    // Counting sort by bucket
+    for (int b = 0; b <= SPATIAL_HASH_BUCKETS; b++) bucket_start[b] = 0;
+    for (int i = 0; i < count; i++) {
+        unsorted_bucket[i] = cell_bucket(unsorted[i].cell_x, unsorted[i].cell_y);
+        bucket_start[unsorted_bucket[i] + 1]++;
+    }
+    for (int b = 0; b < SPATIAL_HASH_BUCKETS; b++) bucket_start[b + 1] += bucket_start[b];
+
+    int* cursor = hash->cursor;
+    for (int b = 0; b < SPATIAL_HASH_BUCKETS; b++) cursor[b] = bucket_start[b];
+    for (int i = 0; i < count; i++) {
+        hash->entries[cursor[unsorted_bucket[i]]++] = unsorted[i];
+    }
+
+    hash->entry_count = count;
+}
+
+// ===== Query =====
+
+void spatial_hash_query_radius(const SpatialHash* hash, double x, double y, double radius,
+                               SpatialVisitFn visit, void* user) {
+    if (!visit || hash->entry_count == 0) return;
+
+    double reach = radius + SPATIAL_HASH_SLACK;
+    int min_cx = cell_coord(x - reach), max_cx = cell_coord(x + reach);
+    int min_cy = cell_coord(y - reach), max_cy = cell_coord(y + reach);
+
+    for (int cy = min_cy; cy <= max_cy; cy++) {
+        for (int cx = min_cx; cx <= max_cx; cx++) {
+            unsigned int b = cell_bucket(cx, cy);
+            for (int i = hash->bucket_start[b]; i < hash->bucket_start[b + 1]; i++) {
+                const SpatialEntry* entry = &hash->entries[i];
+                // Different cells can share a bucket; only report each entry for its own cell
+                if (entry->cell_x != cx || entry->cell_y != cy) continue;
+                visit(entry, user);
+            }
+        }
+    }
+}
+
+// ===== Separation =====
+
+typedef struct {
+    SpatialEntityType type;
+    int self_index;
+    double cx, cy;
+    double radius, radius_sq;
+    double push_x, push_y;
+} SeparationQuery;
+
+static void separation_visit(const SpatialEntry* entry, void* user) {
+    SeparationQuery* q = (SeparationQuery*)user;
+    if (entry->type != q->type || entry->index == q->self_index) return;
+
+    double dx = q->cx - entry->cx, dy = q->cy - entry->cy;
+    double dist_sq = dx * dx + dy * dy;
+    if (dist_sq >= q->radius_sq) return;
+
+    if (dist_sq < 1e-6) {
+        // Stacked exactly: split them by slot order so the pair moves apart
+        q->push_x += (q->self_index < entry->index) ? -1.0 : 1.0;
+        return;
+    }
+
+    double dist = sqrt(dist_sq);
+    double weight = 1.0 - dist / q->radius;
+    q->push_x += dx / dist * weight;
+    q->push_y += dy / dist * weight;
+}
+
+void spatial_hash_separation(const SpatialHash* hash, SpatialEntityType type, int self_index, double cx, double cy, double radius,
+                             double* out_x, double* out_y) {
+    SeparationQuery q = { type, self_index, cx, cy, radius, radius * radius, 0.0, 0.0 };
+    if (radius > 0.0) spatial_hash_query_radius(hash, cx, cy, radius, separation_visit, &q);
+
+    // A packed crowd would add one push per neighbour; cap the sum at unit length
+    double len_sq = q.push_x * q.push_x + q.push_y * q.push_y;
+    if (len_sq > 1.0) {
+        double inv_len = 1.0 / sqrt(len_sq);
+        q.push_x *= inv_len;
+        q.push_y *= inv_len;
+    }
+    *out_x = q.push_x;
+    *out_y = q.push_y;
+}
+
+int spatial_hash_count(const SpatialHash* hash) {
+    return hash->entry_count;
+}
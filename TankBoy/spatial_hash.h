@@ -0,0 +1,63 @@
+#ifndef SPATIAL_HASH_H
+#define SPATIAL_HASH_H
+
+#include <stdbool.h>
+#include "enemy.h"
+
+// ===== Constants =====
+#define SPATIAL_HASH_CELL_SIZE 128.0   // World pixels per grid cell
+#define SPATIAL_HASH_BUCKETS 4096      // Must be a power of two
+#define SPATIAL_HASH_SLACK 8.0         // Extra query margin for small moves after the build
+#define SPATIAL_HASH_CAPACITY (MAX_ENEMIES + MAX_FLY_ENEMIES)
+
+// ===== Data Types =====
+
+typedef enum {
+    SPATIAL_GROUND_ENEMY,
+    SPATIAL_FLYING_ENEMY
+} SpatialEntityType;
+
+// One alive enemy, bucketed by the cell of its center
+typedef struct {
+    int cell_x, cell_y;
+    SpatialEntityType type;
+    int index;          // Slot in World.enemies / World.flying_enemies
+    double cx, cy;      // Center at build time
+} SpatialEntry;
+
+// Entries are stored sorted by bucket (counting sort), so each bucket is a
+// contiguous range [bucket_start[b], bucket_start[b + 1])
+typedef struct {
+    SpatialEntry entries[SPATIAL_HASH_CAPACITY];
+    int bucket_start[SPATIAL_HASH_BUCKETS + 1];
+    int entry_count;
+
+    // Build scratch
+    SpatialEntry unsorted[SPATIAL_HASH_CAPACITY];
+    unsigned int unsorted_bucket[SPATIAL_HASH_CAPACITY];
+    int cursor[SPATIAL_HASH_BUCKETS];
+} SpatialHash;
+
+// Called for every entry whose cell overlaps the query area
+typedef void (*SpatialVisitFn)(const SpatialEntry* entry, void* user);
+
+// ===== Function Declarations =====
+
+// Rebuild the index from the enemy pools (once per tick, after movement)
+void spatial_hash_build_enemies(SpatialHash* hash, const Enemy* enemies, const FlyingEnemy* f_enemies);
+
+// Visit candidates within radius of (x, y); callers do the exact distance test
+void spatial_hash_query_radius(const SpatialHash* hash, double x, double y, double radius,
+                               SpatialVisitFn visit, void* user);
+
+// Sum of push-away vectors from same-type neighbours within radius, each
+// weighted (1 - dist / radius), capped at length 1 however many neighbours
+// there are; uses build-time centers so every enemy sees the same snapshot
+// regardless of update order
+void spatial_hash_separation(const SpatialHash* hash, SpatialEntityType type, int self_index, double cx, double cy, double radius,
+                             double* out_x, double* out_y);
+
+// Number of entries in the last build
+int spatial_hash_count(const SpatialHash* hash);
+
+#endif // SPATIAL_HASH_H
@@ -0,0 +1,186 @@
+#include "sprite_atlas.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// Room for the shipped set (tank, 3 ground enemies, 3 helicopters, all mirrored) with spare
+#define SPRITE_ATLAS_WIDTH 1024
+#define SPRITE_ATLAS_HEIGHT 512
+#define SPRITE_ATLAS_PADDING 1 // Transparent gap so scaled draws never bleed into a neighbour
+
+static ALLEGRO_BITMAP* atlas = NULL;
+
+// Shelf packing: sprites fill a row left to right, a new row starts below the tallest
+static int shelf_x = 0;
+static int shelf_y = 0;
+static int shelf_height = 0;
+
+// ===== Atlas =====
+
+static bool atlas_create(void) {
+    atlas = al_create_bitmap(SPRITE_ATLAS_WIDTH, SPRITE_ATLAS_HEIGHT);
+    if (!atlas) {
+        printf("Warning: sprite atlas not created, sprites draw from their sources\n");
+        return false;
+    }
+
+    ALLEGRO_BITMAP* target = al_get_target_bitmap();
+    al_set_target_bitmap(atlas);
+    al_clear_to_color(al_map_rgba(0, 0, 0, 0));
+    al_set_target_bitmap(target);
+
+    shelf_x = shelf_y = shelf_height = 0;
+    return true;
+}
+
+static bool atlas_allocate(int width, int height, int* x, int* y) {
+    if (width > SPRITE_ATLAS_WIDTH) return false;
+    if (shelf_x + width > SPRITE_ATLAS_WIDTH) {
+        shelf_y += shelf_height;
+        shelf_x = 0;
+        shelf_height = 0;
+    }
+    if (shelf_y + height > SPRITE_ATLAS_HEIGHT) return false;
+
+    *x = shelf_x;
+    *y = shelf_y;
+    shelf_x += width;
+    if (height > shelf_height) shelf_height = height;
+    return true;
+}
+
+// ===== Reduction =====
+
+// RGBA bytes of a bitmap region, rows packed (NULL on failure)
+static unsigned char* read_region(ALLEGRO_BITMAP* source, int sx, int sy, int sw, int sh) {
+    unsigned char* pixels = malloc((size_t)sw * sh * 4);
+    if (!pixels) return NULL;
+
+    ALLEGRO_LOCKED_REGION* lock = al_lock_bitmap_region(source, sx, sy, sw, sh,
+        ALLEGRO_PIXEL_FORMAT_ABGR_8888_LE, ALLEGRO_LOCK_READONLY);
+    if (!lock) {
+        free(pixels);
+        return NULL;
+    }
+    for (int row = 0; row < sh; row++) {
+        memcpy(pixels + (size_t)row * sw * 4, (const unsigned char*)lock->data + row * lock->pitch, (size_t)sw * 4);
+    }
+    al_unlock_bitmap(source);
+    return pixels;
+}
+
+// Each output pixel is the coverage-weighted mean of the source pixels under it.
+// Colours are premultiplied (Allegro's default on load), so averaging them is exact.
+static void area_resample(const unsigned char* src, int sw, int sh, unsigned char* dst, int dw, int dh) {
+    double step_x = (double)sw / dw;
+    double step_y = (double)sh / dh;
+
+    for (int oy = 0; oy < dh; oy++) {
+        double y0 = oy * step_y, y1 = y0 + step_y;
+        for (int ox = 0; ox < dw; ox++) {
+            double x0 = ox * step_x, x1 = x0 + step_x;
+            double sum[4] = { 0.0, 0.0, 0.0, 0.0 };
+            double area = 0.0;
+
+            for (int y = (int)y0; y < sh && y < y1; y++) {
+                double wy = fmin(y + 1.0, y1) - fmax((double)y, y0);
+                for (int x = (int)x0; x < sw && x < x1; x++) {
+                    double w = (fmin(x + 1.0, x1) - fmax((double)x, x0)) * wy;
+                    const unsigned char* p = src + ((size_t)y * sw + x) * 4;
+                    for (int c = 0; c < 4; c++) sum[c] += p[c] * w;
+                    area += w;
+                }
+            }
+
+            unsigned char* out = dst + ((size_t)oy * dw + ox) * 4;
+            for (int c = 0; c < 4; c++) out[c] = area > 0.0 ? (unsigned char)(sum[c] / area + 0.5) : 0;
+        }
+    }
+}
+
+// Sprite, padding column, mirrored sprite
+static bool write_pair(int x, int y, const unsigned char* pixels, int width, int height) {
+    int pair_width = width * 2 + SPRITE_ATLAS_PADDING;
+    ALLEGRO_LOCKED_REGION* lock = al_lock_bitmap_region(atlas, x, y, pair_width, height,
+        ALLEGRO_PIXEL_FORMAT_ABGR_8888_LE, ALLEGRO_LOCK_WRITEONLY);
+    if (!lock) return false;
+
+    for (int row = 0; row < height; row++) {
+        unsigned char* line = (unsigned char*)lock->data + row * lock->pitch;
+        const unsigned char* src = pixels + (size_t)row * width * 4;
+        memcpy(line, src, (size_t)width * 4);
+        memset(line + width * 4, 0, SPRITE_ATLAS_PADDING * 4);
+        unsigned char* mirror = line + (width + SPRITE_ATLAS_PADDING) * 4;
+        for (int col = 0; col < width; col++) {
+            memcpy(mirror + col * 4, src + (width - 1 - col) * 4, 4);
+        }
+    }
+    al_unlock_bitmap(atlas);
+    return true;
+}
+
+// ===== Sprites =====
+
+bool sprite_atlas_add(AtlasSprite* sprite, ALLEGRO_BITMAP* source, int sx, int sy, int sw, int sh, int width, int height) {
+    // Until it is in the atlas the sprite draws from the source region
+    sprite->bitmap = source;
+    sprite->x = sx;
+    sprite->y = sy;
+    sprite->width = sw;
+    sprite->height = sh;
+    sprite->in_atlas = false;
+    if (!source || width <= 0 || height <= 0) return false;
+
+    int x, y;
+    if (!atlas && !atlas_create()) return false;
+    if (!atlas_allocate(width * 2 + SPRITE_ATLAS_PADDING * 2, height + SPRITE_ATLAS_PADDING, &x, &y)) {
+        printf("Warning: no atlas room for a %dx%d sprite, drawing it scaled\n", width, height);
+        return false;
+    }
+
+    unsigned char* pixels = read_region(source, sx, sy, sw, sh);
+    unsigned char* reduced = malloc((size_t)width * height * 4);
+    bool ok = pixels && reduced;
+    if (ok) {
+        area_resample(pixels, sw, sh, reduced, width, height);
+        ok = write_pair(x, y, reduced, width, height);
+    }
+    free(pixels);
+    free(reduced);
+    if (!ok) {
+        printf("Warning: sprite reduction failed, drawing it scaled\n");
+        return false;
+    }
+
+    sprite->bitmap = atlas;
+    sprite->x = x;
+    sprite->y = y;
+    sprite->width = width;
+    sprite->height = height;
+    sprite->in_atlas = true;
+    return true;
+}
+
+void sprite_atlas_draw(const AtlasSprite* sprite, double x, double y, double width, double height, bool mirrored) {
+    if (!sprite->bitmap) return;
+
+    if (!sprite->in_atlas) {
+        al_draw_scaled_bitmap(sprite->bitmap, sprite->x, sprite->y, sprite->width, sprite->height,
+            x, y, width, height, mirrored ? ALLEGRO_FLIP_HORIZONTAL : 0);
+        return;
+    }
+
+    int src_x = mirrored ? sprite->x + sprite->width + SPRITE_ATLAS_PADDING : sprite->x;
+    if (width == sprite->width && height == sprite->height) {
+        al_draw_bitmap_region(atlas, src_x, sprite->y, sprite->width, sprite->height, x, y, 0);
+    }
+    else {
+        al_draw_scaled_bitmap(atlas, src_x, sprite->y, sprite->width, sprite->height, x, y, width, height, 0);
+    }
+}
+
+void sprite_atlas_free(void) {
+    if (atlas) al_destroy_bitmap(atlas);
+    atlas = NULL;
+}
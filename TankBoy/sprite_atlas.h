@@ -0,0 +1,35 @@
+#ifndef SPRITE_ATLAS_H
+#define SPRITE_ATLAS_H
+
+#include <stdbool.h>
+#include <allegro5/allegro5.h>
+
+// Sprites made at load time at the exact size they are drawn at, each with a
+// mirrored copy, packed into one shared atlas bitmap. The reduction averages
+// every source pixel an output pixel covers (a full mip-style box filter in one
+// pass), so a 1024 px sheet shrunk to 120 px no longer aliases, and the
+// full-size images can be destroyed once their sprites are in.
+
+// ===== Data Types =====
+
+typedef struct {
+    ALLEGRO_BITMAP* bitmap;   // The atlas, or the source itself if it did not fit
+    int x, y;                 // Normal copy; the mirrored one sits right of it
+    int width, height;        // Size made for (source region size when not in the atlas)
+    bool in_atlas;
+} AtlasSprite;
+
+// ===== Function Declarations =====
+
+// Reduce the (sx, sy, sw, sh) region of source to width x height and add it with
+// its mirror. Returns false if it could not go in the atlas: the sprite then
+// draws straight from source, which the caller must keep alive.
+bool sprite_atlas_add(AtlasSprite* sprite, ALLEGRO_BITMAP* source, int sx, int sy, int sw, int sh, int width, int height);
+
+// Draw at (x, y) with size width x height; an exact-size sprite is a plain blit
+void sprite_atlas_draw(const AtlasSprite* sprite, double x, double y, double width, double height, bool mirrored);
+
+// Destroy the atlas (every AtlasSprite in it becomes invalid)
+void sprite_atlas_free(void);
+
+#endif // SPRITE_ATLAS_H
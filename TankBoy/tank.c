@@ -1,26 +1,32 @@
 #include "tank.h"
+#include "world.h"
 #include "map_generation.h"
 #include "ini_parser.h"
-#include "audio.h"
+#include "game_events.h"
 #include <math.h>
-#include <allegro5/allegro_primitives.h>
-#include <allegro5/allegro_image.h>
+#include <stdio.h>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
 
 
-typedef struct SPRITES_TANK {
-    ALLEGRO_BITMAP* tank_base;
-    ALLEGRO_BITMAP* _sheet;
-     ALLEGRO_BITMAP* fliped_sheet;
-    //ALLEGRO_BITMAP* tank_cannon;
-} SPRITES_TANK;
-SPRITES_TANK tank_sprites;
-   
 // Remove global tank size variables - now stored in Tank struct
 
+void tank_physics_load(TankPhysics* physics) {
+    IniParser* parser = ini_parser_create();
+    ini_parser_load_file(parser, "TankBoy/config.ini");
+    physics->accel = ini_parser_get_double(parser, "Tank", "tank_acceleration", 0.5);
+    physics->max_speed = ini_parser_get_double(parser, "Tank", "tank_max_speed", 5.0);
+    physics->friction = ini_parser_get_double(parser, "Tank", "tank_friction", 0.85);
+    physics->gravity = ini_parser_get_double(parser, "Tank", "tank_gravity", 0.3);
+    physics->jump_power = ini_parser_get_double(parser, "Tank", "tank_jump_power", 8.0);
+    physics->max_step_height = ini_parser_get_int(parser, "Tank", "max_step_height", 10);
+    physics->max_escape_height = ini_parser_get_int(parser, "Tank", "max_escape_height", 10);
+    physics->escape_velocity = ini_parser_get_double(parser, "Tank", "escape_velocity", 2.0);
+    ini_parser_destroy(parser);
+}
+
 // Initialize tank
 void tank_init(Tank* tank, double x, double y) {
     // Load tank size from config at initialization
@@ -33,6 +39,8 @@ void tank_init(Tank* tank, double x, double y) {
     
     tank->x = x;
     tank->y = y;
+    tank->prev_x = x;
+    tank->prev_y = y;
     tank->vx = 0;
     tank->vy = 0;
     tank->on_ground = true;
@@ -56,7 +64,12 @@ void tank_init(Tank* tank, double x, double y) {
 
 
 // Update tank based on input
-void tank_update(Tank* tank, InputState* input, double dt, Bullet* bullets, int max_bullets, const Map* map) {
+void tank_update(World* world, InputState* input, double dt) {
+    Tank* tank = &world->tank;
+    Bullet* bullets = world->bullets;
+    const int max_bullets = world->max_bullets;
+    const Map* map = (const Map*)&world->map;
+
     // Update invincibility timer
     if (tank->invincible > 0.0) {
         tank->invincible -= dt;
@@ -66,24 +79,19 @@ void tank_update(Tank* tank, InputState* input, double dt, Bullet* bullets, int
     if (tank->vx > 0) tank->facing_right = true;
     else if (tank->vx < 0) tank->facing_right = false;
     
-    // Load physics settings from config.ini
-    IniParser* parser = ini_parser_create();
-    ini_parser_load_file(parser, "TankBoy/config.ini");
-    const double accel = ini_parser_get_double(parser, "Tank", "tank_acceleration", 0.5);
-    const double maxspeed = ini_parser_get_double(parser, "Tank", "tank_max_speed", 5.0);
-    const double friction = ini_parser_get_double(parser, "Tank", "tank_friction", 0.85);
-    const double gravity = ini_parser_get_double(parser, "Tank", "tank_gravity", 0.3);
-    const double jump_power = ini_parser_get_double(parser, "Tank", "tank_jump_power", 8.0);
-    tank->width = ini_parser_get_int(parser, "Tank", "tank_width", 32);
-    tank->height = ini_parser_get_int(parser, "Tank", "tank_height", 20);
-    // Tank size updated from config
+    // Physics settings (loaded from config.ini at world_init; tank size at tank_init)
+    const TankPhysics* physics = &world->tank_physics;
+    const double accel = physics->accel;
+    const double maxspeed = physics->max_speed;
+    const double friction = physics->friction;
+    const double gravity = physics->gravity;
+    const double jump_power = physics->jump_power;
     const int tank_width = tank->width;
     const int tank_height = tank->height;
-    const int max_step_height = ini_parser_get_int(parser, "Tank", "max_step_height", 10);
-    const int max_escape_height = ini_parser_get_int(parser, "Tank", "max_escape_height", 10);
-    const double escape_velocity = ini_parser_get_double(parser, "Tank", "escape_velocity", 2.0);
+    const int max_step_height = physics->max_step_height;
+    const int max_escape_height = physics->max_escape_height;
+    const double escape_velocity = physics->escape_velocity;
     const int map_height = map_get_map_height(); // Use function instead of hardcoded value
-    ini_parser_destroy(parser);
 
     // Movement with collision detection
     if (input->left) tank->vx -= accel;
@@ -184,27 +192,22 @@ void tank_update(Tank* tank, InputState* input, double dt, Bullet* bullets, int
             // Fire cannon
             for (int i = 0; i < max_bullets; i++) {
                 if (!bullets[i].alive) {
-                    // Load cannon bullet size from config
-                    IniParser* parser = ini_parser_create();
-                    ini_parser_load_file(parser, "TankBoy/config.ini");
-                    int cannon_width = ini_parser_get_int(parser, "Bullets", "cannon_bullet_width", 20);
-                    int cannon_height = ini_parser_get_int(parser, "Bullets", "cannon_bullet_height", 20);
-                    ini_parser_destroy(parser);
-                    
                     bullets[i].alive = true;
                     bullets[i].x = tank->x + tank->width / 2;
                     bullets[i].y = tank->y + tank->height / 2;
+                    bullets[i].prev_x = bullets[i].x;
+                    bullets[i].prev_y = bullets[i].y;
                     bullets[i].weapon = 1;
                     bullets[i].vx = cos(tank->cannon_angle) * tank->cannon_power * 1.4;
                     bullets[i].vy = sin(tank->cannon_angle) * tank->cannon_power * 1.4;
-                    bullets[i].width = cannon_width;
-                    bullets[i].height = cannon_height;
+                    bullets[i].width = world->cannon_bullet_width;
+                    bullets[i].height = world->cannon_bullet_height;
                                          bullets[i].angle = tank->cannon_angle;
                      bullets[i].from_enemy = false;
                      // Debug output removed
                      
-                     // Play cannon sound effect
-                     play_cannon_sound();
+                     // Cannon sound effect (and anything else listening)
+                     game_event_emit(world, GAME_EVENT_CANNON_FIRED, bullets[i].x, bullets[i].y, 0);
                      break;
                 }
             }
@@ -241,28 +244,23 @@ void tank_update(Tank* tank, InputState* input, double dt, Bullet* bullets, int
                     // Fire bullet
                     for (int i = 0; i < max_bullets; i++) {
                         if (!bullets[i].alive) {
-                            // Load MG bullet size from config
-                            IniParser* parser = ini_parser_create();
-                            ini_parser_load_file(parser, "config.ini");
-                            int mg_width = ini_parser_get_int(parser, "Bullets", "mg_bullet_width", 40);
-                            int mg_height = ini_parser_get_int(parser, "Bullets", "mg_bullet_height", 10);
-                            ini_parser_destroy(parser);
-                            
                             bullets[i].alive = true;
                             bullets[i].x = tank->x + tank->width / 2;
                             bullets[i].y = tank->y + tank->height / 2;
+                            bullets[i].prev_x = bullets[i].x;
+                            bullets[i].prev_y = bullets[i].y;
                             bullets[i].weapon = 0;
                             bullets[i].vx = cos(tank->cannon_angle) * 8.0 * 1.5;
                             bullets[i].vy = sin(tank->cannon_angle) * 8.0 * 1.5;
-                            bullets[i].width = mg_width;
-                            bullets[i].height = mg_height;
+                            bullets[i].width = world->mg_bullet_width;
+                            bullets[i].height = world->mg_bullet_height;
                             bullets[i].angle = tank->cannon_angle;
                             bullets[i].from_enemy = false;
                             // Debug output removed
                             tank->mg_shot_cooldown = 0.1;
                             
-                            // Play machine gun sound effect
-                            play_machine_sound();
+                            // Machine gun sound effect (and anything else listening)
+                            game_event_emit(world, GAME_EVENT_MG_FIRED, bullets[i].x, bullets[i].y, 0);
                             break;
                         }
                     }
@@ -279,176 +277,3 @@ void tank_update(Tank* tank, InputState* input, double dt, Bullet* bullets, int
         }
     }
 }
-
-// Draw tank
-void tank_draw(Tank* tank, double camera_x, double camera_y) {
-    // Tank drawing with dynamic size
-    
-    double sx = tank->x - camera_x;
-    double sy = tank->y - camera_y;
-
-    ALLEGRO_BITMAP* sprite = tank->facing_right ? tank_sprites.fliped_sheet : tank_sprites._sheet;
-    al_draw_scaled_bitmap(sprite, 0, 0, 1024, 793, sx, sy, tank->width, tank->height, 0);
-   // al_draw_scaled_bitmap(tank_sprites.tank_base, 0, 0, 1024, 793, sx, sy, tank->width, tank->height, 0);
-
-    // Cannon
-    double cx = sx + tank->width / 2;
-    double cy = sy + tank->height / 2;
-    double bx = cx + cos(tank->cannon_angle) * 18;
-    double by = cy + sin(tank->cannon_angle) * 18;
-    // al_draw_line(cx, cy, bx, by, al_map_rgb(200, 200, 0), 4);  // Commented out yellow cannon line
-
-    // Cannon charge gauge (centered on tank, smaller size)
-    if (tank->charging && tank->weapon == 1) {
-        double bar_width = 100; // Reduced from 150 to 100
-        double bar_x = cx - bar_width / 2; // Center on tank
-        double bar_y = sy - 25; // Position above tank (tank height based)
-        
-        // Calculate gauge width with proper scaling and clamping
-        double max_power = 15.0; // Maximum cannon power
-        double gauge_ratio = tank->cannon_power / max_power;
-        if (gauge_ratio > 1.0) gauge_ratio = 1.0; // Clamp to 100%
-        double gauge_w = bar_width * gauge_ratio;
-        
-        al_draw_filled_rectangle(bar_x, bar_y, bar_x + gauge_w, bar_y + 8, al_map_rgb(255, 0, 0));
-        al_draw_rectangle(bar_x, bar_y, bar_x + bar_width, bar_y + 8, al_map_rgb(255, 255, 255), 1);
-    }
-
-    // Machine gun reload gauge (centered on tank, smaller size) - only show when using MG
-    if (tank->mg_reloading && tank->weapon == 0) {
-        double total = 2.0;
-        double filled = (total - tank->mg_reload_time) / total;
-        if (filled < 0) filled = 0;
-        if (filled > 1) filled = 1;
-        double bar_width = 100; // Reduced from 150 to 100
-        double bar_x = cx - bar_width / 2; // Center on tank
-        double bar_y = sy - 40; // Position above tank (tank height based)
-        double gw = bar_width * filled;
-        al_draw_rectangle(bar_x, bar_y, bar_x + bar_width, bar_y + 8, al_map_rgb(255, 255, 255), 1);
-        al_draw_filled_rectangle(bar_x + 1, bar_y + 1, bar_x + 1 + gw, bar_y + 7, al_map_rgb(0, 200, 255));
-    }
-}
-
-// ===== Getter Functions =====
-
-// Global tank instance (needed for getter functions)
-static Tank* g_tank = NULL;
-static double g_camera_x = 0.0;
-static double g_camera_y = 0.0;
-
-// Set global tank reference (called from tank_init)
-void set_global_tank_ref(Tank* tank) {
-    g_tank = tank;
-}
-
-// Set camera position (called from main game loop)
-void set_camera_position(double x, double y) {
-    g_camera_x = x;
-    g_camera_y = y;
-}
-
-double get_tank_x(void) {
-    return g_tank ? g_tank->x : 0.0;
-}
-
-double get_tank_y(void) {
-    return g_tank ? g_tank->y : 0.0;
-}
-
-int get_tank_width(void) {
-    return g_tank ? g_tank->width : 32; // Use global reference or default
-}
-
-int get_tank_height(void) {
-    return g_tank ? g_tank->height : 20; // Use global reference or default
-}
-
-int get_tank_hp(void) {
-    return g_tank ? g_tank->hp : 0;
-}
-
-int get_tank_max_hp(void) {
-    return g_tank ? g_tank->max_hp : 0;
-}
-
-double get_tank_invincible(void) {
-    return g_tank ? g_tank->invincible : 0.0;
-}
-
-void set_tank_hp(int hp) {
-    if (g_tank) {
-        g_tank->hp = hp;
-        if (g_tank->hp < 0) g_tank->hp = 0;
-        if (g_tank->hp > g_tank->max_hp) g_tank->hp = g_tank->max_hp;
-    }
-}
-
-void set_tank_invincible(double time) {
-    if (g_tank) {
-        g_tank->invincible = time;
-    }
-}
-
-void set_tank_velocity(double vx, double vy) {
-    if (g_tank) {
-        g_tank->vx = vx;
-        g_tank->vy = vy;
-    }
-}
-
-void set_tank_x(double x) {
-    if (g_tank) {
-        g_tank->x = x;
-    }
-}
-
-double get_camera_x(void) {
-    return g_camera_x;
-}
-
-double get_camera_y(void) {
-    return g_camera_y;
-}
-
-ALLEGRO_BITMAP* tank_sprite_grab(int x, int y, int w, int h)
-{
-    ALLEGRO_BITMAP* sprite = al_create_sub_bitmap(tank_sprites._sheet, x, y, w, h);
-    return sprite;
-}
-
-//tank sprite flip horizontal
-ALLEGRO_BITMAP* flip_horizontal(ALLEGRO_BITMAP* bmp) {
-    int w = al_get_bitmap_width(bmp);
-    int h = al_get_bitmap_height(bmp);
-
-    ALLEGRO_BITMAP* flipped = al_create_bitmap(w, h);
-    if (!flipped) {
-        printf("Failed to create flipped bitmap\n");
-        return NULL;
-    }
-
-    ALLEGRO_BITMAP* old_target = al_get_target_bitmap(); // 현재 백버퍼 저장
-
-    al_set_target_bitmap(flipped);
-    al_clear_to_color(al_map_rgba(0, 0, 0, 0)); // 투명 배경
-
-    // ✅ 정중앙(0, 0)에 반전하여 그리기
-    al_draw_bitmap(bmp, 0, 0, ALLEGRO_FLIP_HORIZONTAL);
-
-    al_set_target_bitmap(old_target); // 원래 백버퍼로 복귀
-
-    return flipped;
-}
-
-
-//sprite tank init
-void tank_sprite_init(const char* sprite_path){
-    tank_sprites._sheet = al_load_bitmap(sprite_path);
-    if (!tank_sprites._sheet){
-    printf("Failed to load tank sprite sheet: %s\n", sprite_path);
-        return;
-    } 
-    tank_sprites.tank_base = tank_sprites._sheet;
-    tank_sprites.fliped_sheet = flip_horizontal(tank_sprites._sheet);
-}
-
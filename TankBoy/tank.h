@@ -1,18 +1,17 @@
 #ifndef TANK_H
 #define TANK_H
 
-#include <allegro5/allegro5.h>
-#include <allegro5/allegro_primitives.h>
 #include <stdbool.h>
-#include "input_system.h"
+#include "input_state.h"
 #include "bullet.h"
 #include "map_generation.h"
 
-
+struct World;  // world.h (owns the tank)
 
 // Tank structure
 typedef struct {
     double x, y;
+    double prev_x, prev_y;   // Position at the start of the last tick (render interpolation)
     double vx, vy;
     double cannon_angle;
     bool on_ground;
@@ -40,34 +39,21 @@ typedef struct {
 
 } Tank;
 
+// Driving settings from config.ini [Tank], read once per world instead of every tick
+typedef struct {
+    double accel;
+    double max_speed;
+    double friction;
+    double gravity;
+    double jump_power;
+    int max_step_height;
+    int max_escape_height;
+    double escape_velocity;
+} TankPhysics;
+
 // Functions
+void tank_physics_load(TankPhysics* physics);
 void tank_init(Tank* tank, double x, double y);
-void tank_update(Tank* tank, InputState* input, double dt, Bullet* bullets, int max_bullets, const Map* map);
-void tank_draw(Tank* tank, double camera_x, double camera_y);
-
-// Getter functions for external access
-double get_tank_x(void);
-double get_tank_y(void);
-int get_tank_width(void);
-int get_tank_height(void);
-int get_tank_hp(void);
-int get_tank_max_hp(void);
-double get_tank_invincible(void);
-void set_tank_hp(int hp);
-void set_tank_invincible(double time);
-void set_tank_velocity(double vx, double vy);
-void set_tank_x(double x);
-
-// Camera getter (needed for HP bar drawing)
-double get_camera_x(void);
-double get_camera_y(void);
-
-// Global reference setters
-void set_global_tank_ref(Tank* tank);
-void set_camera_position(double x, double y);
-
-//
-void tank_sprites_init(const char* sprite_path);
-ALLEGRO_BITMAP* tank_sprite_grab(int x, int y, int w, int h);
+void tank_update(struct World* world, InputState* input, double dt);
 
 #endif // TANK_H
@@ -0,0 +1,69 @@
+#include "tank_render.h"
+#include "sprite_atlas.h"
+#include <math.h>
+#include <stdio.h>
+#include <allegro5/allegro_primitives.h>
+#include <allegro5/allegro_image.h>
+
+
+// Tank body, made at tank size (the sheet faces left; the mirror faces right)
+static AtlasSprite tank_body;
+
+// Draw tank
+void tank_draw(const Tank* tank, double camera_x, double camera_y, double alpha) {
+    // Tank drawing with dynamic size, interpolated between the last two ticks
+    
+    double sx = tank->prev_x + (tank->x - tank->prev_x) * alpha - camera_x;
+    double sy = tank->prev_y + (tank->y - tank->prev_y) * alpha - camera_y;
+
+    sprite_atlas_draw(&tank_body, sx, sy, tank->width, tank->height, tank->facing_right);
+
+    // Cannon
+    double cx = sx + tank->width / 2;
+    double cy = sy + tank->height / 2;
+    double bx = cx + cos(tank->cannon_angle) * 18;
+    double by = cy + sin(tank->cannon_angle) * 18;
+    // al_draw_line(cx, cy, bx, by, al_map_rgb(200, 200, 0), 4);  // Commented out yellow cannon line
+
+    // Cannon charge gauge (centered on tank, smaller size)
+    if (tank->charging && tank->weapon == 1) {
+        double bar_width = 100; // Reduced from 150 to 100
+        double bar_x = cx - bar_width / 2; // Center on tank
+        double bar_y = sy - 25; // Position above tank (tank height based)
+        
+        // Calculate gauge width with proper scaling and clamping
+        double max_power = 15.0; // Maximum cannon power
+        double gauge_ratio = tank->cannon_power / max_power;
+        if (gauge_ratio > 1.0) gauge_ratio = 1.0; // Clamp to 100%
+        double gauge_w = bar_width * gauge_ratio;
+        
+        al_draw_filled_rectangle(bar_x, bar_y, bar_x + gauge_w, bar_y + 8, al_map_rgb(255, 0, 0));
+        al_draw_rectangle(bar_x, bar_y, bar_x + bar_width, bar_y + 8, al_map_rgb(255, 255, 255), 1);
+    }
+
+    // Machine gun reload gauge (centered on tank, smaller size) - only show when using MG
+    if (tank->mg_reloading && tank->weapon == 0) {
+        double total = 2.0;
+        double filled = (total - tank->mg_reload_time) / total;
+        if (filled < 0) filled = 0;
+        if (filled > 1) filled = 1;
+        double bar_width = 100; // Reduced from 150 to 100
+        double bar_x = cx - bar_width / 2; // Center on tank
+        double bar_y = sy - 40; // Position above tank (tank height based)
+        double gw = bar_width * filled;
+        al_draw_rectangle(bar_x, bar_y, bar_x + bar_width, bar_y + 8, al_map_rgb(255, 255, 255), 1);
+        al_draw_filled_rectangle(bar_x + 1, bar_y + 1, bar_x + 1 + gw, bar_y + 7, al_map_rgb(0, 200, 255));
+    }
+}
+
+//sprite tank init: reduce the sheet to the tank's size, then drop it
+void tank_sprite_init(const char* sprite_path, int width, int height){
+    ALLEGRO_BITMAP* sheet = al_load_bitmap(sprite_path);
+    if (!sheet) {
+        printf("Failed to load tank sprite sheet: %s\n", sprite_path);
+        return;
+    }
+    if (sprite_atlas_add(&tank_body, sheet, 0, 0, al_get_bitmap_width(sheet), al_get_bitmap_height(sheet), width, height)) {
+        al_destroy_bitmap(sheet);
+    }
+}
@@ -0,0 +1,13 @@
+#ifndef TANK_RENDER_H
+#define TANK_RENDER_H
+
+#include <allegro5/allegro5.h>
+#include "tank.h"
+
+// Tank rendering (kept apart from tank.c so the simulation builds without Allegro)
+void tank_draw(const Tank* tank, double camera_x, double camera_y, double alpha);
+
+//sprite (made at the tank's on-screen size, see sprite_atlas.h)
+void tank_sprite_init(const char* sprite_path, int width, int height);
+
+#endif // TANK_RENDER_H
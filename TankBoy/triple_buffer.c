@@ -0,0 +1,53 @@
+#include "triple_buffer.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#endif
+
+#define TRIPLE_BUFFER_FRESH 4   // Above the slot indices 0..2
+#define TRIPLE_BUFFER_INDEX 3
+
+// Swaps a slot index in and returns the one that was there (full barrier)
+static long exchange_ready(TripleBuffer* buffer, long value) {
+#ifdef _WIN32
+    return InterlockedExchange(&buffer->ready, value);
+#else
+    return __atomic_exchange_n(&buffer->ready, value, __ATOMIC_ACQ_REL);
+#endif
+}
+
+static long load_ready(TripleBuffer* buffer) {
+#ifdef _WIN32
+    return InterlockedCompareExchange(&buffer->ready, 0, 0);
+#else
+    return __atomic_load_n(&buffer->ready, __ATOMIC_ACQUIRE);
+#endif
+}
+
+void triple_buffer_init(TripleBuffer* buffer, void* slot0, void* slot1, void* slot2) {
+    buffer->slots[0] = slot0;
+    buffer->slots[1] = slot1;
+    buffer->slots[2] = slot2;
+    buffer->write_index = 0;
+    buffer->ready = 1;
+    buffer->read_index = 2;
+}
+
+void* triple_buffer_write_slot(TripleBuffer* buffer) {
+    return buffer->slots[buffer->write_index];
+}
+
+void triple_buffer_publish(TripleBuffer* buffer) {
+    long previous = exchange_ready(buffer, buffer->write_index | TRIPLE_BUFFER_FRESH);
+    buffer->write_index = (int)(previous & TRIPLE_BUFFER_INDEX);
+}
+
+void* triple_buffer_read_slot(TripleBuffer* buffer, bool* fresh) {
+    *fresh = (load_ready(buffer) & TRIPLE_BUFFER_FRESH) != 0;
+    if (*fresh) {
+        long previous = exchange_ready(buffer, buffer->read_index);
+        buffer->read_index = (int)(previous & TRIPLE_BUFFER_INDEX);
+    }
+    return buffer->slots[buffer->read_index];
+}
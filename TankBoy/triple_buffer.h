@@ -0,0 +1,33 @@
+#ifndef TRIPLE_BUFFER_H
+#define TRIPLE_BUFFER_H
+
+#include <stdbool.h>
+
+// Lock-free hand-off of the newest value from one producer thread to one
+// consumer thread. The producer always has a free slot to fill and the
+// consumer always holds the newest complete one, so neither side ever waits
+// for the other; values the consumer did not get to in time are overwritten.
+
+// ===== Data Types =====
+
+typedef struct {
+    void* slots[3];
+    volatile long ready;    // Index of the last published slot, | TRIPLE_BUFFER_FRESH until taken
+    int write_index;        // Producer side only
+    int read_index;         // Consumer side only
+} TripleBuffer;
+
+// ===== Function Declarations =====
+
+// Three caller-owned slots; the one given as slot0 is the producer's first
+void triple_buffer_init(TripleBuffer* buffer, void* slot0, void* slot1, void* slot2);
+
+// Producer: the slot to fill next, then hand it over
+void* triple_buffer_write_slot(TripleBuffer* buffer);
+void triple_buffer_publish(TripleBuffer* buffer);
+
+// Consumer: the newest published slot (the same one again if nothing new came in);
+// *fresh tells which. Stays valid until the next call.
+void* triple_buffer_read_slot(TripleBuffer* buffer, bool* fresh);
+
+#endif // TRIPLE_BUFFER_H
@@ -112,15 +112,17 @@ class Block:
             return "gray"  # Default color
 
 class Enemy:
-    def __init__(self, x, y, enemy_type="basic", difficulty=1):
+    def __init__(self, x, y, enemy_type="basic", difficulty=1, spawn_time="", trigger_x=""):
         self.x = x
         self.y = y
         self.enemy_type = enemy_type  # "basic", "fast", "tank"
         self.difficulty = difficulty  # 1=easy, 2=normal, 3=hard
+        self.spawn_time = spawn_time  # optional: seconds after stage start
+        self.trigger_x = trigger_x    # optional: tank x that releases this enemy
     
     def to_csv_row(self):
         """Convert enemy to CSV row format"""
-        return (self.x, self.y, self.enemy_type, self.difficulty)
+        return (self.x, self.y, self.enemy_type, self.difficulty, self.spawn_time, self.trigger_x)
     
     def get_color(self):
         """Return color according to enemy type and difficulty"""
@@ -683,11 +685,13 @@ class MapEditor:
                     
                     for row in reader:
                         if len(row) >= 4:
-                            x, y, enemy_type, difficulty = row
+                            x, y, enemy_type, difficulty = row[:4]
                             x, y = int(float(x)), int(float(y))
                             difficulty = int(difficulty)
+                            spawn_time = row[4] if len(row) > 4 else ""
+                            trigger_x = row[5] if len(row) > 5 else ""
                             
-                            enemy = Enemy(x, y, enemy_type, difficulty)
+                            enemy = Enemy(x, y, enemy_type, difficulty, spawn_time, trigger_x)
                             self.enemies.append(enemy)
                             
             # Load spawn points
@@ -734,7 +738,7 @@ class MapEditor:
             
             with open(enemy_filepath, 'w', newline='') as f:
                 writer = csv.writer(f)
-                writer.writerow(["x", "y", "enemy_type", "difficulty"])
+                writer.writerow(["x", "y", "enemy_type", "difficulty", "spawn_time", "trigger_x"])
                 
                 # Save all enemies
                 for enemy in self.enemies:
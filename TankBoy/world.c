@@ -0,0 +1,353 @@
+#include "world.h"
+#include "enemy.h"
+#include "enemy_waves.h"
+#include "collision.h"
+#include "spatial_hash.h"
+#include "profiler.h"
+#include "ini_parser.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ===== Lifetime =====
+
+bool world_init(World* world, int max_bullets, int view_width, int view_height, uint64_t seed) {
+    memset(world, 0, sizeof(*world));
+    map_init(&world->map);
+    spawn_points_init(&world->spawn_points);
+    world->stage = 1;
+
+    world->max_bullets = max_bullets;
+    world->bullets = malloc(sizeof(Bullet) * max_bullets);
+    if (!world->bullets) return false;
+    bullets_init(world->bullets, max_bullets);
+
+    // Per-tick settings: read once here, not every tick
+    tank_physics_load(&world->tank_physics);
+    IniParser* parser = ini_parser_create();
+    ini_parser_load_file(parser, "TankBoy/config.ini");
+    world->bullet_gravity = ini_parser_get_double(parser, "Bullets", "bullet_gravity", 0.3);
+    world->cannon_bullet_width = ini_parser_get_int(parser, "Bullets", "cannon_bullet_width", 20);
+    world->cannon_bullet_height = ini_parser_get_int(parser, "Bullets", "cannon_bullet_height", 20);
+    world->mg_bullet_width = ini_parser_get_int(parser, "Bullets", "mg_bullet_width", 40);
+    world->mg_bullet_height = ini_parser_get_int(parser, "Bullets", "mg_bullet_height", 10);
+    ini_parser_destroy(parser);
+
+    world->camera_x = 0;
+    world->camera_y = 0;
+    world->view_width = view_width;
+    world->view_height = view_height;
+
+    rng_seed(&world->rng, seed);
+
+    world->tuning = enemy_default_tuning();
+    enemies_init(world);
+    flying_enemies_init(world);
+    enemy_waves_init(&world->waves);
+
+    world->round_number = 1;
+    world->enemies_spawned = false;
+    world->stage_cleared = false;
+    world->tank_destroyed = false;
+    world->score = 0.0;
+    world->tick = 0;
+    return true;
+}
+
+void world_free(World* world) {
+    map_free(&world->map);
+    spawn_points_free(&world->spawn_points);
+    enemy_waves_free(&world->waves);
+    free(world->bullets);
+    world->bullets = NULL;
+}
+
+// ===== Stage Files =====
+
+// Map, spawn and wave files of a stage as parsed from disk
+typedef struct {
+    bool loaded;
+    Map map;
+    SpawnPoints spawn_points;
+    bool spawns_loaded;
+    EnemyWaves waves;
+} StageFiles;
+
+// Filled by world_preload_stages and read-only afterwards
+static StageFiles preloaded_stages[WORLD_MAX_PRELOADED_STAGES + 1];
+
+// The only file reads of a stage load
+static bool read_stage_files(int stage, Map* map, SpawnPoints* spawn_points, EnemyWaves* waves) {
+    char map_file[256];
+    snprintf(map_file, sizeof(map_file), "TankBoy/resources/stages/stage%d.csv", stage);
+    if (!map_load(map, map_file))
+        map_init(map);
+
+    // Load spawn points for the new stage
+    char spawn_file[256];
+    snprintf(spawn_file, sizeof(spawn_file), "TankBoy/resources/stages/spawns%d.csv", stage);
+
+    // Free previous spawn points
+    spawn_points_free(spawn_points);
+    bool spawns_loaded = spawn_points_load(spawn_points, spawn_file);
+
+    enemy_waves_load(waves, stage);
+    return spawns_loaded;
+}
+
+void world_preload_stages(int last_stage) {
+    if (last_stage > WORLD_MAX_PRELOADED_STAGES) last_stage = WORLD_MAX_PRELOADED_STAGES;
+    for (int stage = 1; stage <= last_stage; stage++) {
+        StageFiles* files = &preloaded_stages[stage];
+        if (files->loaded) continue;
+        map_init(&files->map);
+        spawn_points_init(&files->spawn_points);
+        enemy_waves_init(&files->waves);
+        files->spawns_loaded = read_stage_files(stage, &files->map, &files->spawn_points, &files->waves);
+        files->loaded = true;
+    }
+}
+
+void world_free_preloaded_stages(void) {
+    for (int stage = 1; stage <= WORLD_MAX_PRELOADED_STAGES; stage++) {
+        StageFiles* files = &preloaded_stages[stage];
+        if (!files->loaded) continue;
+        map_free(&files->map);
+        spawn_points_free(&files->spawn_points);
+        enemy_waves_free(&files->waves);
+        files->loaded = false;
+    }
+}
+
+// ===== Stage Loading =====
+
+void world_load_stage(World* world, int stage) {
+    PROFILE_BEGIN(PROF_STAGE_LOAD);
+    world->stage = stage;
+
+    // Copy a preloaded stage, or read it from disk
+    bool spawns_loaded;
+    const StageFiles* files = (stage >= 1 && stage <= WORLD_MAX_PRELOADED_STAGES) ? &preloaded_stages[stage] : NULL;
+    if (files && files->loaded) {
+        map_copy(&world->map, &files->map);
+        spawns_loaded = files->spawns_loaded && spawn_points_copy(&world->spawn_points, &files->spawn_points);
+        enemy_waves_copy(&world->waves, &files->waves);
+    }
+    else {
+        spawns_loaded = read_stage_files(stage, &world->map, &world->spawn_points, &world->waves);
+    }
+
+    double tank_x = 100.0; // Default position
+    double tank_y = 2000.0; // Default position
+
+    if (spawns_loaded) {
+        SpawnPoint* tank_spawn = spawn_points_get_tank_spawn(&world->spawn_points);
+        if (tank_spawn) {
+            tank_x = (double)tank_spawn->x;
+            tank_y = (double)tank_spawn->y;
+            printf("Tank spawn loaded for stage %d: (%.0f, %.0f)\n", stage, tank_x, tank_y);
+        }
+    } else {
+        printf("Using default tank spawn position for stage %d: (%.0f, %.0f)\n", stage, tank_x, tank_y);
+    }
+
+    tank_init(&world->tank, tank_x, tank_y);
+    bullets_init(world->bullets, world->max_bullets);
+
+    // Reset enemies for the new stage (they spawn from the wave table as play goes on)
+    enemies_init(world);
+    flying_enemies_init(world);
+
+    world->camera_x = world->tank.x - world->view_width / 3.0;
+    world->camera_y = world->tank.y - world->view_height / 2.0;
+    world->round_number = 1;
+    world->enemies_spawned = false;
+    world->stage_cleared = false;
+    world->tank_destroyed = false;
+    PROFILE_END(PROF_STAGE_LOAD);
+}
+
+void world_new_game(World* world) {
+    world->score = 0.0;
+    rng_seed(&world->rng, world->rng.seed);
+    world_load_stage(world, 1);
+}
+
+// ===== Simulation Step =====
+
+void world_step(World* world, InputState* input, double dt) {
+    world->tick++;
+
+    // Keep last tick's positions for render interpolation
+    world->tank.prev_x = world->tank.x;
+    world->tank.prev_y = world->tank.y;
+    bullets_store_previous(world->bullets, world->max_bullets);
+    enemies_store_previous(world);
+
+    PROFILE_BEGIN(PROF_TANK_UPDATE);
+    tank_update(world, input, dt);
+    PROFILE_END(PROF_TANK_UPDATE);
+
+    PROFILE_BEGIN(PROF_BULLETS_UPDATE);
+    bullets_update(world, world->bullets, world->max_bullets, (const Map*)&world->map, world->bullet_gravity);
+    PROFILE_END(PROF_BULLETS_UPDATE);
+
+    if (world->tank.hp <= 0) world->tank_destroyed = true;
+
+    // Camera follows the tank
+    world->camera_x = world->tank.x - world->view_width / 3.0;
+    world->camera_y = world->tank.y - world->view_height / 2.0;
+
+    // Wake dormant enemies entering the update ROI and release due waves (but not during stage clear)
+    if (!world->stage_cleared) {
+        double wake_left = world->camera_x - world->view_width;
+        double wake_right = world->camera_x + world->view_width * 2;
+        PROFILE_BEGIN(PROF_ENEMY_WAVES);
+        enemy_waves_update(world, dt, wake_left, wake_right);
+        PROFILE_END(PROF_ENEMY_WAVES);
+    }
+
+    // Index enemy positions for crowd separation during the enemy update
+    spatial_hash_build_enemies(&world->spatial, world->enemies, world->flying_enemies);
+
+    PROFILE_BEGIN(PROF_ENEMIES_UPDATE);
+    enemies_update_roi(world, dt);
+    PROFILE_END(PROF_ENEMIES_UPDATE);
+
+    PROFILE_BEGIN(PROF_FLYING_ENEMIES_UPDATE);
+    flying_enemies_update_roi(world, dt);
+    PROFILE_END(PROF_FLYING_ENEMIES_UPDATE);
+
+    // Re-index after movement for this tick's cannon splash queries
+    spatial_hash_build_enemies(&world->spatial, world->enemies, world->flying_enemies);
+
+    // Collision detection (only while the tank is alive)
+    if (!world->tank_destroyed) {
+        PROFILE_BEGIN(PROF_BULLETS_HIT_ENEMIES);
+        bullets_hit_enemies(world);
+        PROFILE_END(PROF_BULLETS_HIT_ENEMIES);
+
+        PROFILE_BEGIN(PROF_BULLETS_HIT_TANK);
+        bullets_hit_tank(world);
+        PROFILE_END(PROF_BULLETS_HIT_TANK);
+
+        PROFILE_BEGIN(PROF_TANK_TOUCH_GROUND);
+        tank_touch_ground_enemy(world);
+        PROFILE_END(PROF_TANK_TOUCH_GROUND);
+
+        PROFILE_BEGIN(PROF_TANK_TOUCH_FLYING);
+        tank_touch_flying_enemy(world);
+        PROFILE_END(PROF_TANK_TOUCH_FLYING);
+    }
+
+    // A round ends each time the field is emptied while later waves are still queued
+    int total_alive_enemies = get_alive_enemy_count(world) + get_alive_flying_enemy_count(world);
+    if (total_alive_enemies > 0) {
+        world->enemies_spawned = true;
+    }
+    else if (world->enemies_spawned && !world->stage_cleared) {
+        world->round_number++;
+        world->enemies_spawned = false;
+    }
+
+    // Auto stage clear when all enemies are defeated and no wave is left
+    if (!world->stage_cleared && total_alive_enemies == 0 && !enemy_waves_pending(&world->waves)) {
+        int health_bonus = world->tank.hp * 10;  // HP * 10 = 보너스 점수
+        world->score += health_bonus;
+        world->stage_cleared = true;
+    }
+}
+
+// ===== State Hash =====
+
+#define FNV_OFFSET 0xcbf29ce484222325ull
+#define FNV_PRIME 0x100000001b3ull
+
+static uint64_t hash_bytes(uint64_t hash, const void* data, size_t size) {
+    const unsigned char* bytes = (const unsigned char*)data;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+// Field by field, so struct padding never reaches the hash
+static uint64_t hash_double(uint64_t hash, double value) {
+    uint64_t raw;
+    memcpy(&raw, &value, sizeof(raw));
+    return hash_bytes(hash, &raw, sizeof(raw));
+}
+
+static uint64_t hash_int(uint64_t hash, int value) {
+    return hash_bytes(hash, &value, sizeof(value));
+}
+
+uint64_t world_state_hash(const World* world) {
+    uint64_t hash = FNV_OFFSET;
+
+    hash = hash_int(hash, world->stage);
+    hash = hash_int(hash, world->round_number);
+    hash = hash_double(hash, world->score);
+    hash = hash_bytes(hash, world->rng.s, sizeof(world->rng.s));
+
+    const Tank* tank = &world->tank;
+    hash = hash_double(hash, tank->x);
+    hash = hash_double(hash, tank->y);
+    hash = hash_double(hash, tank->vx);
+    hash = hash_double(hash, tank->vy);
+    hash = hash_double(hash, tank->cannon_angle);
+    hash = hash_int(hash, tank->hp);
+    hash = hash_int(hash, tank->weapon);
+
+    for (int i = 0; i < world->max_bullets; i++) {
+        const Bullet* b = &world->bullets[i];
+        if (!b->alive) continue;
+        hash = hash_int(hash, i);
+        hash = hash_double(hash, b->x);
+        hash = hash_double(hash, b->y);
+        hash = hash_double(hash, b->vx);
+        hash = hash_double(hash, b->vy);
+    }
+
+    const Enemy* enemies = world->enemies;
+    for (int i = 0; i < MAX_ENEMIES; i++) {
+        const Enemy* e = &enemies[i];
+        if (!e->alive) continue;
+        hash = hash_int(hash, i);
+        hash = hash_int(hash, (int)e->id);
+        hash = hash_double(hash, e->x);
+        hash = hash_double(hash, e->y);
+        hash = hash_double(hash, e->vx);
+        hash = hash_double(hash, e->vy);
+        hash = hash_int(hash, e->hp);
+    }
+
+    const FlyingEnemy* flying = world->flying_enemies;
+    for (int i = 0; i < MAX_FLY_ENEMIES; i++) {
+        const FlyingEnemy* fe = &flying[i];
+        if (!fe->alive) continue;
+        hash = hash_int(hash, i);
+        hash = hash_int(hash, (int)fe->id);
+        hash = hash_double(hash, fe->x);
+        hash = hash_double(hash, fe->y);
+        hash = hash_int(hash, fe->hp);
+    }
+
+    hash = hash_int(hash, enemy_waves_pending(&world->waves) ? 1 : 0);
+    return hash;
+}
+
+// ===== Score System =====
+
+void add_score_for_enemy_kill(World* world, int difficulty) {
+    int score_points = 0;
+    switch (difficulty) {
+        case 1: score_points = 500; break;
+        case 2: score_points = 1000; break;
+        case 3: score_points = 1500; break;
+        default: score_points = 500; break; // Default to level 1 score
+    }
+
+    world->score += score_points;
+}
@@ -0,0 +1,98 @@
+#ifndef WORLD_H
+#define WORLD_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "input_state.h"
+#include "tank.h"
+#include "bullet.h"
+#include "map_generation.h"
+#include "enemy.h"
+#include "enemy_waves.h"
+#include "spatial_hash.h"
+#include "game_events.h"
+#include "rng.h"
+
+// Simulation state shared by the game and the headless runner.
+// Nothing here touches Allegro: no display, audio or fonts. Sound and HUD
+// reactions go out through game_events.h.
+// A World owns all of its mutable state, so any number of them can run side
+// by side; only read-only tuning (config.ini, enemy archetypes) is shared.
+
+// ===== Data Types =====
+
+typedef struct World {
+    // Map & Stage
+    Map map;                  // Current stage map
+    SpawnPoints spawn_points; // Current stage spawn points
+    int stage;                // Current stage number
+
+    // Player & Bullets
+    Tank tank;                // Player tank
+    TankPhysics tank_physics; // Driving settings (config.ini, read at world_init)
+    Bullet* bullets;          // Bullet pool
+    int max_bullets;          // Bullet pool size
+    double bullet_gravity;    // Cannon shell gravity (config.ini, read at world_init)
+    int cannon_bullet_width;  // Player round sizes (config.ini, read at world_init)
+    int cannon_bullet_height;
+    int mg_bullet_width;
+    int mg_bullet_height;
+
+    // Enemies
+    const EnemyTuning* tuning;                   // Balance values (shared, read-only)
+    Enemy enemies[MAX_ENEMIES];                  // Ground enemy pool
+    FlyingEnemy flying_enemies[MAX_FLY_ENEMIES]; // Flying enemy pool
+    unsigned int next_enemy_id;                  // Spawn serial, also the RNG substream id
+    EnemyWaves waves;                            // Stage wave table and progress
+    SpatialHash spatial;                         // Enemy index, rebuilt every tick
+
+    // Camera (also the enemy update ROI)
+    double camera_x, camera_y;
+    int view_width, view_height;
+
+    // Random numbers (every gameplay draw comes from here or a substream of it)
+    Rng rng;
+
+    // Round & Outcome
+    int round_number;         // Current round number
+    bool enemies_spawned;     // Enemies on the field this round
+    bool stage_cleared;       // Field empty and no wave left
+    bool tank_destroyed;      // Tank HP reached 0
+    double score;             // Current score
+    unsigned long long tick;  // Ticks simulated since world_init
+
+    // Presentation hook (sound, HUD); NULL in headless runs
+    GameEventHandler event_handler;
+    void* event_user;
+} World;
+
+// ===== Function Declarations =====
+
+// Lifetime (enemy archetypes and map config must already be loaded)
+bool world_init(World* world, int max_bullets, int view_width, int view_height, uint64_t seed);
+void world_free(World* world);
+
+// Load map, spawns and wave table for a stage and reset the tank, bullets and enemies
+void world_load_stage(World* world, int stage);
+
+// Parse the files of stages 1..last_stage once; world_load_stage then copies them
+// instead of reading the CSVs. Call before worker threads start and free after
+// they stop: the preloaded stages are shared read-only in between
+#define WORLD_MAX_PRELOADED_STAGES 8
+void world_preload_stages(int last_stage);
+void world_free_preloaded_stages(void);
+
+// Fresh game from stage 1: score reset and RNG reseeded (same seed -> same game)
+void world_new_game(World* world);
+
+// Advance the simulation by one fixed tick
+void world_step(World* world, InputState* input, double dt);
+
+// FNV-1a over the gameplay state (tank, bullets, enemies, waves, rng, score);
+// equal hashes after a replay mean the run played out the same
+uint64_t world_state_hash(const World* world);
+
+// Score System
+void add_score_for_enemy_kill(World* world, int difficulty);  // Add score when enemy is killed
+
+#endif // WORLD_H
@@ -0,0 +1,20 @@
+#!/bin/sh
+# Build the parallel batch simulator for balancing sweeps (Linux, pthreads, no Allegro needed).
+# Usage: ./build_batch.sh && ./tankboy_batch --sweep TankBoy/resources/batch/sweep_example.csv --games 200
+#        ./tankboy_batch --threads 1 ...   (single core, to check the scaling)
+# Built without the profiler: scope timing is per thread, but the sim history is
+# one per process, so every worker's ticks would land in the same window.
+set -e
+cd "$(dirname "$0")"
+
+echo "Building tankboy_batch..."
+
+SRC="TankBoy/batch_main.c TankBoy/world.c TankBoy/tank.c TankBoy/bullet.c \
+    TankBoy/enemy.c TankBoy/enemy_waves.c TankBoy/collision.c TankBoy/spatial_hash.c \
+    TankBoy/map_generation.c TankBoy/rng.c TankBoy/game_events.c TankBoy/ini_parser.c TankBoy/profiler.c TankBoy/replay.c TankBoy/bot.c"
+
+CFLAGS="-O2 -std=gnu11 -Wno-unknown-pragmas -pthread"
+
+${CC:-cc} $CFLAGS -o tankboy_batch $SRC -lm
+
+echo "Build successful! Run from the repository root: ./tankboy_batch"
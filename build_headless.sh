@@ -0,0 +1,27 @@
+#!/bin/sh
+# Build the headless simulation runner (Linux, no Allegro needed).
+# Usage: ./build_headless.sh && ./tankboy_headless --stage 1 --ticks 36000
+#        ./tankboy_headless --replay TankBoy/resources/replays/stage1.tbr --runs 5
+#        ./tankboy_headless --bench-flight 10000 --ticks 3600   (micro-benchmarks, headless_bench.c)
+#        STRESS=1 ./build_headless.sh && ./tankboy_headless --stress 2000 --ticks 600   (enemy pool raised to 2000)
+#        PROFILE=1 ./build_headless.sh   (per-scope timings printed at the end)
+set -e
+cd "$(dirname "$0")"
+
+echo "Building tankboy_headless..."
+
+SRC="TankBoy/headless_main.c TankBoy/world.c TankBoy/tank.c TankBoy/bullet.c \
+    TankBoy/enemy.c TankBoy/enemy_waves.c TankBoy/collision.c TankBoy/spatial_hash.c \
+    TankBoy/map_generation.c TankBoy/rng.c TankBoy/game_events.c TankBoy/ini_parser.c TankBoy/profiler.c TankBoy/replay.c TankBoy/bot.c TankBoy/headless_bench.c"
+
+CFLAGS="-O2 -std=gnu11 -Wno-unknown-pragmas"
+if [ "${PROFILE:-0}" = "1" ]; then
+    CFLAGS="$CFLAGS -DTANKBOY_PROFILE"
+fi
+if [ "${STRESS:-0}" = "1" ]; then
+    CFLAGS="$CFLAGS -DMAX_ENEMIES=2000"
+fi
+
+${CC:-cc} $CFLAGS -o tankboy_headless $SRC -lm
+
+echo "Build successful! Run from the repository root: ./tankboy_headless"
@@ -0,0 +1,75 @@
+#!/bin/sh
+# Replay-driven performance regression suite (Linux, headless).
+# Plays every replay in TankBoy/resources/replays RUNS times, keeps the best
+# ticks/s and checks it and the final state hash against baseline.csv.
+# Fails if a replay got more than TOLERANCE percent slower or its hash changed.
+#
+# Usage: ./run_perf_suite.sh                    (RUNS=10 TOLERANCE=10 by default)
+#        ./run_perf_suite.sh --update-baseline  (after an intended change or on a new machine)
+#        ./run_perf_suite.sh --record-corpus    (regenerate the replays, then update the baseline)
+# Per-scope timings for each replay are left in _perf/<name>.txt
+set -e
+cd "$(dirname "$0")"
+
+REPLAYS=TankBoy/resources/replays
+BASELINE=$REPLAYS/baseline.csv
+RUNS=${RUNS:-10}
+TOLERANCE=${TOLERANCE:-10}
+MODE=${1:-check}
+
+PROFILE=1 ./build_headless.sh > /dev/null
+
+if [ "$MODE" = "--record-corpus" ]; then
+    echo "Recording replay corpus..."
+    for s in 1 2 3; do
+        ./tankboy_headless --stage $s --ticks 7200 --seed $s --record $REPLAYS/stage$s.tbr > /dev/null
+    done
+    ./tankboy_headless --stage 2 --ticks 7200 --seed 7 --bot mg --record $REPLAYS/mg_spam.tbr > /dev/null
+    ./tankboy_headless --stage 3 --ticks 7200 --seed 11 --bot cannon --record $REPLAYS/cannon_splash.tbr > /dev/null
+    ./tankboy_headless --stage 1 --ticks 7200 --seed 5 --bot tour --record $REPLAYS/stage_transitions.tbr > /dev/null
+    MODE=--update-baseline
+fi
+
+mkdir -p _perf
+RESULTS=_perf/results.csv
+echo "name,ticks_per_s,hash" > $RESULTS
+
+for replay in $REPLAYS/*.tbr; do
+    name=$(basename "$replay")
+    ./tankboy_headless --replay "$replay" --runs "$RUNS" > "_perf/$name.txt" || {
+        echo "FAIL $name: replay did not play back cleanly (see _perf/$name.txt)"
+        exit 1
+    }
+    grep '^RESULT' "_perf/$name.txt" | sed 's/^RESULT name=\([^ ]*\) ticks=[^ ]* ticks_per_s=\([^ ]*\) hash=\([^ ]*\)$/\1,\2,\3/' >> $RESULTS
+done
+
+if [ "$MODE" = "--update-baseline" ]; then
+    cp $RESULTS $BASELINE
+    echo "Baseline written: $BASELINE"
+    cat $BASELINE
+    exit 0
+fi
+
+if [ ! -f $BASELINE ]; then
+    echo "No baseline yet: run ./run_perf_suite.sh --update-baseline"
+    exit 1
+fi
+
+# Join on name; one line per replay, non-zero exit on any regression
+awk -F, -v tolerance="$TOLERANCE" '
+    FNR == 1 { next }
+    NR == FNR { base_rate[$1] = $2; base_hash[$1] = $3; next }
+    {
+        if (!($1 in base_rate)) { printf "NEW  %-24s %8d ticks/s (not in baseline)\n", $1, $2; next }
+        change = ($2 - base_rate[$1]) * 100.0 / base_rate[$1]
+        status = "ok  "
+        if ($3 != base_hash[$1]) { status = "FAIL"; failed = 1; note = " hash " $3 " != " base_hash[$1] }
+        else if (change < -tolerance) { status = "FAIL"; failed = 1; note = " slower than -" tolerance "%" }
+        else note = ""
+        printf "%s %-24s %8d ticks/s  baseline %8d  %+6.1f%%%s\n", status, $1, $2, base_rate[$1], change, note
+    }
+    END { exit failed }
+' $BASELINE $RESULTS && echo "Perf suite passed (runs $RUNS, tolerance $TOLERANCE%)" || {
+    echo "Perf suite FAILED (per-scope timings in _perf/)"
+    exit 1
+}